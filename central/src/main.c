@@ -35,6 +35,12 @@
 #include <zephyr/bluetooth/uuid.h>
 #include <zephyr/bluetooth/bluetooth.h>
 
+#if defined(CONFIG_CENTRAL_PRINTK_DEFERRED)
+// Statically package prints into the deferred log buffer instead of
+// formatting them in place, the log thread or the host does the rest
+#define printk(...) LOG_PRINTK(__VA_ARGS__)
+#endif
+
 bool debug = true;
 
 // Peripherals P1 P2 P3 P4
@@ -167,27 +173,13 @@ void gpio1pinCallback(const struct device *dev, struct gpio_callback *cb, uint32
 	start_time = timing_counter_get();
 }
 
-// Conversion of uint64 to str because long causes problems in printing to terminal
-char *convertUint64ToStr(uint64_t num)
-{
-	static char buf[22];
-	char *p = &buf[sizeof(buf) - 1];
-	*p = '\0';
-	do
-	{
-		*--p = '0' + (num % 10);
-		num /= 10;
-	} while (num > 0);
-	return p;
-}
-
 // Saving uart data
 void SendUartData(uint64_t times[], int size)
 {
 	for (size_t i = 0; i < size; i++)
 	{
 		// Json type string
-		printk("{'address': '%s', 'scenario': %d, 'time': %lld}\n", addressArr[addressIdx], scenarioIdx, times[i]);
+		printk("{'address': '%s', 'scenario': %d, 'time': %" PRIu64 "}\n", addressArr[addressIdx], scenarioIdx, times[i]);
 	}
 }
 
@@ -492,7 +484,7 @@ static uint8_t notify_func(struct bt_conn *conn,
 			if (debug == true)
 				printk("Spent time notifyng (no ACK): ");
 			if (debug == true)
-				printk("%s", convertUint64ToStr(notifyTimes[notifyCount]));
+				printk("%" PRIu64, notifyTimes[notifyCount]);
 			if (debug == true)
 				printk("\n");
 
@@ -753,7 +745,7 @@ static void connected(struct bt_conn *conn, uint8_t err)
 		if (debug == true)
 			printk("Spent time connecting: ");
 		if (debug == true)
-			printk("%s", convertUint64ToStr(connectionTimes[connectionCount]));
+			printk("%" PRIu64, connectionTimes[connectionCount]);
 		if (debug == true)
 			printk("\n");
 		if (debug == true)
@@ -159,6 +159,50 @@ void TM_EvtReceivedCb(TL_EvtPacket_t *hcievt)
 	k_fifo_put(&ipm_rx_events_fifo, hcievt);
 }
 
+static void bt_ipm_evt_done(TL_EvtPacket_t *hcievt)
+{
+	k_sem_take(&ipm_busy, K_FOREVER);
+	TL_MM_EvtDone(hcievt);
+	k_sem_give(&ipm_busy);
+}
+
+#if defined(CONFIG_BT_STM32_IPM_EVT_NO_COPY)
+static void evt_no_copy_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_FIXED_DEFINE(evt_no_copy_pool, CONFIG_BT_STM32_IPM_EVT_NO_COPY_COUNT,
+			  0, sizeof(struct bt_buf_data), evt_no_copy_destroy);
+
+/* TL event packet referenced by each buffer of evt_no_copy_pool */
+static TL_EvtPacket_t *evt_no_copy[CONFIG_BT_STM32_IPM_EVT_NO_COPY_COUNT];
+
+static void evt_no_copy_destroy(struct net_buf *buf)
+{
+	TL_EvtPacket_t *hcievt = evt_no_copy[net_buf_id(buf)];
+
+	net_buf_destroy(buf);
+
+	/* Give the packet back to CPU2 once the host is done with it */
+	bt_ipm_evt_done(hcievt);
+}
+
+/* Wrap the event in a buffer without copying it, NULL if none is free */
+static struct net_buf *evt_no_copy_get(TL_EvtPacket_t *hcievt)
+{
+	struct net_buf *buf;
+
+	buf = net_buf_alloc_with_data(&evt_no_copy_pool, &hcievt->evtserial.evt,
+				      hcievt->evtserial.evt.plen + 2, K_NO_WAIT);
+	if (!buf) {
+		return NULL;
+	}
+
+	bt_buf_set_type(buf, BT_BUF_EVT);
+	evt_no_copy[net_buf_id(buf)] = hcievt;
+
+	return buf;
+}
+#endif /* CONFIG_BT_STM32_IPM_EVT_NO_COPY */
+
 static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
@@ -178,8 +222,6 @@ static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 
 		hcievt = k_fifo_get(&ipm_rx_events_fifo, K_FOREVER);
 
-		k_sem_take(&ipm_busy, K_FOREVER);
-
 		switch (hcievt->evtserial.type) {
 		case HCI_EVT:
 			LOG_DBG("EVT: hcievt->evtserial.evt.evtcode: 0x%02x",
@@ -189,9 +231,19 @@ static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 				/* Vendor events are currently unsupported */
 				LOG_ERR("Unknown evtcode type 0x%02x",
 					hcievt->evtserial.evt.evtcode);
-				TL_MM_EvtDone(hcievt);
-				goto end_loop;
+				bt_ipm_evt_done(hcievt);
+				continue;
 			default:
+				tryfix_event(&hcievt->evtserial.evt);
+
+#if defined(CONFIG_BT_STM32_IPM_EVT_NO_COPY)
+				buf = evt_no_copy_get(hcievt);
+				if (buf) {
+					bt_recv(buf);
+					continue;
+				}
+#endif /* CONFIG_BT_STM32_IPM_EVT_NO_COPY */
+
 				mev = (void *)&hcievt->evtserial.evt.payload;
 				if (hcievt->evtserial.evt.evtcode == BT_HCI_EVT_LE_META_EVENT &&
 				    (mev->subevent == BT_HCI_EVT_LE_ADVERTISING_REPORT)) {
@@ -204,19 +256,19 @@ static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 					discardable, timeout);
 				if (!buf) {
 					LOG_DBG("Discard adv report due to insufficient buf");
-					goto end_loop;
+					bt_ipm_evt_done(hcievt);
+					continue;
 				}
 			}
 
-			tryfix_event(&hcievt->evtserial.evt);
-
 			buf_tailroom = net_buf_tailroom(buf);
 			buf_add_len = hcievt->evtserial.evt.plen + 2;
 			if (buf_tailroom < buf_add_len) {
 				LOG_ERR("Not enough space in buffer %zu/%zu", buf_add_len,
 					buf_tailroom);
 				net_buf_unref(buf);
-				goto end_loop;
+				bt_ipm_evt_done(hcievt);
+				continue;
 			}
 
 			net_buf_add_mem(buf, &hcievt->evtserial.evt,
@@ -236,7 +288,8 @@ static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 				LOG_ERR("Not enough space in buffer %zu/%zu", buf_add_len,
 					buf_tailroom);
 				net_buf_unref(buf);
-				goto end_loop;
+				bt_ipm_evt_done(hcievt);
+				continue;
 			}
 
 			net_buf_add_mem(buf, (uint8_t *)&acl->acl_data,
@@ -244,15 +297,13 @@ static void bt_ipm_rx_thread(void *p1, void *p2, void *p3)
 			break;
 		default:
 			LOG_ERR("Unknown BT buf type %d", hcievt->evtserial.type);
-			TL_MM_EvtDone(hcievt);
-			goto end_loop;
+			bt_ipm_evt_done(hcievt);
+			continue;
 		}
 
-		TL_MM_EvtDone(hcievt);
+		bt_ipm_evt_done(hcievt);
 
 		bt_recv(buf);
-end_loop:
-		k_sem_give(&ipm_busy);
 	}
 
 }
@@ -356,12 +407,18 @@ static int bt_ipm_send(struct net_buf *buf)
 {
 	TL_CmdPacket_t *ble_cmd_buff = &BleCmdBuffer;
 
+	/* Wait for CPU2 to release the ACL data buffer without holding the
+	 * transport: commands and received events are not delayed meanwhile.
+	 */
+	if (bt_buf_get_type(buf) == BT_BUF_ACL_OUT) {
+		k_sem_take(&acl_data_ack, K_FOREVER);
+	}
+
 	k_sem_take(&ipm_busy, K_FOREVER);
 
 	switch (bt_buf_get_type(buf)) {
 	case BT_BUF_ACL_OUT:
 		LOG_DBG("ACL: buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
-		k_sem_take(&acl_data_ack, K_FOREVER);
 		net_buf_push_u8(buf, HCI_ACL);
 		memcpy((void *)
 		       &((TL_AclDataPacket_t *)HciAclDataBuffer)->AclDataSerial,
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#define _GNU_SOURCE 1 /* recvmmsg() */
+
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/init.h>
@@ -16,11 +18,14 @@
 #include <stdlib.h>
 #include <poll.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <string.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <limits.h>
+#include <time.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <zephyr/sys/byteorder.h>
@@ -53,6 +58,33 @@ struct sockaddr_hci {
 #define H4_EVT           0x04
 #define H4_ISO           0x05
 
+/* Largest H4 packet read from the controller */
+#define FRAME_SIZE       512
+
+#define RX_BATCH         CONFIG_BT_USERCHAN_RX_BATCH
+
+/* btsnoop files, as written by btmon or with --bt-record */
+#define BTSNOOP_HDR_SIZE       16
+#define BTSNOOP_REC_HDR_SIZE   24
+#define BTSNOOP_VERSION        1
+#define BTSNOOP_TYPE_H4        1002
+#define BTSNOOP_TYPE_MONITOR   2001
+#define BTSNOOP_FLAG_RECV      BIT(0)
+#define BTSNOOP_FLAG_CMD_EVT   BIT(1)
+/* Microseconds from year 0 to 1970, btsnoop timestamps start at year 0 */
+#define BTSNOOP_EPOCH_DELTA_US 0x00dcddb30f2f8000ULL
+
+/* Packet opcodes of BTSNOOP_TYPE_MONITOR records */
+#define MONITOR_EVENT_PKT      3
+#define MONITOR_ACL_RX_PKT     5
+#define MONITOR_SCO_RX_PKT     7
+#define MONITOR_ISO_RX_PKT     19
+
+/* Longest time a packet is waited for in latency measurements. The host
+ * keeps some packets, e.g. ACL fragments of an incomplete L2CAP PDU.
+ */
+#define REPLAY_LATENCY_TIMEOUT_MS 100
+
 static K_KERNEL_STACK_DEFINE(rx_thread_stack,
 			     CONFIG_ARCH_POSIX_RECOMMENDED_STACK_SIZE);
 static struct k_thread rx_thread_data;
@@ -66,6 +98,37 @@ static bool hci_socket;
 static char ip_addr[TCP_ADDR_BUFF_SIZE];
 static unsigned int port;
 static bool arg_found;
+static const char *replay_file;
+static double replay_speed;
+static bool replay_latency;
+static const char *record_file;
+static FILE *record_fp;
+
+/* Opcodes of the commands sent by the host and not yet answered by the
+ * replayed trace.
+ */
+static K_MSGQ_DEFINE(replay_cmd_msgq, sizeof(uint16_t), 8, sizeof(uint16_t));
+
+static struct {
+	/* btsnoop datalink type, zero for H4 packets */
+	uint32_t type;
+	/* Timestamp of the current record, zero if unknown */
+	uint64_t ts;
+	/* Record and uptime timestamps the trace timing is relative to */
+	uint64_t base_ts;
+	int64_t base_us;
+	/* Host time of the first packet */
+	uint64_t start_ns;
+} replay;
+
+/* Host-side latency of the packets passed to the host, per H4 type */
+static struct {
+	uint32_t count;
+	uint32_t held;
+	uint64_t total_ns;
+	uint64_t min_ns;
+	uint64_t max_ns;
+} replay_stats[H4_ISO + 1];
 
 static struct net_buf *get_rx(const uint8_t *buf)
 {
@@ -77,7 +140,12 @@ static struct net_buf *get_rx(const uint8_t *buf)
 		if (buf[1] == BT_HCI_EVT_LE_META_EVENT &&
 		    (buf[3] == BT_HCI_EVT_LE_ADVERTISING_REPORT)) {
 			discardable = true;
-			timeout = K_NO_WAIT;
+			/* A replayed trace can wait for the host to release a
+			 * buffer, dropping reports would skew the replay.
+			 */
+			if (!replay_file) {
+				timeout = K_NO_WAIT;
+			}
 		}
 
 		return bt_buf_get_evt(buf[1], discardable, timeout);
@@ -95,6 +163,30 @@ static struct net_buf *get_rx(const uint8_t *buf)
 	return NULL;
 }
 
+/**
+ * @brief Get the header length of an HCI H4 packet
+ * @param type	H4 packet type
+ * @return Length of the packet type and HCI header in bytes, zero if the
+ *         packet type is invalid.
+ */
+static uint8_t packet_hdr_len(uint8_t type)
+{
+	switch (type) {
+	case H4_CMD:
+		return sizeof(type) + BT_HCI_CMD_HDR_SIZE;
+	case H4_ACL:
+		return sizeof(type) + BT_HCI_ACL_HDR_SIZE;
+	case H4_SCO:
+		return sizeof(type) + BT_HCI_SCO_HDR_SIZE;
+	case H4_EVT:
+		return sizeof(type) + BT_HCI_EVT_HDR_SIZE;
+	case H4_ISO:
+		return sizeof(type) + BT_HCI_ISO_HDR_SIZE;
+	default:
+		return 0;
+	}
+}
+
 /**
  * @brief Decode the length of an HCI H4 packet
  * @details Decodes packet length according to Bluetooth spec v5.4 Vol 4 Part E
@@ -165,6 +257,453 @@ static bool uc_ready(void)
 	return (poll(&pollfd, 1, 0) == 1);
 }
 
+/* Host time in nanoseconds, the simulated time does not advance while the
+ * host processes packets.
+ */
+static uint64_t host_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static int64_t uptime_us(void)
+{
+	return k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+static void record(uint8_t type, const uint8_t *data, size_t len, bool recv)
+{
+	uint8_t hdr[BTSNOOP_REC_HDR_SIZE + sizeof(type)];
+	uint32_t flags = 0;
+
+	if (recv) {
+		flags |= BTSNOOP_FLAG_RECV;
+	}
+
+	if (type == H4_CMD || type == H4_EVT) {
+		flags |= BTSNOOP_FLAG_CMD_EVT;
+	}
+
+	/* Original and included length, flags, drops and timestamp */
+	sys_put_be32(sizeof(type) + len, &hdr[0]);
+	sys_put_be32(sizeof(type) + len, &hdr[4]);
+	sys_put_be32(flags, &hdr[8]);
+	sys_put_be32(0, &hdr[12]);
+	sys_put_be64(BTSNOOP_EPOCH_DELTA_US + uptime_us(), &hdr[16]);
+	hdr[BTSNOOP_REC_HDR_SIZE] = type;
+
+	if (fwrite(hdr, sizeof(hdr), 1, record_fp) != 1 ||
+	    fwrite(data, len, 1, record_fp) != 1) {
+		LOG_ERR("Writing %s failed", record_file);
+		fclose(record_fp);
+		record_fp = NULL;
+	}
+}
+
+/* In replay mode, hold back the response to a command until the host has
+ * sent one, as a controller would. Returns 1 if the packet is a command
+ * response, 0 if it is not, or -EPROTO if it answers another command than
+ * the one sent by the host.
+ */
+static int replay_wait_cmd(const uint8_t *frame)
+{
+	const struct bt_hci_evt_hdr *hdr = (const void *)&frame[1];
+	uint16_t opcode;
+	uint16_t sent;
+
+	if (frame[0] != H4_EVT) {
+		return 0;
+	}
+
+	switch (hdr->evt) {
+	case BT_HCI_EVT_CMD_COMPLETE:
+		if (hdr->len < sizeof(struct bt_hci_evt_cmd_complete)) {
+			return 0;
+		}
+
+		opcode = sys_get_le16(&frame[4]);
+		break;
+	case BT_HCI_EVT_CMD_STATUS:
+		if (hdr->len < sizeof(struct bt_hci_evt_cmd_status)) {
+			return 0;
+		}
+
+		opcode = sys_get_le16(&frame[5]);
+		break;
+	default:
+		return 0;
+	}
+
+	if (opcode == BT_OP_NOP) {
+		return 0;
+	}
+
+	k_msgq_get(&replay_cmd_msgq, &sent, K_FOREVER);
+	if (sent != opcode) {
+		LOG_ERR("Host sent opcode 0x%04x, trace answers 0x%04x", sent, opcode);
+		return -EPROTO;
+	}
+
+	return 1;
+}
+
+/* In replay mode, wait until a packet is due. Returns 0 on success or
+ * -EPROTO if the trace does not match the commands sent by the host.
+ */
+static int replay_wait(const uint8_t *frame)
+{
+	int64_t due_us;
+	int err;
+
+	err = replay_wait_cmd(frame);
+	if (err < 0) {
+		return err;
+	}
+
+	if (err || !replay.base_ts) {
+		/* Command responses are passed as soon as the host sent the
+		 * command, the packets that follow are timed relative to them.
+		 */
+		replay.base_ts = replay.ts;
+		replay.base_us = uptime_us();
+		return 0;
+	}
+
+	if (replay_speed <= 0 || replay.ts <= replay.base_ts) {
+		return 0;
+	}
+
+	due_us = replay.base_us + (int64_t)((replay.ts - replay.base_ts) / replay_speed);
+	if (due_us > uptime_us()) {
+		k_sleep(K_USEC(due_us - uptime_us()));
+	}
+
+	return 0;
+}
+
+/* Wait until the host has processed a packet, i.e. released its buffer */
+static void replay_measure(struct net_buf *buf, uint8_t type, uint64_t start_ns)
+{
+	int64_t timeout = k_uptime_get() + REPLAY_LATENCY_TIMEOUT_MS;
+	uint64_t latency_ns;
+
+	while (buf->ref > 1 && k_uptime_get() < timeout) {
+		k_sleep(K_TICKS(1));
+	}
+
+	latency_ns = host_time_ns() - start_ns;
+
+	if (buf->ref > 1) {
+		replay_stats[type].held++;
+	} else {
+		replay_stats[type].count++;
+		replay_stats[type].total_ns += latency_ns;
+		replay_stats[type].min_ns = MIN(replay_stats[type].min_ns, latency_ns);
+		replay_stats[type].max_ns = MAX(replay_stats[type].max_ns, latency_ns);
+	}
+
+	net_buf_unref(buf);
+}
+
+static void replay_report(void)
+{
+	static const char * const names[] = {
+		[H4_ACL] = "ACL", [H4_SCO] = "SCO", [H4_EVT] = "Event", [H4_ISO] = "ISO",
+	};
+	uint64_t duration_ns = host_time_ns() - replay.start_ns;
+
+	LOG_INF("Replay took %llu us of host time",
+		(unsigned long long)(duration_ns / NSEC_PER_USEC));
+
+	if (!replay_latency) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(replay_stats); i++) {
+		if (!replay_stats[i].count) {
+			continue;
+		}
+
+		LOG_INF("%s: %u packets, latency min %llu avg %llu max %llu ns, %u held",
+			names[i], replay_stats[i].count,
+			(unsigned long long)replay_stats[i].min_ns,
+			(unsigned long long)(replay_stats[i].total_ns / replay_stats[i].count),
+			(unsigned long long)replay_stats[i].max_ns, replay_stats[i].held);
+	}
+}
+
+/**
+ * @brief Pass the first HCI packet of a frame to the host
+ * @param frame	Pointer to the received data
+ * @param len	Length of the received data in bytes
+ * @return Length of the packet in bytes, zero if @p frame does not hold a
+ *         complete packet, -EINVAL if the packet type is invalid, or
+ *         -EPROTO if a replayed command response does not match the
+ *         command sent by the host.
+ */
+static int rx_packet(const uint8_t *frame, size_t len)
+{
+	struct net_buf *buf;
+	uint16_t decoded_len;
+	size_t buf_tailroom;
+	size_t buf_add_len;
+	int err;
+
+	if (len < 1) {
+		return 0;
+	}
+
+	if (packet_hdr_len(frame[0]) == 0) {
+		LOG_ERR("HCI Packet type is invalid, length could not be decoded");
+		return -EINVAL;
+	}
+
+	if (len < packet_hdr_len(frame[0])) {
+		return 0;
+	}
+
+	decoded_len = packet_len(frame);
+	if (decoded_len > len) {
+		return 0;
+	}
+
+	if (frame[0] == H4_CMD) {
+		/* Only found in replayed traces, skip it */
+		return decoded_len;
+	}
+
+	if (replay_file) {
+		err = replay_wait(frame);
+		if (err) {
+			return err;
+		}
+	}
+
+	if (record_fp) {
+		record(frame[0], &frame[1], decoded_len - sizeof(frame[0]), true);
+	}
+
+	buf = get_rx(frame);
+	if (!buf) {
+		LOG_DBG("Discard adv report due to insufficient buf");
+		return decoded_len;
+	}
+
+	buf_tailroom = net_buf_tailroom(buf);
+	buf_add_len = decoded_len - sizeof(frame[0]);
+	if (buf_tailroom < buf_add_len) {
+		LOG_ERR("Not enough space in buffer %zu/%zu",
+			buf_add_len, buf_tailroom);
+		net_buf_unref(buf);
+		return decoded_len;
+	}
+
+	net_buf_add_mem(buf, frame + sizeof(frame[0]), buf_add_len);
+
+	LOG_DBG("Calling bt_recv(%p)", buf);
+
+	if (replay_latency) {
+		uint64_t start_ns = host_time_ns();
+
+		bt_recv(net_buf_ref(buf));
+		replay_measure(buf, frame[0], start_ns);
+	} else {
+		bt_recv(buf);
+	}
+
+	return decoded_len;
+}
+
+/**
+ * @brief Pass the packet of a btsnoop record to the host
+ * @param rec	Pointer to the record
+ * @param len	Length of the data following the record in bytes
+ * @return Length of the record in bytes, zero if @p rec does not hold a
+ *         complete record, or -EPROTO if the replay has to stop.
+ */
+static int rx_btsnoop(uint8_t *rec, size_t len)
+{
+	uint32_t incl_len;
+	uint32_t flags;
+	uint8_t *frame;
+	size_t frame_len;
+	int err;
+
+	if (len < BTSNOOP_REC_HDR_SIZE) {
+		return 0;
+	}
+
+	incl_len = sys_get_be32(&rec[4]);
+	if (len - BTSNOOP_REC_HDR_SIZE < incl_len) {
+		return 0;
+	}
+
+	flags = sys_get_be32(&rec[8]);
+	replay.ts = sys_get_be64(&rec[16]);
+	frame = &rec[BTSNOOP_REC_HDR_SIZE];
+	frame_len = incl_len;
+
+	if (replay.type == BTSNOOP_TYPE_H4) {
+		if (!(flags & BTSNOOP_FLAG_RECV)) {
+			return BTSNOOP_REC_HDR_SIZE + incl_len;
+		}
+	} else {
+		uint8_t type;
+
+		switch (flags & 0xffff) {
+		case MONITOR_EVENT_PKT:
+			type = H4_EVT;
+			break;
+		case MONITOR_ACL_RX_PKT:
+			type = H4_ACL;
+			break;
+		case MONITOR_SCO_RX_PKT:
+			type = H4_SCO;
+			break;
+		case MONITOR_ISO_RX_PKT:
+			type = H4_ISO;
+			break;
+		default:
+			return BTSNOOP_REC_HDR_SIZE + incl_len;
+		}
+
+		/* Monitor packets have no H4 packet type, put it in the last
+		 * byte of the record header.
+		 */
+		frame--;
+		frame[0] = type;
+		frame_len++;
+	}
+
+	err = rx_packet(frame, frame_len);
+	if (err == -EPROTO) {
+		return err;
+	}
+
+	if (err != (int)frame_len) {
+		LOG_ERR("Invalid btsnoop record (%zu bytes)", frame_len);
+	}
+
+	return BTSNOOP_REC_HDR_SIZE + incl_len;
+}
+
+/* Pass all the packets of one datagram to the host */
+static void rx_frame(const uint8_t *frame, size_t len)
+{
+	while (len > 0) {
+		int decoded_len = rx_packet(frame, len);
+
+		if (decoded_len < 0) {
+			break;
+		}
+
+		if (decoded_len == 0) {
+			LOG_ERR("Incomplete HCI packet (%zu bytes)", len);
+			break;
+		}
+
+		frame += decoded_len;
+		len -= decoded_len;
+	}
+}
+
+/* HCI sockets deliver one packet per datagram, receive as many as available
+ * with one system call.
+ */
+static int rx_socket(void)
+{
+	static uint8_t frames[RX_BATCH][FRAME_SIZE];
+	static struct iovec iov[RX_BATCH];
+	static struct mmsghdr msgs[RX_BATCH];
+	int count;
+
+	for (int i = 0; i < RX_BATCH; i++) {
+		iov[i].iov_base = frames[i];
+		iov[i].iov_len = sizeof(frames[i]);
+
+		(void)memset(&msgs[i], 0, sizeof(msgs[i]));
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	count = recvmmsg(uc_fd, msgs, RX_BATCH, MSG_DONTWAIT, NULL);
+	if (count < 0) {
+		return -errno;
+	}
+
+	for (int i = 0; i < count; i++) {
+		if (msgs[i].msg_len == 0) {
+			/* Zero length datagram, the socket was shut down */
+			return -ENODATA;
+		}
+
+		rx_frame(frames[i], msgs[i].msg_len);
+	}
+
+	return 0;
+}
+
+/* TCP connections and replayed traces are byte streams: packets may span
+ * several reads, so the incomplete tail of a read is kept for the next one.
+ */
+static int rx_stream(void)
+{
+	static uint8_t stream[RX_BATCH * FRAME_SIZE];
+	static size_t stream_len;
+	size_t offset = 0;
+	ssize_t len;
+
+	len = read(uc_fd, &stream[stream_len], sizeof(stream) - stream_len);
+	if (len < 0) {
+		return -errno;
+	}
+
+	if (len == 0) {
+		return -ENODATA;
+	}
+
+	stream_len += len;
+
+	while (offset < stream_len) {
+		int decoded_len;
+
+		if (replay.type) {
+			decoded_len = rx_btsnoop(&stream[offset], stream_len - offset);
+		} else {
+			decoded_len = rx_packet(&stream[offset], stream_len - offset);
+		}
+
+		if (decoded_len == -EPROTO) {
+			return decoded_len;
+		}
+
+		if (decoded_len < 0) {
+			/* Framing is lost, drop what was received */
+			offset = stream_len;
+			break;
+		}
+
+		if (decoded_len == 0) {
+			break;
+		}
+
+		offset += decoded_len;
+	}
+
+	if (offset == 0 && stream_len == sizeof(stream)) {
+		LOG_ERR("HCI packet larger than %zu bytes", sizeof(stream));
+		offset = stream_len;
+	}
+
+	stream_len -= offset;
+	memmove(stream, &stream[offset], stream_len);
+
+	return 0;
+}
+
 static void rx_thread(void *p1, void *p2, void *p3)
 {
 	ARG_UNUSED(p1);
@@ -174,71 +713,50 @@ static void rx_thread(void *p1, void *p2, void *p3)
 	LOG_DBG("started");
 
 	while (1) {
-		static uint8_t frame[512];
-		struct net_buf *buf;
-		size_t buf_tailroom;
-		size_t buf_add_len;
-		ssize_t len;
-		const uint8_t *frame_start = frame;
+		int err;
 
 		if (!uc_ready()) {
 			k_sleep(K_MSEC(1));
 			continue;
 		}
 
-		LOG_DBG("calling read()");
+		LOG_DBG("reading");
 
-		len = read(uc_fd, frame, sizeof(frame));
-		if (len < 0) {
-			if (errno == EINTR) {
-				k_yield();
-				continue;
+		if (hci_socket) {
+			err = rx_socket();
+		} else {
+			err = rx_stream();
+		}
+
+		if (err == -EINTR || err == -EAGAIN) {
+			k_yield();
+			continue;
+		}
+
+		if (err == -ENODATA) {
+			LOG_INF("End of HCI stream");
+			if (replay_file) {
+				replay_report();
 			}
 
-			LOG_ERR("Reading socket failed, errno %d", errno);
 			close(uc_fd);
 			uc_fd = -1;
 			return;
 		}
 
-		while (len > 0) {
-
-			const uint8_t packet_type = frame_start[0];
-			const uint16_t decoded_len = packet_len(frame_start);
-
-			if (decoded_len == 0) {
-				LOG_ERR("HCI Packet type is invalid, length could not be decoded");
-				break;
-			}
-
-			if (decoded_len > len) {
-				LOG_ERR("Decoded HCI packet length (%d bytes) is greater "
-					"than buffer length (%d bytes)", decoded_len, len);
-				break;
-			}
-
-			buf = get_rx(frame_start);
-			if (!buf) {
-				LOG_DBG("Discard adv report due to insufficient buf");
-				continue;
-			}
-
-			buf_tailroom = net_buf_tailroom(buf);
-			buf_add_len = decoded_len - sizeof(packet_type);
-			if (buf_tailroom < buf_add_len) {
-				LOG_ERR("Not enough space in buffer %zu/%zu",
-					buf_add_len, buf_tailroom);
-				net_buf_unref(buf);
-				continue;
-			}
-
-			net_buf_add_mem(buf, frame_start + sizeof(packet_type), buf_add_len);
-
-			LOG_DBG("Calling bt_recv(%p)", buf);
+		if (err == -EPROTO) {
+			LOG_ERR("Replay stopped, trace does not match the host");
+			replay_report();
+			close(uc_fd);
+			uc_fd = -1;
+			return;
+		}
 
-			bt_recv(buf);
-			len -= decoded_len;
-			frame_start += decoded_len;
+		if (err < 0) {
+			LOG_ERR("Reading socket failed, errno %d", -err);
+			close(uc_fd);
+			uc_fd = -1;
+			return;
 		}
 
 		k_yield();
@@ -247,6 +765,9 @@ static void rx_thread(void *p1, void *p2, void *p3)
 
 static int uc_send(struct net_buf *buf)
 {
+	uint8_t type;
+	struct iovec iov[2];
+
 	LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
 
 	if (uc_fd < 0) {
@@ -256,14 +777,14 @@ static int uc_send(struct net_buf *buf)
 
 	switch (bt_buf_get_type(buf)) {
 	case BT_BUF_ACL_OUT:
-		net_buf_push_u8(buf, H4_ACL);
+		type = H4_ACL;
 		break;
 	case BT_BUF_CMD:
-		net_buf_push_u8(buf, H4_CMD);
+		type = H4_CMD;
 		break;
 	case BT_BUF_ISO_OUT:
 		if (IS_ENABLED(CONFIG_BT_ISO)) {
-			net_buf_push_u8(buf, H4_ISO);
+			type = H4_ISO;
 			break;
 		}
 		__fallthrough;
@@ -272,7 +793,35 @@ static int uc_send(struct net_buf *buf)
 		return -EINVAL;
 	}
 
-	if (write(uc_fd, buf->data, buf->len) < 0) {
+	if (record_fp) {
+		record(type, buf->data, buf->len, false);
+	}
+
+	if (replay_file) {
+		/* The trace plays the controller, nothing is sent */
+		if (type == H4_CMD && buf->len >= sizeof(uint16_t)) {
+			uint16_t opcode = sys_get_le16(buf->data);
+
+			/* The only command without a response */
+			if (opcode != BT_HCI_OP_HOST_NUM_COMPLETED_PACKETS &&
+			    k_msgq_put(&replay_cmd_msgq, &opcode, K_NO_WAIT)) {
+				LOG_WRN("Too many commands not answered by the trace");
+			}
+		}
+
+		net_buf_unref(buf);
+		return 0;
+	}
+
+	/* Send the packet type and the packet with one system call, without
+	 * touching the headroom of the buffer.
+	 */
+	iov[0].iov_base = &type;
+	iov[0].iov_len = sizeof(type);
+	iov[1].iov_base = buf->data;
+	iov[1].iov_len = buf->len;
+
+	if (writev(uc_fd, iov, ARRAY_SIZE(iov)) < 0) {
 		return -errno;
 	}
 
@@ -280,11 +829,71 @@ static int uc_send(struct net_buf *buf)
 	return 0;
 }
 
+/* Detect the format of a replayed file: btsnoop or H4 packets */
+static int replay_open(int fd)
+{
+	uint8_t hdr[BTSNOOP_HDR_SIZE];
+	ssize_t len;
+
+	len = read(fd, hdr, sizeof(hdr));
+	if (len < 0) {
+		return -errno;
+	}
+
+	if (len < (ssize_t)sizeof(hdr) || memcmp(hdr, "btsnoop", 8)) {
+		replay.type = 0;
+		return lseek(fd, 0, SEEK_SET) < 0 ? -errno : 0;
+	}
+
+	replay.type = sys_get_be32(&hdr[12]);
+	if (sys_get_be32(&hdr[8]) != BTSNOOP_VERSION ||
+	    (replay.type != BTSNOOP_TYPE_H4 && replay.type != BTSNOOP_TYPE_MONITOR)) {
+		LOG_ERR("Unsupported btsnoop file, datalink type %u", replay.type);
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+static int record_open(void)
+{
+	uint8_t hdr[BTSNOOP_HDR_SIZE] = "btsnoop";
+
+	record_fp = fopen(record_file, "wb");
+	if (!record_fp) {
+		return -errno;
+	}
+
+	sys_put_be32(BTSNOOP_VERSION, &hdr[8]);
+	sys_put_be32(BTSNOOP_TYPE_H4, &hdr[12]);
+
+	if (fwrite(hdr, sizeof(hdr), 1, record_fp) != 1) {
+		fclose(record_fp);
+		record_fp = NULL;
+		return -EIO;
+	}
+
+	return 0;
+}
+
 static int user_chan_open(void)
 {
 	int fd;
 
-	if (hci_socket) {
+	if (replay_file) {
+		int err;
+
+		fd = open(replay_file, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			return -errno;
+		}
+
+		err = replay_open(fd);
+		if (err) {
+			close(fd);
+			return err;
+		}
+	} else if (hci_socket) {
 		struct sockaddr_hci addr;
 
 		fd = socket(PF_BLUETOOTH, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
@@ -334,18 +943,34 @@ static int user_chan_open(void)
 
 static int uc_open(void)
 {
-	if (hci_socket) {
+	if (replay_file) {
+		LOG_DBG("replay %s", replay_file);
+	} else if (hci_socket) {
 		LOG_DBG("hci%d", bt_dev_index);
 	} else {
 		LOG_DBG("hci %s:%d", ip_addr, port);
 	}
 
 
+	if (record_file) {
+		int err = record_open();
+
+		if (err) {
+			LOG_ERR("Cannot open %s (err %d)", record_file, err);
+			return err;
+		}
+	}
+
 	uc_fd = user_chan_open();
 	if (uc_fd < 0) {
 		return uc_fd;
 	}
 
+	replay.start_ns = host_time_ns();
+	for (int i = 0; i < ARRAY_SIZE(replay_stats); i++) {
+		replay_stats[i].min_ns = UINT64_MAX;
+	}
+
 	LOG_DBG("User Channel opened as fd %d", uc_fd);
 
 	k_thread_create(&rx_thread_data, rx_thread_stack,
@@ -379,7 +1004,9 @@ SYS_INIT(bt_uc_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
 static void cmd_bt_dev_found(char *argv, int offset)
 {
 	arg_found = true;
-	if (strncmp(&argv[offset], "hci", 3) == 0 && strlen(&argv[offset]) >= 4) {
+	if (strncmp(&argv[offset], "replay:", 7) == 0 && strlen(&argv[offset]) >= 8) {
+		replay_file = &argv[offset + 7];
+	} else if (strncmp(&argv[offset], "hci", 3) == 0 && strlen(&argv[offset]) >= 4) {
 		long arg_hci_idx = strtol(&argv[offset + 3], NULL, 10);
 
 		if (arg_hci_idx >= 0 && arg_hci_idx <= USHRT_MAX) {
@@ -402,7 +1029,8 @@ static void cmd_bt_dev_found(char *argv, int offset)
 		}
 	} else {
 		posix_print_error_and_exit("Invalid option %s for --bt-dev. "
-					   "An hci interface or hci tcp server is expected.\n",
+					   "An hci interface, hci tcp server or replay file "
+					   "is expected.\n",
 					   &argv[offset]);
 	}
 }
@@ -420,8 +1048,22 @@ static void add_btuserchan_arg(void)
 		{ false, true, false,
 		"bt-dev", "hciX", 's',
 		NULL, cmd_bt_dev_found,
-		"A local HCI device to be used for Bluetooth (e.g. hci0) "
-		"or an HCI TCP Server (e.g. 127.0.0.1:9000)"},
+		"A local HCI device to be used for Bluetooth (e.g. hci0), "
+		"an HCI TCP Server (e.g. 127.0.0.1:9000) "
+		"or a file of HCI packets to replay (e.g. replay:trace.h4)"},
+		{ false, false, false,
+		"bt-record", "file", 's',
+		(void *)&record_file, NULL,
+		"Record the HCI packets to a btsnoop file"},
+		{ false, false, false,
+		"bt-replay-speed", "factor", 'd',
+		(void *)&replay_speed, NULL,
+		"Replay the packets at the speed of the recording times factor, "
+		"0 (default) replays them as fast as the host takes them"},
+		{ false, false, true,
+		"bt-replay-latency", "", 'b',
+		(void *)&replay_latency, NULL,
+		"Measure how long the host takes to process each replayed packet"},
 		ARG_TABLE_ENDMARKER
 	};
 
@@ -433,9 +1075,19 @@ static void btuserchan_check_arg(void)
 	if (!arg_found) {
 		posix_print_error_and_exit("Error: Bluetooth device missing.\n"
 					   "Specify either a local hci interface --bt-dev=hciN\n"
-					   "or a valid hci tcp server --bt-dev=ip_address:port\n");
+					   "a valid hci tcp server --bt-dev=ip_address:port\n"
+					   "or a file to replay --bt-dev=replay:path\n");
+	}
+}
+
+static void btuserchan_cleanup(void)
+{
+	if (record_fp) {
+		fclose(record_fp);
+		record_fp = NULL;
 	}
 }
 
 NATIVE_TASK(add_btuserchan_arg, PRE_BOOT_1, 10);
 NATIVE_TASK(btuserchan_check_arg, PRE_BOOT_2, 10);
+NATIVE_TASK(btuserchan_cleanup, ON_EXIT, 10);
@@ -2077,6 +2077,27 @@ struct bt_le_scan_cb {
 	void (*recv)(const struct bt_le_scan_recv_info *info,
 		     struct net_buf_simple *buf);
 
+#if defined(CONFIG_BT_EXT_SCAN_FRAG_CHAIN)
+	/**
+	 * @brief Advertisement packet and scan response received callback,
+	 *        with the advertiser data as a buffer chain.
+	 *
+	 * If set, this callback is used instead of @ref recv whenever the
+	 * advertiser data is available without copying, i.e. as the
+	 * fragments of the HCI reports it was received in. Otherwise
+	 * @ref recv is called.
+	 *
+	 * The buffers, including their data and length, are only valid for
+	 * the duration of the callback and shall not be modified. The host
+	 * releases them once the callback returns, copy the data to keep it.
+	 *
+	 * @param info  Advertiser packet and scan response information.
+	 * @param frags Buffer chain containing advertiser data.
+	 */
+	void (*recv_frags)(const struct bt_le_scan_recv_info *info,
+			   struct net_buf *frags);
+#endif /* CONFIG_BT_EXT_SCAN_FRAG_CHAIN */
+
 	/** @brief The scanner has stopped scanning after scan timeout. */
 	void (*timeout)(void);
 
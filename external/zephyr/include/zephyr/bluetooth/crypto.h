@@ -68,6 +68,50 @@ int bt_encrypt_le(const uint8_t key[16], const uint8_t plaintext[16],
 int bt_encrypt_be(const uint8_t key[16], const uint8_t plaintext[16],
 		  uint8_t enc_data[16]);
 
+/** @brief AES-128 encryption context.
+ *
+ *  Holds a key prepared once with bt_aes_ctx_init() so that any number of
+ *  blocks can be encrypted with it without repeating the key expansion.
+ */
+struct bt_aes_ctx {
+	/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_BT_HOST_CRYPTO)
+	/* Expanded key schedule, 11 round keys */
+	unsigned int sched[44];
+#else
+	uint8_t key[16];
+#endif
+	/** @endcond */
+};
+
+/** @brief Prepare an AES encryption context for a big-endian key.
+ *
+ *  @param ctx AES encryption context
+ *  @param key 128 bit MS byte first key
+ *
+ *  @return Zero on success or error code otherwise.
+ */
+int bt_aes_ctx_init(struct bt_aes_ctx *ctx, const uint8_t key[16]);
+
+/** @brief AES encrypt big-endian data with a prepared context.
+ *
+ *  Same as bt_encrypt_be() with the key of @p ctx.
+ *
+ *  @param ctx AES encryption context prepared with bt_aes_ctx_init()
+ *  @param plaintext 128 bit MS byte first plaintext data block to be encrypted
+ *  @param enc_data 128 bit MS byte first encrypted data block
+ *
+ *  @return Zero on success or error code otherwise.
+ */
+int bt_aes_ctx_encrypt_be(const struct bt_aes_ctx *ctx, const uint8_t plaintext[16],
+			  uint8_t enc_data[16]);
+
+/** @brief Erase the key material held by an AES encryption context.
+ *
+ *  @param ctx AES encryption context
+ */
+void bt_aes_ctx_clear(struct bt_aes_ctx *ctx);
+
 
 /** @brief Decrypt big-endian data with AES-CCM.
  *
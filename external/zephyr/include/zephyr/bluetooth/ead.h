@@ -104,6 +104,99 @@ int bt_ead_decrypt(const uint8_t session_key[BT_EAD_KEY_SIZE], const uint8_t iv[
 		   const uint8_t *encrypted_payload, size_t encrypted_payload_size,
 		   uint8_t *payload);
 
+/** @brief Encrypted Advertising Data scanner callback structure. */
+struct bt_ead_scan_cb {
+	/**
+	 * @brief Decrypted advertising data received.
+	 *
+	 * Called from the EAD scanner thread once for every encrypted
+	 * advertising structure that was authenticated. Copies of the same
+	 * encrypted payload, e.g. received on several advertising channels,
+	 * are reported only once.
+	 *
+	 * @param addr Advertiser address.
+	 * @param rssi Strength of the advertiser signal.
+	 * @param ad   Decrypted advertising data. Can be parsed with
+	 *             bt_data_parse().
+	 */
+	void (*recv)(const bt_addr_le_t *addr, int8_t rssi, struct net_buf_simple *ad);
+
+	/** @cond INTERNAL_HIDDEN */
+	sys_snode_t node;
+	/** @endcond */
+};
+
+/**
+ * @brief Register callbacks for the Encrypted Advertising Data scanner.
+ *
+ * The scanner processes the advertising reports of every scan started with
+ * bt_le_scan_start() and decrypts the Encrypted Advertising Data of the
+ * advertisers added with bt_ead_scan_key_add().
+ *
+ * @note Requires @kconfig{CONFIG_BT_EAD_SCAN}.
+ *
+ * @param cb Callback structure.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL @p cb is NULL.
+ * @retval -EEXIST @p cb is already registered.
+ */
+int bt_ead_scan_cb_register(struct bt_ead_scan_cb *cb);
+
+/**
+ * @brief Add the key material of an advertiser to the scanner.
+ *
+ * An existing entry for @p addr is replaced.
+ *
+ * @note Requires @kconfig{CONFIG_BT_EAD_SCAN}.
+ *
+ * @param addr        Advertiser address, as reported by the scanner. This is
+ *                    the identity address of bonded devices.
+ * @param session_key Key of @ref BT_EAD_KEY_SIZE bytes.
+ * @param iv          Initialisation Vector of @ref BT_EAD_IV_SIZE bytes.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL One of the argument is a NULL pointer.
+ * @retval -ENOMEM No free entry, see @kconfig{CONFIG_BT_EAD_SCAN_MAX_KEYS}.
+ */
+int bt_ead_scan_key_add(const bt_addr_le_t *addr, const uint8_t session_key[BT_EAD_KEY_SIZE],
+			const uint8_t iv[BT_EAD_IV_SIZE]);
+
+/**
+ * @brief Remove the key material of an advertiser from the scanner.
+ *
+ * @note Requires @kconfig{CONFIG_BT_EAD_SCAN}.
+ *
+ * @param addr Advertiser address.
+ *
+ * @retval 0 Success.
+ * @retval -EINVAL @p addr is NULL.
+ * @retval -ENOENT No key material for @p addr.
+ */
+int bt_ead_scan_key_remove(const bt_addr_le_t *addr);
+
+/**
+ * @brief Queue the Encrypted Advertising Data of an advertising report.
+ *
+ * Reports received through bt_le_scan_start() are processed automatically.
+ * This is for advertising data received by other means, e.g. periodic
+ * advertising reports.
+ *
+ * Only the encrypted structures of advertisers with key material, and not
+ * already seen with the same Randomizer and MIC, are copied and queued for
+ * the scanner thread. @p ad is left unchanged.
+ *
+ * @note Requires @kconfig{CONFIG_BT_EAD_SCAN}.
+ *
+ * @param addr Advertiser address.
+ * @param rssi Strength of the advertiser signal.
+ * @param ad   Advertising data.
+ *
+ * @return Number of encrypted advertising structures queued for decryption,
+ *         or -EINVAL if one of the argument is a NULL pointer.
+ */
+int bt_ead_scan_process(const bt_addr_le_t *addr, int8_t rssi, struct net_buf_simple *ad);
+
 /**
  * @}
  */
@@ -97,6 +97,26 @@ static inline uint8_t bt_hci_evt_get_flags(uint8_t evt)
  */
 int bt_recv(struct net_buf *buf);
 
+/**
+ * @brief Receive a burst of data from the controller/HCI driver.
+ *
+ * This is the same as calling bt_recv() for each of the buffers in order,
+ * except that the host schedules its processing of the low priority packets
+ * once for the whole burst instead of once per buffer, see
+ * @kconfig{CONFIG_BT_RECV_BURST_MAX}.
+ *
+ * Ownership of all the buffers is passed to the host, also on failure.
+ *
+ * @note This function must only be called from a cooperative thread.
+ *
+ * @param bufs Array of network buffers containing data from the controller.
+ * @param count Number of buffers in @p bufs.
+ *
+ * @return 0 on success or the first negative error number returned for any
+ *         of the buffers.
+ */
+int bt_recv_burst(struct net_buf **bufs, size_t count);
+
 /**
  * @brief Receive high priority data from the controller/HCI driver.
  *
@@ -60,6 +60,20 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_ID_INDEX
+	/** Address of the most recent ATE of each indexed ID */
+	uint32_t id_index_addr[CONFIG_NVS_ID_INDEX_SIZE];
+	/** Indexed IDs */
+	uint16_t id_index_id[CONFIG_NVS_ID_INDEX_SIZE];
+	/** Number of indexed IDs */
+	uint16_t id_index_cnt;
+	/** Flag indicating that some IDs did not fit in the index */
+	bool id_index_overflow;
+#endif
+#if CONFIG_NVS_GC_STEP
+	/** Address of the next ATE to check by nvs_gc_step() */
+	uint32_t gc_step_addr;
+#endif
 };
 
 /**
@@ -162,6 +176,28 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief Perform part of the next garbage collection ahead of time.
+ *
+ * Copies the entries of the sector that will be garbage collected next, and
+ * that are still the most recent entry of their ID, to the current write
+ * sector. The garbage collection done by nvs_write() when the write sector is
+ * full then only has to erase that sector. Each call copies entries until
+ * @p budget expires, and continues where the previous call stopped.
+ *
+ * Requires @kconfig{CONFIG_NVS_GC_STEP}.
+ *
+ * @param fs Pointer to file system
+ * @param budget Time after which no further entry is copied
+ *
+ * @retval 0 No entry left to copy before the next garbage collection.
+ * @retval -EAGAIN @p budget expired before all entries were copied.
+ * @retval -ENOSPC The write sector is full, the next nvs_write() will garbage collect.
+ * @retval -ENOTSUP The file system has only two sectors.
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs, k_timeout_t budget);
+
 /**
  * @}
  */
@@ -2880,6 +2880,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -3466,6 +3467,42 @@ void k_work_queue_start(struct k_work_q *queue,
  */
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue);
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief Add a worker thread to a started work queue.
+ *
+ * The new thread takes items from the same pending list as the thread
+ * started by k_work_queue_start(), so independent items submitted to the
+ * queue may be processed concurrently.  A work item is never run by more
+ * than one worker at a time, and flush, cancel and drain keep their
+ * documented semantics.
+ *
+ * Work items that depend on being processed in submission order must not be
+ * submitted to a queue that has additional workers.
+ *
+ * @note Requires @kconfig{CONFIG_WORKQUEUE_WORKERS}.
+ *
+ * @param queue pointer to a queue that has been started with
+ *        k_work_queue_start().
+ *
+ * @param worker pointer to the worker structure.  It must remain valid for
+ *        the lifetime of the queue.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cpu the CPU the worker is pinned to, or a negative value to let it
+ *        run on any CPU.  Ignored unless @kconfig{CONFIG_SCHED_CPU_MASK} is
+ *        enabled.
+ */
+void k_work_queue_worker_add(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack, size_t stack_size,
+			     int prio, int cpu);
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /** @brief Wait until the work queue has drained, optionally plugging it.
  *
  * This blocks submission to the work queue except when coming from queue
@@ -3938,6 +3975,10 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* The work item being flushed. */
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -4024,8 +4065,30 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* Additional threads added with k_work_queue_worker_add(). */
+	sys_slist_t workers;
+
+	/* Number of threads currently running a work item. */
+	uint16_t busy;
+#endif
 };
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief An additional thread serving a work queue.
+ *
+ * See k_work_queue_worker_add().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node in the owning queue's list of workers. */
+	sys_snode_t node;
+};
+#endif
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -5058,8 +5121,27 @@ struct k_mem_slab_info {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	/* Filled in only in the statistics snapshot */
+	uint32_t num_cached;
+	uint32_t magazine_hits;
+	uint32_t magazine_misses;
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Per-CPU cache of free blocks taken from the slab free list in batches.
+ * Blocks held here are counted as used in the slab info.
+ */
+struct k_mem_slab_magazine {
+	struct k_spinlock lock;
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+	void *blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -5072,8 +5154,27 @@ struct k_mem_slab {
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 	struct k_obj_core  obj_core;
 #endif
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	struct k_mem_slab_magazine magazine[CONFIG_MP_MAX_NUM_CPUS];
+	/* Threads looking for a block outside their own magazine */
+	atomic_t waiters;
+#endif
 };
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+static inline uint32_t z_mem_slab_num_cached(const struct k_mem_slab *slab)
+{
+	uint32_t num_cached = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		num_cached += slab->magazine[i].count;
+	}
+
+	return num_cached;
+}
+#endif
+
 #define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
 			       _slab_num_blocks)                      \
 	{                                                             \
@@ -5220,7 +5321,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	return slab->info.num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5229,6 +5334,9 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  * This routine gets the maximum number of memory blocks that were
  * allocated in @a slab.
  *
+ * With CONFIG_MEM_SLAB_MAGAZINE, blocks cached in the per-CPU magazines
+ * at the time are included, see the option help.
+ *
  * @param slab Address of the memory slab.
  *
  * @return Maximum number of allocated memory blocks.
@@ -5255,7 +5363,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
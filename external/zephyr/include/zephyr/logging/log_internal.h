@@ -132,6 +132,54 @@ void z_log_msg_free(union log_msg_generic *msg);
  */
 bool z_log_msg_pending(void);
 
+/** @brief Initialize per-CPU staging rings.
+ *
+ * @param buf  Memory split between the rings.
+ * @param wlen Size of @p buf in 32 bit words.
+ */
+void z_log_stage_init(uint32_t *buf, size_t wlen);
+
+/** @brief Reserve space for a message in the staging ring of the caller.
+ *
+ * @param wlen Message length in 32 bit words.
+ *
+ * @return Message or null if the ring is full.
+ */
+struct log_msg *z_log_stage_alloc(uint32_t wlen);
+
+/** @brief Commit a message reserved with z_log_stage_alloc().
+ *
+ * @param msg Message.
+ */
+void z_log_stage_commit(struct log_msg *msg);
+
+/** @brief Claim the oldest committed message from all staging rings.
+ *
+ * @return Message or null if no message is ready.
+ */
+union log_msg_generic *z_log_stage_claim(void);
+
+/** @brief Free a message claimed with z_log_stage_claim().
+ *
+ * @param msg Message.
+ */
+void z_log_stage_free(union log_msg_generic *msg);
+
+/** @brief Check if any staging ring holds a message. */
+bool z_log_stage_pending(void);
+
+/** @brief Get staging rings size and current usage, in bytes. */
+void z_log_stage_get_usage(uint32_t *buf_size, uint32_t *usage);
+
+/** @brief Get number of staging rings. */
+uint32_t z_log_stage_ring_count(void);
+
+/** @brief Get number of messages dropped because a staging ring was full.
+ *
+ * @param ring Ring index.
+ */
+uint32_t z_log_stage_dropped_get(uint32_t ring);
+
 static inline void z_log_notify_drop(const struct mpsc_pbuf_buffer *buffer,
 				     const union mpsc_pbuf_generic *item)
 {
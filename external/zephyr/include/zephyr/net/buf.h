@@ -1315,6 +1315,59 @@ struct net_buf * __must_check net_buf_alloc_with_data(struct net_buf_pool *pool,
 						      k_timeout_t timeout);
 #endif
 
+/**
+ * @brief Allocate several buffers from a pool at once.
+ *
+ * Allocate @p count buffers with @p size bytes of data each and return them
+ * linked as a fragment chain. Buffers that have never been used are taken
+ * under a single acquisition of the pool lock. Either all buffers are
+ * allocated or none.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param size Amount of data each buffer must be able to fit.
+ * @param count Number of buffers to allocate.
+ * @param timeout Overall time to wait for the buffers and their data, with
+ *        the same meaning as for net_buf_alloc_len().
+ *
+ * @return First buffer of the chain or NULL if not all buffers could be
+ *         allocated.
+ */
+struct net_buf * __must_check net_buf_alloc_batch(struct net_buf_pool *pool,
+						  size_t size, size_t count,
+						  k_timeout_t timeout);
+
+/** @brief Data segment used to build a buffer chain. */
+struct net_buf_iovec {
+	/** Start of the segment. */
+	const void *data;
+
+	/** Length of the segment. */
+	size_t len;
+};
+
+/**
+ * @brief Allocate a buffer chain holding a list of data segments.
+ *
+ * Copy the segments in @p iov back to back into a fragment chain allocated
+ * with net_buf_alloc_batch(). With a fixed size pool each buffer is filled
+ * up to the pool's data size, minus @p headroom, so the chain is as short
+ * as possible. With other pools a single buffer is allocated. Each buffer
+ * has @p headroom bytes reserved for headers pushed later on.
+ *
+ * @param pool Which pool to allocate the buffers from.
+ * @param headroom Bytes to reserve at the head of each buffer.
+ * @param iov Array of segments to copy.
+ * @param iovcnt Number of segments in @p iov.
+ * @param timeout Overall time to wait for the buffers and their data.
+ *
+ * @return First buffer of the chain or NULL if out of buffers.
+ */
+struct net_buf * __must_check net_buf_alloc_iovec(struct net_buf_pool *pool,
+						  size_t headroom,
+						  const struct net_buf_iovec *iov,
+						  size_t iovcnt,
+						  k_timeout_t timeout);
+
 /**
  * @brief Get a buffer from a FIFO.
  *
@@ -1430,6 +1483,17 @@ void net_buf_unref_debug(struct net_buf *buf, const char *func, int line);
 void net_buf_unref(struct net_buf *buf);
 #endif
 
+/**
+ * @brief Decrements the reference count of a buffer chain.
+ *
+ * Same as net_buf_unref(), but consecutive fragments that reach a zero
+ * reference count and belong to the same pool are put back into the pool in
+ * a single operation, unless the pool has a custom destroy callback.
+ *
+ * @param buf A valid pointer on a buffer
+ */
+void net_buf_unref_chain(struct net_buf *buf);
+
 /**
  * @brief Increment the reference count of a buffer.
  *
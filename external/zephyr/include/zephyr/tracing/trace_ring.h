@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_TRACING_TRACE_RING_H_
+#define ZEPHYR_INCLUDE_TRACING_TRACE_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Trace ring
+ *
+ * Trace ring records fixed size binary events into a per-CPU RAM ring,
+ * overwriting the oldest ones. Recording an event only takes a timestamp
+ * from timing_counter_get() and copies the event ID and its arguments, so
+ * it can be used on hot paths. Recorded events can be dumped as Common
+ * Trace Format (CTF) streams, e.g. to be opened with Trace Compass or
+ * Babeltrace.
+ *
+ * @defgroup subsys_tracing_trace_ring Trace ring
+ * @ingroup subsys_tracing
+ * @{
+ */
+
+/** @brief Trace ring event IDs. */
+enum trace_ring_event_id {
+	/** HCI packet received. Arguments: buffer type, length, first 16 bits. */
+	TRACE_RING_EVT_BT_HCI_RX = 1,
+	/** HCI packet sent. Arguments: buffer type, length, first 16 bits. */
+	TRACE_RING_EVT_BT_HCI_TX,
+	/** ATT PDU sent. Arguments: connection handle, opcode, length. */
+	TRACE_RING_EVT_BT_ATT_TX,
+	/** ATT PDU received. Arguments: connection handle, opcode, length. */
+	TRACE_RING_EVT_BT_ATT_RX,
+	/** Connection state change. Arguments: connection handle, old state, new state. */
+	TRACE_RING_EVT_BT_CONN_STATE,
+
+	/** First of the events free for application use. */
+	TRACE_RING_EVT_USER0 = 0x100,
+	TRACE_RING_EVT_USER1,
+	TRACE_RING_EVT_USER2,
+	TRACE_RING_EVT_USER3,
+	TRACE_RING_EVT_USER4,
+	TRACE_RING_EVT_USER5,
+	TRACE_RING_EVT_USER6,
+	TRACE_RING_EVT_USER7,
+};
+
+/** @brief Recorded event. */
+struct trace_ring_event {
+	/** Lower 32 bits of timing_counter_get(). */
+	uint32_t timestamp;
+	/** Event ID, see @ref trace_ring_event_id. */
+	uint16_t id;
+	uint16_t reserved;
+	/** Event arguments. */
+	uint32_t arg[3];
+};
+
+/**
+ * @brief Callback receiving dumped data.
+ *
+ * @param data      Data.
+ * @param len       Length of @p data in bytes.
+ * @param user_data User data passed to the dump function.
+ *
+ * @retval 0 on success.
+ * @retval negative errno code to abort the dump.
+ */
+typedef int (*trace_ring_dump_cb_t)(const void *data, size_t len, void *user_data);
+
+/**
+ * @brief Record an event.
+ *
+ * Can be called from any context. Does nothing while recording is disabled.
+ *
+ * @param id Event ID.
+ * @param a0 First argument.
+ * @param a1 Second argument.
+ * @param a2 Third argument.
+ */
+void trace_ring_record(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2);
+
+/**
+ * @brief Enable or disable recording.
+ *
+ * Recording is enabled at boot. Disabling it freezes the rings, e.g. right
+ * after the interval of interest, so that they can be dumped.
+ *
+ * @param enable True to record events.
+ */
+void trace_ring_enable(bool enable);
+
+/** @brief Discard all recorded events. */
+void trace_ring_clear(void);
+
+/**
+ * @brief Get recorded events of a CPU.
+ *
+ * @param cpu            CPU index.
+ * @param[out] count     Number of events available in the ring.
+ * @param[out] discarded Number of events overwritten since the last clear.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p cpu is invalid.
+ */
+int trace_ring_stats_get(uint32_t cpu, uint32_t *count, uint32_t *discarded);
+
+/**
+ * @brief Dump the CTF metadata describing the streams.
+ *
+ * Save the output as the file named "metadata" of a CTF trace directory.
+ *
+ * @param cb        Output callback.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 on success.
+ * @retval negative errno code returned by @p cb.
+ */
+int trace_ring_dump_metadata(trace_ring_dump_cb_t cb, void *user_data);
+
+/**
+ * @brief Dump the events of a CPU as a CTF stream.
+ *
+ * Events are output from the oldest to the newest. Recording should be
+ * disabled while dumping. Save the output as a file, e.g. "stream_<cpu>",
+ * next to the metadata file.
+ *
+ * @param cpu       CPU index.
+ * @param cb        Output callback.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @p cpu is invalid.
+ * @retval negative errno code returned by @p cb.
+ */
+int trace_ring_dump(uint32_t cpu, trace_ring_dump_cb_t cb, void *user_data);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_TRACING_TRACE_RING_H_ */
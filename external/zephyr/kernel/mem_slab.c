@@ -13,11 +13,43 @@
 #include <zephyr/init.h>
 #include <zephyr/sys/check.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/barrier.h>
 #include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Number of blocks moved between a magazine and the slab free list */
+#define MAGAZINE_BATCH (CONFIG_MEM_SLAB_MAGAZINE_SIZE / 2)
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
+#if defined(CONFIG_MEM_SLAB_MAGAZINE) && defined(CONFIG_OBJ_CORE_STATS_MEM_SLAB)
+/* Fill in the magazine related fields of a statistics snapshot and
+ * remove the blocks cached in magazines from the used count.
+ */
+static void magazine_stats_get(struct k_mem_slab *slab,
+			       struct k_mem_slab_info *info)
+{
+	info->num_cached = 0U;
+	info->magazine_hits = 0U;
+	info->magazine_misses = 0U;
+
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_magazine *mag = &slab->magazine[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+
+		info->num_cached += mag->count;
+		info->magazine_hits += mag->hits;
+		info->magazine_misses += mag->misses;
+
+		k_spin_unlock(&mag->lock, key);
+	}
+
+	info->num_used -= info->num_cached;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE && CONFIG_OBJ_CORE_STATS_MEM_SLAB */
+
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
 static struct k_obj_type obj_type_mem_slab;
 
@@ -35,6 +67,10 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	memcpy(stats, &slab->info, sizeof(slab->info));
 	k_spin_unlock(&slab->lock, key);
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	magazine_stats_get(slab, stats);
+#endif
+
 	return 0;
 }
 
@@ -48,9 +84,9 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
-			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->free_bytes = k_mem_slab_num_free_get(slab) * slab->info.block_size;
+	ptr->allocated_bytes = k_mem_slab_num_used_get(slab) *
+			       slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -184,6 +220,13 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		slab->magazine[i] = (struct k_mem_slab_magazine) {};
+	}
+	atomic_clear(&slab->waiters);
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -205,7 +248,9 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+/* Take a block from the slab free list, waiting for one if allowed. */
+static int free_list_alloc(struct k_mem_slab *slab, void **mem,
+			   k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
@@ -250,36 +295,236 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+/* Return a block to the slab free list, or hand it over to the first
+ * thread waiting for one.
+ *
+ * Invoked with slab lock held.
+ *
+ * @return true if a waiting thread was made ready.
+ */
+static bool free_list_put_locked(struct k_mem_slab *slab, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
-	__ASSERT(((char *)mem >= slab->buffer) &&
-		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
-		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
-						  (slab->info.num_blocks - 1)))),
-		 "Invalid memory pointer provided");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
 	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
 		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
 		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
-
 			z_thread_return_value_set_with_data(pending_thread, 0, mem);
 			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
+			return true;
 		}
 	}
 	*(char **) mem = slab->free_list;
 	slab->free_list = (char *) mem;
 	slab->info.num_used--;
 
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+/* Return a batch of blocks to the slab free list. */
+static void free_list_put(struct k_mem_slab *slab, void **blocks, uint32_t n)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool resched = false;
+
+	for (uint32_t i = 0; i < n; i++) {
+		resched |= free_list_put_locked(slab, blocks[i]);
+	}
+
+	if (resched) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+}
+
+/* Hand every block of a magazine back to the slab free list. */
+static void magazine_drain(struct k_mem_slab *slab,
+			   struct k_mem_slab_magazine *mag)
+{
+	void *blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	uint32_t n = mag->count;
+
+	memcpy(blocks, mag->blocks, n * sizeof(void *));
+	mag->count = 0U;
+
+	k_spin_unlock(&mag->lock, key);
+
+	free_list_put(slab, blocks, n);
+}
+
+/* Add blocks to the magazine of the current CPU.  Blocks that don't fit
+ * go back to the slab free list.
+ *
+ * If a thread is looking for a block while this runs, it may have
+ * checked this magazine before the blocks were added: drain the
+ * magazine so that thread gets them.  The waiter count is raised before
+ * magazines are checked, and read here after the blocks are added, so
+ * one side always sees the other.
+ */
+static void magazine_put(struct k_mem_slab *slab, void **blocks, uint32_t n)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_magazine *mag = &slab->magazine[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	void *spill[MAGAZINE_BATCH];
+	uint32_t nspill = 0U;
+
+	if (mag->count + n > CONFIG_MEM_SLAB_MAGAZINE_SIZE) {
+		/* Make room by flushing a batch */
+		while (nspill < MAGAZINE_BATCH) {
+			spill[nspill++] = mag->blocks[--mag->count];
+		}
+	}
+
+	while (n > 0U) {
+		mag->blocks[mag->count++] = blocks[--n];
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	if (nspill > 0U) {
+		free_list_put(slab, spill, nspill);
+	}
+
+	barrier_dmem_fence_full();
+	if (atomic_get(&slab->waiters) != 0) {
+		magazine_drain(slab, mag);
+	}
+}
+
+/* Take a block from the magazine of the current CPU, refilling it from
+ * the slab free list if it is empty.
+ */
+static int magazine_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int irq = arch_irq_lock();
+	struct k_mem_slab_magazine *mag = &slab->magazine[_current_cpu->id];
+	k_spinlock_key_t key = k_spin_lock(&mag->lock);
+	void *batch[MAGAZINE_BATCH];
+	uint32_t n = 0U;
+	bool hit = (mag->count > 0U);
+
+	if (hit) {
+		*mem = mag->blocks[--mag->count];
+		mag->hits++;
+	} else {
+		mag->misses++;
+	}
+
+	k_spin_unlock(&mag->lock, key);
+	arch_irq_unlock(irq);
+
+	if (hit) {
+		return 0;
+	}
+
+	key = k_spin_lock(&slab->lock);
+
+	while (n < MAGAZINE_BATCH && slab->free_list != NULL) {
+		batch[n++] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+	}
+	slab->info.num_used += n;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->info.max_used = MAX(slab->info.num_used, slab->info.max_used);
+#endif
 
 	k_spin_unlock(&slab->lock, key);
+
+	if (n == 0U) {
+		return -ENOMEM;
+	}
+
+	*mem = batch[--n];
+	if (n > 0U) {
+		magazine_put(slab, batch, n);
+	}
+
+	return 0;
+}
+
+/* Take a block cached in the magazine of any CPU. */
+static int magazine_steal(struct k_mem_slab *slab, void **mem)
+{
+	for (unsigned int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		struct k_mem_slab_magazine *mag = &slab->magazine[i];
+		k_spinlock_key_t key = k_spin_lock(&mag->lock);
+		bool found = (mag->count > 0U);
+
+		if (found) {
+			*mem = mag->blocks[--mag->count];
+		}
+
+		k_spin_unlock(&mag->lock, key);
+
+		if (found) {
+			return 0;
+		}
+	}
+
+	return -ENOMEM;
+}
+#endif /* CONFIG_MEM_SLAB_MAGAZINE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	int result;
+
+	if (magazine_alloc(slab, mem) == 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	/* Look at the other magazines before falling back to the free
+	 * list, which may wait.  Blocks cached from now on are handed
+	 * back by magazine_put().
+	 */
+	atomic_inc(&slab->waiters);
+	if (magazine_steal(slab, mem) == 0) {
+		result = 0;
+	} else {
+		result = free_list_alloc(slab, mem, timeout);
+	}
+	atomic_dec(&slab->waiters);
+
+	return result;
+#else
+	return free_list_alloc(slab, mem, timeout);
+#endif
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
+	__ASSERT(((char *)mem >= slab->buffer) &&
+		 ((((char *)mem - slab->buffer) % slab->info.block_size) == 0) &&
+		 ((char *)mem <= (slab->buffer + (slab->info.block_size *
+						  (slab->info.num_blocks - 1)))),
+		 "Invalid memory pointer provided");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+#ifdef CONFIG_MEM_SLAB_MAGAZINE
+	magazine_put(slab, &mem, 1U);
+#else
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if (free_list_put_locked(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		z_reschedule(&slab->lock, key);
+		return;
+	}
+
+	k_spin_unlock(&slab->lock, key);
+#endif
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 }
 
 int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stats *stats)
@@ -290,8 +535,9 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = k_mem_slab_num_used_get(slab) *
+				 slab->info.block_size;
+	stats->free_bytes = k_mem_slab_num_free_get(slab) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -14,8 +14,34 @@
 
 static uint64_t curr_tick;
 
+/* Sorted delta list of pending timeouts, or the overflow list of the
+ * timing wheel when CONFIG_TIMEOUT_WHEEL is enabled.
+ */
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical timing wheel. A pending timeout stores its absolute
+ * expiry tick in dticks and sits in the bucket selected by the highest
+ * group of WHEEL_BITS bits in which its expiry differs from curr_tick:
+ * level 0 buckets hold timeouts expiring at exactly one tick, level N
+ * buckets span 2^(N * WHEEL_BITS) ticks and are cascaded into the lower
+ * levels once curr_tick reaches their start. Timeouts beyond the wheel
+ * span wait on an overflow list that is redistributed whenever curr_tick
+ * crosses a span boundary.
+ *
+ * Buckets are only initialized when their bit in the level map gets set,
+ * so the wheel needs no runtime initialization.
+ */
+#define WHEEL_BITS      5U
+#define WHEEL_SLOTS     BIT(WHEEL_BITS)
+#define WHEEL_MASK      (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_BITS (WHEEL_BITS * WHEEL_LEVELS)
+
+static uint32_t wheel_map[WHEEL_LEVELS];
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +62,7 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +86,188 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* Insert with dticks relative to curr_tick, returns true if @a to is now
+ * the first timeout to expire.
+ */
+static bool insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+/* Ticks from curr_tick to the next expiry, or -1 if none is pending */
+static int64_t next_expiry(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? -1 : to->dticks;
+}
+#else
+/* Wheel level of an absolute expiry tick, WHEEL_LEVELS for overflow */
+static unsigned int wheel_level(uint64_t tick)
+{
+	uint64_t diff = tick ^ curr_tick;
+	unsigned int level;
+
+	for (level = 0U; level < WHEEL_LEVELS; level++) {
+		if ((diff >> (WHEEL_BITS * (level + 1U))) == 0U) {
+			break;
+		}
+	}
+
+	return level;
+}
+
+static inline unsigned int wheel_slot(uint64_t tick, unsigned int level)
+{
+	return (tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+}
+
+/* Tick at which the wheel has to act on a timeout: its expiry for level
+ * 0, else the start of its bucket, where it is cascaded.
+ */
+static uint64_t wheel_event(uint64_t tick)
+{
+	unsigned int level = wheel_level(tick);
+
+	if (level == WHEEL_LEVELS) {
+		return (curr_tick | (BIT64(WHEEL_SPAN_BITS) - 1U)) + 1U;
+	}
+
+	return tick & ~(BIT64(WHEEL_BITS * level) - 1U);
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	unsigned int level = wheel_level(to->dticks);
+	unsigned int slot;
+
+	if (level == WHEEL_LEVELS) {
+		sys_dlist_append(&timeout_list, &to->node);
+		return;
+	}
+
+	slot = wheel_slot(to->dticks, level);
+	if ((wheel_map[level] & BIT(slot)) == 0U) {
+		wheel_map[level] |= BIT(slot);
+		sys_dlist_init(&wheel[level][slot]);
+	}
+
+	sys_dlist_append(&wheel[level][slot], &to->node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	unsigned int level = wheel_level(t->dticks);
+	unsigned int slot;
+
+	sys_dlist_remove(&t->node);
+
+	if (level < WHEEL_LEVELS) {
+		slot = wheel_slot(t->dticks, level);
+		if (sys_dlist_is_empty(&wheel[level][slot])) {
+			wheel_map[level] &= ~BIT(slot);
+		}
+	}
+}
+
+/* Absolute tick of the next wheel event, UINT64_MAX if empty. Events of
+ * a level all precede those of the levels above, so the first non-empty
+ * bucket ahead of curr_tick found bottom-up is the next one.
+ */
+static uint64_t wheel_next(void)
+{
+	for (unsigned int level = 0U; level < WHEEL_LEVELS; level++) {
+		unsigned int pos = wheel_slot(curr_tick, level);
+		uint32_t ahead = (level == 0U) ? (UINT32_MAX << pos) :
+						 ((UINT32_MAX << pos) << 1);
+		uint32_t pending = wheel_map[level] & ahead;
+
+		if (pending != 0U) {
+			uint64_t base = curr_tick &
+				~(BIT64(WHEEL_BITS * (level + 1U)) - 1U);
+
+			return base | ((uint64_t)(find_lsb_set(pending) - 1U) <<
+				       (WHEEL_BITS * level));
+		}
+	}
+
+	if (!sys_dlist_is_empty(&timeout_list)) {
+		return (curr_tick | (BIT64(WHEEL_SPAN_BITS) - 1U)) + 1U;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Redistribute the buckets that curr_tick has reached since @a prev */
+static void wheel_cascade(uint64_t prev)
+{
+	sys_dnode_t *node;
+
+	if ((curr_tick >> WHEEL_SPAN_BITS) != (prev >> WHEEL_SPAN_BITS)) {
+		sys_dlist_t overflow;
+
+		sys_dlist_init(&overflow);
+		while ((node = sys_dlist_get(&timeout_list)) != NULL) {
+			sys_dlist_append(&overflow, node);
+		}
+
+		while ((node = sys_dlist_get(&overflow)) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+
+	for (unsigned int level = WHEEL_LEVELS - 1U; level > 0U; level--) {
+		unsigned int slot = wheel_slot(curr_tick, level);
+
+		if ((wheel_map[level] & BIT(slot)) == 0U) {
+			continue;
+		}
+
+		/* Every timeout in here now lands on a lower level */
+		wheel_map[level] &= ~BIT(slot);
+		while ((node = sys_dlist_get(&wheel[level][slot])) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+}
+
+/* Insert with dticks relative to curr_tick, returns true if @a to is now
+ * the next wheel event.
+ */
+static bool insert_timeout(struct _timeout *to)
+{
+	to->dticks = curr_tick + MAX(1, to->dticks);
+	wheel_insert(to);
+
+	return wheel_event(to->dticks) == wheel_next();
+}
+
+/* Ticks from curr_tick to the next wheel event, or -1 if none is pending.
+ * A cascade event may precede the actual expiry, it never follows it.
+ */
+static int64_t next_expiry(void)
+{
+	uint64_t tick = wheel_next();
+
+	return tick == UINT64_MAX ? -1 : (int64_t)(tick - curr_tick);
+}
+#endif /* !CONFIG_TIMEOUT_WHEEL */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -82,15 +291,15 @@ static int32_t elapsed(void)
 
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	int64_t expiry = next_expiry();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
-	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	if ((expiry < 0) ||
+	    ((int64_t)(expiry - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, expiry - ticks_elapsed);
 	}
 
 	return ret;
@@ -111,8 +320,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -122,20 +329,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
-
-		if (to == first()) {
+		if (insert_timeout(to)) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
 	}
@@ -164,12 +358,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+	ticks = timeout->dticks - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif /* CONFIG_TIMEOUT_WHEEL */
 
 	return ticks - elapsed();
 }
@@ -206,24 +404,10 @@ int32_t z_get_next_timeout_expiry(void)
 	return ret;
 }
 
-void sys_clock_announce(int32_t ticks)
+#ifndef CONFIG_TIMEOUT_WHEEL
+/* Expire the timeouts due within announce_remaining, one at a time */
+static k_spinlock_key_t expire_timeouts(k_spinlock_key_t key)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
-
-	/* We release the lock around the callbacks below, so on SMP
-	 * systems someone might be already running the loop.  Don't
-	 * race (which will cause paralllel execution of "sequential"
-	 * timeouts and confuse apps), just increment the tick count
-	 * and return.
-	 */
-	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
-		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
-		return;
-	}
-
-	announce_remaining = ticks;
-
 	struct _timeout *t;
 
 	for (t = first();
@@ -245,6 +429,69 @@ void sys_clock_announce(int32_t ticks)
 		t->dticks -= announce_remaining;
 	}
 
+	return key;
+}
+#else
+/* Advance the wheel through its events due within announce_remaining,
+ * cascading the buckets reached on the way and expiring a whole level 0
+ * bucket per expiry tick.
+ */
+static k_spinlock_key_t expire_timeouts(k_spinlock_key_t key)
+{
+	uint64_t tick;
+
+	for (tick = wheel_next();
+	     (announce_remaining > 0) &&
+	     (tick <= (curr_tick + announce_remaining));
+	     tick = wheel_next()) {
+		unsigned int slot = wheel_slot(tick, 0U);
+		uint64_t prev = curr_tick;
+		int dt = tick - prev;
+
+		curr_tick = tick;
+		wheel_cascade(prev);
+
+		while ((wheel_map[0] & BIT(slot)) != 0U) {
+			sys_dnode_t *node = sys_dlist_get(&wheel[0][slot]);
+			struct _timeout *t = CONTAINER_OF(node, struct _timeout,
+							  node);
+
+			if (sys_dlist_is_empty(&wheel[0][slot])) {
+				wheel_map[0] &= ~BIT(slot);
+			}
+
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+
+		announce_remaining -= dt;
+	}
+
+	return key;
+}
+#endif /* !CONFIG_TIMEOUT_WHEEL */
+
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+
+	/* We release the lock around the callbacks below, so on SMP
+	 * systems someone might be already running the loop.  Don't
+	 * race (which will cause paralllel execution of "sequential"
+	 * timeouts and confuse apps), just increment the tick count
+	 * and return.
+	 */
+	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
+		announce_remaining += ticks;
+		k_spin_unlock(&timeout_lock, key);
+		return;
+	}
+
+	announce_remaining = ticks;
+
+	key = expire_timeouts(key);
+
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
 
@@ -200,6 +200,9 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	}
 
 	init_flusher(flusher);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	flusher->target = work;
+#endif
 	if (in_list) {
 		sys_slist_insert(&queue->pending, &work->node,
 				 &flusher->work.node);
@@ -245,6 +248,119 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
+/* Determine whether a thread is one of the threads animating a queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to check.
+ * @param thread the thread to look for.
+ *
+ * @return true if and only if @p thread processes items from @p queue.
+ */
+static inline bool queue_is_worker_locked(const struct k_work_q *queue,
+					  const struct k_thread *thread)
+{
+	if (thread == &queue->thread) {
+		return true;
+	}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct k_work_q_worker *worker;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (thread == &worker->thread) {
+			return true;
+		}
+	}
+#endif
+
+	return false;
+}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* Determine whether a pending item may be taken by a worker.
+ *
+ * An item that is still running on another worker must wait for that
+ * worker to finish, to prevent handler re-entrancy.  A flusher must wait
+ * until the item it flushes is no longer running, as with several workers
+ * its position in the pending list no longer implies that.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool work_runnable_locked(const struct k_work *work)
+{
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		return false;
+	}
+
+	if (flag_test(&work->flags, K_WORK_FLUSHING_BIT)) {
+		const struct z_work_flusher *flusher
+			= CONTAINER_OF(work, struct z_work_flusher, work);
+
+		return !flag_test(&flusher->target->flags, K_WORK_RUNNING_BIT);
+	}
+
+	return true;
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
+/* Remove the next item a worker may process from the queue.
+ *
+ * Invoked with work lock held.
+ *
+ * @param queue the queue to take work from.
+ *
+ * @return the node of the work item, or null if no item can be processed.
+ */
+static inline sys_snode_t *queue_get_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_snode_t *prev = NULL;
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+		if (work_runnable_locked(CONTAINER_OF(node, struct k_work,
+						      node))) {
+			sys_slist_remove(&queue->pending, prev, node);
+			return node;
+		}
+		prev = node;
+	}
+
+	return NULL;
+#else
+	return sys_slist_get(&queue->pending);
+#endif
+}
+
+/* Record that a worker of the queue started processing an item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_set_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	queue->busy += 1U;
+#endif
+	flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+/* Record that a worker of the queue finished processing an item.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_busy_clear_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	__ASSERT_NO_MSG(queue->busy > 0U);
+	queue->busy -= 1U;
+	if (queue->busy != 0U) {
+		return;
+	}
+#endif
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
 /* Submit an work item to a queue if queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
@@ -272,7 +388,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_is_worker_locked(queue, _current)
+		&& !k_is_in_isr();
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -628,12 +745,12 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_get_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			queue_busy_set_locked(queue);
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -651,8 +768,10 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+			   && sys_slist_is_empty(&queue->pending)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -702,7 +821,15 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_busy_clear_locked(queue);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		/* Items held back while this one ran may now be taken by
+		 * an idle worker.
+		 */
+		if (!sys_slist_is_empty(&queue->pending)) {
+			(void)notify_queue_locked(queue);
+		}
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -742,6 +869,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_slist_init(&queue->workers);
+	queue->busy = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -766,6 +897,49 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+void k_work_queue_worker_add(struct k_work_q *queue,
+			     struct k_work_q_worker *worker,
+			     k_thread_stack_t *stack,
+			     size_t stack_size,
+			     int prio,
+			     int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_THREAD_NAME
+	const char *name = k_thread_name_get(&queue->thread);
+
+	if (name != NULL) {
+		k_thread_name_set(&worker->thread, name);
+	}
+#endif
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_pin(&worker->thread, cpu);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
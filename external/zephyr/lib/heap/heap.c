@@ -148,6 +148,117 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Size class caching chunks of size "sz", or -1 if that size isn't cached */
+static int cache_idx(struct z_heap *h, chunksz_t sz)
+{
+	chunksz_t idx = sz - min_chunk_size(h);
+
+	return (idx < CONFIG_SYS_HEAP_CACHE_CLASSES) ? (int)idx : -1;
+}
+
+/* Takes a chunk of exactly "sz" units from the front cache, if any.
+ * The returned chunk is still marked used.
+ */
+static chunkid_t cache_get(struct z_heap *h, chunksz_t sz)
+{
+	int ci = cache_idx(h, sz);
+
+	if (ci < 0) {
+		return 0;
+	}
+
+	struct z_heap_cache *hc = &h->cache[ci];
+	chunkid_t c = hc->next;
+
+	if (c == 0U) {
+		h->cache_misses++;
+		return 0;
+	}
+
+	CHECK(chunk_used(h, c));
+	CHECK(chunk_size(h, c) == sz);
+
+	hc->next = next_free_chunk(h, c);
+	hc->count--;
+	h->cache_hits++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+
+	return c;
+}
+
+/* Puts a freed chunk, still marked used, in the front cache.
+ * Returns false if its size class isn't cached or is full.
+ */
+static bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+	int ci = cache_idx(h, sz);
+
+	if (ci < 0 || h->cache[ci].count >= CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		return false;
+	}
+
+	struct z_heap_cache *hc = &h->cache[ci];
+
+	set_next_free_chunk(h, c, hc->next);
+	hc->next = c;
+	hc->count++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+
+	return true;
+}
+
+/* Returns every cached chunk to the main free lists, coalescing them
+ * with their free neighbors.  Returns false if the cache was empty.
+ */
+static bool cache_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		struct z_heap_cache *hc = &h->cache[i];
+
+		while (hc->next != 0U) {
+			chunkid_t c = hc->next;
+
+			hc->next = next_free_chunk(h, c);
+			hc->count--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+			h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+#else
+static inline chunkid_t cache_get(struct z_heap *h, chunksz_t sz)
+{
+	return 0;
+}
+
+static inline bool cache_put(struct z_heap *h, chunkid_t c)
+{
+	return false;
+}
+
+static inline bool cache_flush(struct z_heap *h)
+{
+	return false;
+}
+#endif /* CONFIG_SYS_HEAP_CACHE */
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -184,7 +295,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -194,6 +304,11 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+	if (cache_put(h, c)) {
+		return;
+	}
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -257,6 +372,13 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 		return c;
 	}
 
+	/* Last resort: coalesce whatever the front cache holds back and
+	 * retry once.
+	 */
+	if (cache_flush(h)) {
+		return alloc_chunk(h, sz);
+	}
+
 	return 0;
 }
 
@@ -270,18 +392,22 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c = cache_get(h, chunk_sz);
+
 	if (c == 0U) {
-		return NULL;
-	}
+		c = alloc_chunk(h, chunk_sz);
+		if (c == 0U) {
+			return NULL;
+		}
 
-	/* Split off remainder if any */
-	if (chunk_size(h, c) > chunk_sz) {
-		split_chunks(h, c, c + chunk_sz);
-		free_list_add(h, c + chunk_sz);
-	}
+		/* Split off remainder if any */
+		if (chunk_size(h, c) > chunk_sz) {
+			split_chunks(h, c, c + chunk_sz);
+			free_list_add(h, c + chunk_sz);
+		}
 
-	set_chunk_used(h, c, true);
+		set_chunk_used(h, c, true);
+	}
 
 	mem = chunk_mem(h, c);
 
@@ -517,6 +643,15 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	h->max_allocated_bytes = 0;
 #endif
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	h->cache_hits = 0;
+	h->cache_misses = 0;
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		h->cache[i].next = 0;
+		h->cache[i].count = 0;
+	}
+#endif
+
 	int nb_buckets = bucket_idx(h, heap_sz) + 1;
 	chunksz_t chunk0_size = chunksz(sizeof(struct z_heap) +
 				     nb_buckets * sizeof(struct z_heap_bucket));
@@ -65,6 +65,18 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Front cache of freed chunks of one exact size.  Cached chunks keep
+ * their USED bit set, so they are neither on a bucket free list nor
+ * merged with free neighbors.  The list is singly linked through the
+ * FREE_NEXT field and terminated by 0.
+ */
+struct z_heap_cache {
+	chunkid_t next;
+	uint32_t count;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -73,6 +85,11 @@ struct z_heap {
 	size_t free_bytes;
 	size_t allocated_bytes;
 	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_CACHE
+	uint32_t cache_hits;
+	uint32_t cache_misses;
+	struct z_heap_cache cache[CONFIG_SYS_HEAP_CACHE_CLASSES];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -18,6 +18,10 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	stats->free_bytes = heap->heap->free_bytes;
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
+#ifdef CONFIG_SYS_HEAP_CACHE
+	stats->cache_hits = heap->heap->cache_hits;
+	stats->cache_misses = heap->heap->cache_misses;
+#endif
 
 	return 0;
 }
@@ -68,6 +68,33 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 	}
 }
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+/* Check the front cache lists: every entry must be a valid used chunk
+ * of the class size and the counts must match.  Returns the number of
+ * payload bytes held in the cache through "cached_bytes".
+ */
+static bool check_cache(struct z_heap *h, size_t *cached_bytes)
+{
+	*cached_bytes = 0;
+
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		chunksz_t sz = min_chunk_size(h) + i;
+		uint32_t n = 0;
+
+		for (chunkid_t c = h->cache[i].next; c != 0;
+		     c = next_free_chunk(h, c)) {
+			VALIDATE(valid_chunk(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == sz);
+			VALIDATE(++n <= CONFIG_SYS_HEAP_CACHE_DEPTH);
+			*cached_bytes += chunksz_to_bytes(h, sz);
+		}
+		VALIDATE(n == h->cache[i].count);
+	}
+	return true;
+}
+#endif
+
 bool sys_heap_validate(struct sys_heap *heap)
 {
 	struct z_heap *h = heap->heap;
@@ -85,6 +112,14 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_CACHE
+	size_t cached_bytes;
+
+	if (!check_cache(h, &cached_bytes)) {
+		return false;
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -96,6 +131,11 @@ bool sys_heap_validate(struct sys_heap *heap)
 	struct sys_memory_stats stat;
 
 	get_alloc_info(h, &allocated_bytes, &free_bytes);
+#ifdef CONFIG_SYS_HEAP_CACHE
+	/* Cached chunks look used but are accounted as free */
+	allocated_bytes -= cached_bytes;
+	free_bytes += cached_bytes;
+#endif
 	sys_heap_runtime_stats_get(heap, &stat);
 	if ((stat.allocated_bytes != allocated_bytes) ||
 	    (stat.free_bytes != free_bytes)) {
@@ -19,6 +19,10 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/cbprintf.h>
 
+#ifdef CONFIG_CBPRINTF_FAST_DECIMAL
+#include "cbprintf_dec.h"
+#endif
+
 /* newlib doesn't declare this function unless __POSIX_VISIBLE >= 200809.  No
  * idea how to make that happen, so lets put it right here.
  */
@@ -794,6 +798,13 @@ static char *encode_uint(uint_value_type value,
 	const unsigned int radix = conversion_radix(conv->specifier);
 	char *bp = bps + (bpe - bps);
 
+#ifdef CONFIG_CBPRINTF_FAST_DECIMAL
+	/* The buffer always holds a full decimal representation. */
+	if (radix == 10) {
+		return encode_dec(value, bp);
+	}
+#endif
+
 	do {
 		unsigned int lsv = (unsigned int)(value % radix);
 
@@ -1378,6 +1389,88 @@ int z_cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fp,
 			continue;
 		}
 
+#ifdef CONFIG_CBPRINTF_FAST_DECIMAL
+		/* Plain %s, and %d, %i or %u with an optional l, ll or z
+		 * length, have no flags, width or precision to honor.  Emit
+		 * them without going through the conversion parser.
+		 */
+		if (!tagged_ap) {
+			const char *cp = fp + 1;
+			char length = 0;
+			size_t arg_size = sizeof(int);
+
+			if (*cp == 'l') {
+				length = *cp++;
+				arg_size = sizeof(long);
+				if (*cp == 'l') {
+					length = 'L';
+					arg_size = sizeof(long long);
+					++cp;
+				}
+			} else if (*cp == 'z') {
+				length = *cp++;
+				arg_size = sizeof(size_t);
+			}
+
+			if ((*cp == 's') && (length == 0)) {
+				OUTS(va_arg(ap, const char *), NULL);
+				fp = cp + 1;
+				continue;
+			}
+
+			/* Values that don't fit are left to the generic path
+			 * so that they are reported the same way.
+			 */
+			if (((*cp == 'd') || (*cp == 'i') || (*cp == 'u'))
+			    && (arg_size <= sizeof(uint_value_type))) {
+				uint_value_type uval;
+
+				if (*cp == 'u') {
+					switch (length) {
+					case 'l':
+						uval = va_arg(ap, unsigned long);
+						break;
+					case 'L':
+						uval = va_arg(ap, unsigned long long);
+						break;
+					case 'z':
+						uval = va_arg(ap, size_t);
+						break;
+					default:
+						uval = va_arg(ap, unsigned int);
+						break;
+					}
+				} else {
+					switch (length) {
+					case 'l':
+						sint = va_arg(ap, long);
+						break;
+					case 'L':
+						sint = va_arg(ap, long long);
+						break;
+					case 'z':
+						sint = va_arg(ap, ptrdiff_t);
+						break;
+					default:
+						sint = va_arg(ap, int);
+						break;
+					}
+
+					uval = (uint_value_type)sint;
+					if (sint < 0) {
+						OUTC('-');
+						uval = (uint_value_type)0 - uval;
+					}
+				}
+
+				OUTS(encode_dec(uval, buf + sizeof(buf)),
+				     buf + sizeof(buf));
+				fp = cp + 1;
+				continue;
+			}
+		}
+#endif /* CONFIG_CBPRINTF_FAST_DECIMAL */
+
 		/* Force union into RAM with conversion state to
 		 * mitigate LLVM code generation bug.
 		 */
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_CBPRINTF_DEC_H_
+#define ZEPHYR_LIB_OS_CBPRINTF_DEC_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef CONFIG_64BIT
+
+static inline uint64_t dec_div1e8(uint64_t v)
+{
+	/* The compiler can optimize this on its own on 64-bit architectures */
+	return v / 100000000U;
+}
+
+#else /* CONFIG_64BIT */
+
+/* High 64 bits of the 128-bit product of a and b, from 32-bit partial
+ * products.
+ */
+static inline uint64_t dec_umulh(uint64_t a, uint64_t b)
+{
+	uint64_t a_lo = (uint32_t)a;
+	uint64_t a_hi = a >> 32;
+	uint64_t b_lo = (uint32_t)b;
+	uint64_t b_hi = b >> 32;
+	uint64_t lo_lo = a_lo * b_lo;
+	uint64_t hi_lo = a_hi * b_lo;
+	uint64_t lo_hi = a_lo * b_hi;
+	uint64_t mid = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+
+	return a_hi * b_hi + (hi_lo >> 32) + (mid >> 32);
+}
+
+/*
+ * Division by 10^8 without pulling libgcc's __udivdi3 into the link.
+ *
+ * The quotient is the high part of the product with the reciprocal
+ * ceil(2^90 / 10^8), shifted right by 26, which is exact for the full
+ * 64-bit range.
+ */
+static inline uint64_t dec_div1e8(uint64_t v)
+{
+	return dec_umulh(v, 0xABCC77118461CEFDULL) >> 26;
+}
+
+#endif /* CONFIG_64BIT */
+
+/* Store the two digits of v (< 100) in front of bp. */
+static inline char *dec_put_pair(char *bp, uint32_t v)
+{
+	static const char pairs[200] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	bp -= 2;
+	memcpy(bp, &pairs[2U * v], 2);
+
+	return bp;
+}
+
+/* Writes the decimal representation of value into the buffer ending at bpe.
+ *
+ * Values above 32 bits are split into 8-digit chunks with a single 64-bit
+ * reciprocal multiplication per chunk, the 32-bit parts are then converted
+ * two digits at a time from a lookup table.  At most 20 characters are
+ * written.
+ *
+ * Returns a pointer to the first character of the representation.
+ */
+static inline char *encode_dec(uint64_t value, char *bpe)
+{
+	char *bp = bpe;
+	uint32_t v;
+
+	while (value > UINT32_MAX) {
+		uint64_t q = dec_div1e8(value);
+		uint32_t r = (uint32_t)(value - q * 100000000U);
+
+		/* Chunks are zero padded to 8 digits. */
+		for (int i = 0; i < 4; i++) {
+			uint32_t rq = r / 100U;
+
+			bp = dec_put_pair(bp, r - 100U * rq);
+			r = rq;
+		}
+		value = q;
+	}
+
+	v = (uint32_t)value;
+	while (v >= 100U) {
+		uint32_t q = v / 100U;
+
+		bp = dec_put_pair(bp, v - 100U * q);
+		v = q;
+	}
+
+	if (v >= 10U) {
+		bp = dec_put_pair(bp, v);
+	} else {
+		*--bp = (char)('0' + v);
+	}
+
+	return bp;
+}
+
+#endif /* ZEPHYR_LIB_OS_CBPRINTF_DEC_H_ */
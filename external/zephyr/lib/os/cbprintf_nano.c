@@ -25,6 +25,21 @@ typedef uint32_t uint_value_type;
 #define DIGITS_BUFLEN 10
 #endif
 
+#ifdef CONFIG_CBPRINTF_FAST_DECIMAL
+#include "cbprintf_dec.h"
+
+/* Decimal conversions don't need division, they cover 64 bits regardless
+ * of the integral range.
+ */
+typedef int64_t int_dec_type;
+typedef uint64_t uint_dec_type;
+#define DEC_BUFLEN 20
+#else
+typedef int_value_type int_dec_type;
+typedef uint_value_type uint_dec_type;
+#define DEC_BUFLEN DIGITS_BUFLEN
+#endif
+
 #define ALPHA(fmt) (((fmt) & 0x60) - '0' - 10 + 1)
 
 /* Convert value to string, storing characters downwards */
@@ -77,7 +92,7 @@ int z_cbvprintf_impl(cbprintf_cb out, void *ctx, const char *fmt,
 		     va_list ap, uint32_t flags)
 {
 	size_t count = 0;
-	char buf[DIGITS_BUFLEN];
+	char buf[MAX(DIGITS_BUFLEN, DEC_BUFLEN)];
 	char *prefix, *data;
 	int min_width, precision, data_len;
 	char padding_mode, length_mod, special;
@@ -186,7 +201,7 @@ start:
 		case 'd':
 		case 'i':
 		case 'u': {
-			uint_value_type d;
+			uint_dec_type d;
 
 			SKIP_TAG_IF_NEEDED(ap, tagged_ap);
 
@@ -207,23 +222,23 @@ start:
 					unsigned long long llu =
 						va_arg(ap, unsigned long long);
 
-					if (llu != (uint_value_type) llu) {
+					if (llu != (uint_dec_type) llu) {
 						data = "ERR";
 						data_len = 3;
 						precision = 0;
 						break;
 					}
-					d = (uint_value_type) llu;
+					d = (uint_dec_type) llu;
 				} else {
 					long long lld = va_arg(ap, long long);
 
-					if (lld != (int_value_type) lld) {
+					if (lld != (int_dec_type) lld) {
 						data = "ERR";
 						data_len = 3;
 						precision = 0;
 						break;
 					}
-					d = (int_value_type) lld;
+					d = (int_dec_type) lld;
 				}
 			} else if (*fmt == 'u') {
 				d = va_arg(ap, unsigned int);
@@ -231,7 +246,7 @@ start:
 				d = va_arg(ap, int);
 			}
 
-			if (*fmt != 'u' && (int_value_type)d < 0) {
+			if (*fmt != 'u' && (int_dec_type)d < 0) {
 				d = -d;
 				prefix = "-";
 				min_width--;
@@ -244,8 +259,13 @@ start:
 			} else {
 				;
 			}
+#ifdef CONFIG_CBPRINTF_FAST_DECIMAL
+			data = encode_dec(d, buf + sizeof(buf));
+			data_len = buf + sizeof(buf) - data;
+#else
 			data_len = convert_value(d, 10, 0, buf + sizeof(buf) - 1);
 			data = buf + sizeof(buf) - data_len;
+#endif
 			break;
 		}
 
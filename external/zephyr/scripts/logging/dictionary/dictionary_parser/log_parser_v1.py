@@ -445,6 +445,43 @@ class LogParserV1(LogParser):
         return next_msg_offset
 
 
+    def get_msg_len(self, logdata, offset=0):
+        """
+        Return the length of the message starting at offset, or None if
+        logdata does not contain the whole message yet
+        """
+        start = offset
+
+        if len(logdata) < offset + struct.calcsize(self.fmt_msg_type):
+            return None
+
+        msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
+        offset += struct.calcsize(self.fmt_msg_type)
+
+        if msg_type == MSG_TYPE_DROPPED:
+            offset += struct.calcsize(self.fmt_dropped_cnt)
+
+        elif msg_type == MSG_TYPE_NORMAL:
+            if len(logdata) < offset + struct.calcsize(self.fmt_msg_hdr):
+                return None
+
+            log_desc = struct.unpack_from(self.fmt_msg_hdr, logdata, offset)[0]
+            offset += struct.calcsize(self.fmt_msg_hdr)
+            offset += struct.calcsize(self.fmt_msg_timestamp)
+
+            # pkg_len and data_len
+            offset += (log_desc >> 6) & int(math.pow(2, 10) - 1)
+            offset += (log_desc >> 16) & int(math.pow(2, 12) - 1)
+
+        else:
+            raise ValueError(f"Unknown message type: {msg_type}")
+
+        if len(logdata) < offset:
+            return None
+
+        return offset - start
+
+
     def parse_log_data(self, logdata, debug=False):
         """Parse binary log data and print the encoded log messages"""
         offset = 0
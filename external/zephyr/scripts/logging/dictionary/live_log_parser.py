@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Live Log Parser for Dictionary-based Logging
+
+This uses the JSON database file to decode the binary log data read
+continuously from a serial port, a file or stdin, and prints the log
+messages as soon as they are complete.
+"""
+
+import argparse
+import binascii
+import logging
+import sys
+
+import dictionary_parser
+from dictionary_parser.log_database import LogDatabase
+
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+LOG_HEX_SEP = b"##ZLOGV1##"
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+    argparser.add_argument("--serial", help="Serial port to read log data from")
+    argparser.add_argument("--baudrate", type=int, default=115200,
+                           help="Serial port baud rate")
+    argparser.add_argument("--file", help="File to read log data from, default stdin")
+    argparser.add_argument("--hex", action="store_true",
+                           help="Log data is in hexadecimal strings")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def open_input(args):
+    """Return a callable reading the next chunk of raw input"""
+    if args.serial:
+        import serial # pylint: disable=import-outside-toplevel
+
+        port = serial.Serial(args.serial, args.baudrate, timeout=0.1)
+        return lambda: port.read(max(1, port.in_waiting))
+
+    if args.file:
+        stream = open(args.file, "rb") # pylint: disable=consider-using-with
+    else:
+        stream = sys.stdin.buffer
+
+    return lambda: stream.read1(4096)
+
+
+class HexDecoder:
+    """Turn the hexadecimal output of the UART backend back into binary"""
+    def __init__(self):
+        self.synced = False
+        self.pending = b""
+
+    def decode(self, data):
+        """Return the binary log data contained in data"""
+        self.pending += bytes(c for c in data if chr(c) not in " \t\r\n")
+
+        if not self.synced:
+            idx = self.pending.find(LOG_HEX_SEP)
+            if idx < 0:
+                # Keep enough to match a separator split across reads
+                self.pending = self.pending[-len(LOG_HEX_SEP):]
+                return b""
+
+            self.pending = self.pending[idx + len(LOG_HEX_SEP):]
+            self.synced = True
+
+        length = len(self.pending) & ~1
+        try:
+            out = binascii.unhexlify(self.pending[:length])
+        except binascii.Error:
+            logger.error("ERROR: invalid hexadecimal data, resyncing...")
+            self.synced = False
+            self.pending = b""
+            return b""
+
+        self.pending = self.pending[length:]
+        return out
+
+
+def main():
+    """Main function of live log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    # Read from database file
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    read_input = open_input(args)
+    hex_decoder = HexDecoder() if args.hex else None
+    logdata = b""
+
+    try:
+        while True:
+            data = read_input()
+            if not data:
+                if args.serial:
+                    continue
+                break
+
+            if hex_decoder is not None:
+                data = hex_decoder.decode(data)
+
+            logdata += data
+
+            # Only hand complete messages over to the parser
+            while True:
+                try:
+                    msg_len = log_parser.get_msg_len(logdata)
+                except ValueError as err:
+                    logger.debug("%s, skipping one byte", err)
+                    logdata = logdata[1:]
+                    continue
+
+                if msg_len is None:
+                    break
+
+                if not log_parser.parse_log_data(logdata[:msg_len], debug=args.debug):
+                    logger.error("ERROR: there were error(s) parsing log data")
+
+                logdata = logdata[msg_len:]
+
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
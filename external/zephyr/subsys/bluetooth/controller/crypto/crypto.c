@@ -4,6 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+
+#include <zephyr/bluetooth/crypto.h>
+
 #include "common/bt_str.h"
 
 #include "util/memq.h"
@@ -45,3 +49,26 @@ int bt_encrypt_be(const uint8_t key[16], const uint8_t plaintext[16],
 
 	return 0;
 }
+
+/* The ECB peripheral takes the key with every block, the context only keeps
+ * a copy of it.
+ */
+int bt_aes_ctx_init(struct bt_aes_ctx *ctx, const uint8_t key[16])
+{
+	memcpy(ctx->key, key, sizeof(ctx->key));
+
+	return 0;
+}
+
+int bt_aes_ctx_encrypt_be(const struct bt_aes_ctx *ctx, const uint8_t plaintext[16],
+			  uint8_t enc_data[16])
+{
+	ecb_encrypt_be(ctx->key, plaintext, enc_data);
+
+	return 0;
+}
+
+void bt_aes_ctx_clear(struct bt_aes_ctx *ctx)
+{
+	(void)memset(ctx, 0, sizeof(*ctx));
+}
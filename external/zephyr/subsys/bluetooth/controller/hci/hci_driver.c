@@ -81,6 +81,11 @@ static sys_slist_t hbuf_pend;
 static int32_t hbuf_count;
 #endif
 
+#if (CONFIG_BT_CTLR_HCI_RX_BURST > 1)
+static struct net_buf *rx_burst[CONFIG_BT_CTLR_HCI_RX_BURST];
+static uint8_t rx_burst_count;
+#endif /* CONFIG_BT_CTLR_HCI_RX_BURST > 1 */
+
 #if defined(CONFIG_BT_CTLR_ISO)
 
 #define SDU_HCI_HDR_SIZE (BT_HCI_ISO_HDR_SIZE + BT_HCI_ISO_TS_DATA_HDR_SIZE)
@@ -596,6 +601,59 @@ static inline struct net_buf *process_hbuf(struct node_rx_pdu *n)
 }
 #endif
 
+#if (CONFIG_BT_CTLR_HCI_RX_BURST > 1)
+static void rx_burst_flush(void)
+{
+	if (rx_burst_count) {
+		(void)bt_recv_burst(rx_burst, rx_burst_count);
+		rx_burst_count = 0U;
+	}
+}
+
+static bool rx_burst_class(uint8_t class)
+{
+	/* With ACL flow control, ACL data has to go through process_hbuf()
+	 * so that the Host buffer accounting stays correct.
+	 */
+	return (class == HCI_CLASS_EVT_DISCARDABLE) ||
+	       (!IS_ENABLED(CONFIG_BT_HCI_ACL_FLOW_CONTROL) &&
+		(class == HCI_CLASS_ACL_DATA));
+}
+#endif /* CONFIG_BT_CTLR_HCI_RX_BURST > 1 */
+
+static void recv_deliver(struct net_buf *buf)
+{
+	while (buf) {
+		struct net_buf *frag;
+
+		/* Increment ref count, which will be
+		 * unref on call to net_buf_frag_del
+		 */
+		frag = net_buf_ref(buf);
+		buf = net_buf_frag_del(NULL, buf);
+
+		if (frag->len) {
+			LOG_DBG("Packet in: type:%u len:%u", bt_buf_get_type(frag),
+				frag->len);
+
+#if (CONFIG_BT_CTLR_HCI_RX_BURST > 1)
+			rx_burst[rx_burst_count++] = frag;
+			if (rx_burst_count == ARRAY_SIZE(rx_burst)) {
+				rx_burst_flush();
+			}
+#else /* CONFIG_BT_CTLR_HCI_RX_BURST == 1 */
+			bt_recv(frag);
+#endif /* CONFIG_BT_CTLR_HCI_RX_BURST == 1 */
+		} else {
+			net_buf_unref(frag);
+		}
+
+#if (CONFIG_BT_CTLR_HCI_RX_BURST == 1)
+		k_yield();
+#endif /* CONFIG_BT_CTLR_HCI_RX_BURST == 1 */
+	}
+}
+
 /**
  * @brief Blockingly pull from Controller thread's recv_fifo
  * @details Execution context: Host thread
@@ -647,26 +705,29 @@ static void recv_thread(void *p1, void *p2, void *p3)
 			buf = process_node(node_rx);
 		}
 
-		while (buf) {
-			struct net_buf *frag;
-
-			/* Increment ref count, which will be
-			 * unref on call to net_buf_frag_del
-			 */
-			frag = net_buf_ref(buf);
-			buf = net_buf_frag_del(NULL, buf);
-
-			if (frag->len) {
-				LOG_DBG("Packet in: type:%u len:%u", bt_buf_get_type(frag),
-					frag->len);
+		recv_deliver(buf);
 
-				bt_recv(frag);
-			} else {
-				net_buf_unref(frag);
+#if (CONFIG_BT_CTLR_HCI_RX_BURST > 1)
+		/* Coalesce consecutive advertising report and ACL data nodes
+		 * already queued into the same burst.
+		 */
+		for (uint8_t count = 1U;
+		     node_rx && (count < CONFIG_BT_CTLR_HCI_RX_BURST);
+		     count++) {
+			node_rx = k_fifo_peek_head(&recv_fifo);
+			if (!node_rx || !rx_burst_class(node_rx->hdr.user_meta)) {
+				break;
 			}
 
-			k_yield();
+			(void)k_fifo_get(&recv_fifo, K_NO_WAIT);
+
+			recv_deliver(process_node(node_rx));
 		}
+
+		rx_burst_flush();
+
+		k_yield();
+#endif /* CONFIG_BT_CTLR_HCI_RX_BURST > 1 */
 	}
 }
 
@@ -718,6 +718,178 @@ static isoal_status_t isoal_rx_append_to_sdu(struct isoal_sink *sink,
 }
 
 
+/**
+ * @brief Reconstruct the SDU synchronization reference of the unframed SDU
+ *        starting with the given PDU
+ *
+ * @param sink[in,out]  Destination sink with the SDU in production
+ * @param meta[in]      Meta information of the first PDU of the SDU
+ */
+static void isoal_rx_unframed_sdu_timestamp(struct isoal_sink *sink,
+					    const struct node_rx_iso_meta *meta)
+{
+	struct isoal_sink_session *session;
+	struct isoal_sdu_production *sp;
+	struct isoal_sdu_produced *sdu;
+	uint32_t anchorpoint;
+	uint16_t sdu_offset;
+	int32_t latency;
+
+	session = &sink->session;
+	sp = &sink->sdu_production;
+
+	/* The incoming time stamp for each PDU is expected to be the
+	 * CIS / BIS reference anchor point. SDU reference point is
+	 * reconstructed by adding the precalculated latency constant.
+	 *
+	 * BT Core V5.3 : Vol 6 Low Energy Controller : Part G IS0-AL:
+	 * 3.2.2 SDU synchronization reference using unframed PDUs:
+	 *
+	 * The CIS reference anchor point is computed excluding any
+	 * retransmissions or missed subevents and shall be set to the
+	 * start of the isochronous event in which the first PDU
+	 * containing the SDU could have been transferred.
+	 *
+	 * The BIG reference anchor point is the anchor point of the BIG
+	 * event that the PDU is associated with.
+	 */
+	anchorpoint = meta->timestamp;
+	latency = session->sdu_sync_const;
+	sdu = &sp->sdu;
+	sdu->timestamp = isoal_get_wrapped_time_us(anchorpoint, latency);
+
+	/* If there are multiple SDUs in an ISO interval
+	 * (SDU interval < ISO Interval) every SDU after the first
+	 * should add an SDU interval to the time stamp.
+	 *
+	 * BT Core V5.3 : Vol 6 Low Energy Controller : Part G IS0-AL:
+	 * 3.2.2 SDU synchronization reference using unframed PDUs:
+	 *
+	 * All PDUs belonging to a burst as defined by the configuration
+	 * of BN have the same reference anchor point. When multiple
+	 * SDUs have the same reference anchor point, the first SDU uses
+	 * the reference anchor point timing. Each subsequent SDU
+	 * increases the SDU synchronization reference timing with one
+	 * SDU interval.
+	 */
+	sdu_offset = (meta->payload_number % session->burst_number) / session->pdus_per_sdu;
+	sdu->timestamp = isoal_get_wrapped_time_us(sdu->timestamp,
+				sdu_offset * session->sdu_interval);
+}
+
+#if defined(CONFIG_BT_CTLR_ISOAL_RX_UNFRAMED_FAST)
+/**
+ * @brief Check if an unframed PDU carries a complete SDU on its own
+ * @details This is the common case of one PDU per SDU (BN equal to the
+ *          number of SDUs per ISO interval) received valid and with no SDU
+ *          in production. Such a PDU cannot contribute to an error state,
+ *          the fragment FSM or the buffered SDU list.
+ *
+ * @param sink[in]      Destination sink with bookkeeping state
+ * @param pdu_meta[in]  PDU with meta information (origin, timing, status)
+ *
+ * @return true if the PDU can be consumed by the single SDU fast path
+ */
+static bool isoal_rx_unframed_is_single(const struct isoal_sink *sink,
+					const struct isoal_pdu_rx *pdu_meta)
+{
+	const struct isoal_sdu_production *sp = &sink->sdu_production;
+	const struct pdu_iso *pdu = pdu_meta->pdu;
+
+#if defined(ISOAL_BUFFER_RX_SDUS_ENABLE)
+	if (sp->sdu_list.next_write_indx != 0U) {
+		return false;
+	}
+#endif /* ISOAL_BUFFER_RX_SDUS_ENABLE */
+
+	/* With one PDU per SDU every PDU is the last of its SDU, hence the
+	 * FSM returns to ISOAL_START after each one and sequence errors
+	 * cannot span SDUs.
+	 */
+	return (sink->session.pdus_per_sdu == 1U) &&
+	       (pdu_meta->meta->status == ISOAL_PDU_STATUS_VALID) &&
+	       (pdu->ll_id == PDU_BIS_LLID_COMPLETE_END) &&
+	       (pdu->len > 0U) &&
+	       (sp->sdu_available == 0U);
+}
+
+/**
+ * @brief Consume an unframed PDU holding a complete SDU
+ * @details Allocates, writes and emits the SDU in one step, bypassing the
+ *          fragment loop and the buffered SDU collation. Falls back to the
+ *          generic append when the allocated SDU buffer is smaller than the
+ *          PDU payload.
+ *
+ * @param sink[in,out]    Destination sink with bookkeeping state
+ * @param pdu_meta[in]    PDU with meta information (origin, timing, status)
+ *
+ * @return Status
+ */
+static isoal_status_t isoal_rx_unframed_consume_single(struct isoal_sink *sink,
+						       const struct isoal_pdu_rx *pdu_meta)
+{
+	struct isoal_emitted_sdu_frag sdu_frag;
+	struct isoal_emitted_sdu sdu_status;
+	struct isoal_sink_session *session;
+	struct isoal_sdu_production *sp;
+	struct isoal_sdu_produced *sdu;
+	struct node_rx_iso_meta *meta;
+	struct pdu_iso *pdu;
+	isoal_status_t err;
+	uint8_t length;
+
+	sp = &sink->sdu_production;
+	session = &sink->session;
+	sdu = &sp->sdu;
+	meta = pdu_meta->meta;
+	pdu = pdu_meta->pdu;
+	length = pdu->len;
+
+	sp->sdu_status = ISOAL_SDU_STATUS_VALID;
+	sp->sdu_state = BT_ISO_START;
+	sp->pdu_cnt = 1;
+	sp->only_padding = 0U;
+
+	isoal_rx_unframed_sdu_timestamp(sink, meta);
+
+	err = isoal_rx_allocate_sdu(sink, pdu_meta);
+	if (!sp->sdu_allocated || (sp->sdu_available < length)) {
+		err |= isoal_rx_append_to_sdu(sink, pdu_meta, 0, length, true, false);
+	} else {
+		err |= session->sdu_write(sdu->contents.dbuf, pdu->payload, length);
+
+		sp->sdu_written = length;
+		sp->sdu_available = 0U;
+		sdu->status = ISOAL_SDU_STATUS_VALID;
+
+		sdu_frag.sdu = *sdu;
+		sdu_frag.sdu_state = BT_ISO_SINGLE;
+		sdu_frag.sdu_frag_size = length;
+		sdu_status.total_sdu_size = length;
+		sdu_status.collated_status = ISOAL_SDU_STATUS_VALID;
+
+		ISOAL_LOG_DBG("[%p] SDU %u @TS=%u err=%X len=%u released\n",
+			      sink, sdu_frag.sdu.sn, sdu_frag.sdu.timestamp,
+			      sdu_status.collated_status, sdu_status.total_sdu_size);
+		err |= session->sdu_emit(sink, &sdu_frag, &sdu_status);
+
+		sp->sdu_allocated = 0U;
+		session->sn++;
+	}
+
+	/* Update next state */
+	sp->fsm = ISOAL_START;
+	sp->sdu_state = BT_ISO_START;
+	sp->prev_pdu_id = meta->payload_number;
+	sp->prev_pdu_is_end = 1U;
+	sp->prev_pdu_is_padding = 0U;
+
+	sp->initialized = 1U;
+
+	return err;
+}
+#endif /* CONFIG_BT_CTLR_ISOAL_RX_UNFRAMED_FAST */
+
 /**
  * @brief Consume an unframed PDU: Copy contents into SDU(s) and emit to a sink
  * @details Destination sink may have an already partially built SDU
@@ -795,54 +967,13 @@ static isoal_status_t isoal_rx_unframed_consume(struct isoal_sink *sink,
 	}
 
 	if (sp->fsm == ISOAL_START) {
-		struct isoal_sdu_produced *sdu;
-		uint32_t anchorpoint;
-		uint16_t sdu_offset;
-		int32_t latency;
-
 		sp->sdu_status = ISOAL_SDU_STATUS_VALID;
 		sp->sdu_state = BT_ISO_START;
 		sp->pdu_cnt = 1;
 		sp->only_padding = pdu_padding;
 		seq_err = false;
 
-		/* The incoming time stamp for each PDU is expected to be the
-		 * CIS / BIS reference anchor point. SDU reference point is
-		 * reconstructed by adding the precalculated latency constant.
-		 *
-		 * BT Core V5.3 : Vol 6 Low Energy Controller : Part G IS0-AL:
-		 * 3.2.2 SDU synchronization reference using unframed PDUs:
-		 *
-		 * The CIS reference anchor point is computed excluding any
-		 * retransmissions or missed subevents and shall be set to the
-		 * start of the isochronous event in which the first PDU
-		 * containing the SDU could have been transferred.
-		 *
-		 * The BIG reference anchor point is the anchor point of the BIG
-		 * event that the PDU is associated with.
-		 */
-		anchorpoint = meta->timestamp;
-		latency = session->sdu_sync_const;
-		sdu = &sp->sdu;
-		sdu->timestamp = isoal_get_wrapped_time_us(anchorpoint, latency);
-
-		/* If there are multiple SDUs in an ISO interval
-		 * (SDU interval < ISO Interval) every SDU after the first
-		 * should add an SDU interval to the time stamp.
-		 *
-		 * BT Core V5.3 : Vol 6 Low Energy Controller : Part G IS0-AL:
-		 * 3.2.2 SDU synchronization reference using unframed PDUs:
-		 *
-		 * All PDUs belonging to a burst as defined by the configuration
-		 * of BN have the same reference anchor point. When multiple
-		 * SDUs have the same reference anchor point, the first SDU uses
-		 * the reference anchor point timing. Each subsequent SDU
-		 * increases the SDU synchronization reference timing with one
-		 * SDU interval.
-		 */
-		sdu_offset = (meta->payload_number % session->burst_number) / session->pdus_per_sdu;
-		sdu->timestamp = isoal_get_wrapped_time_us(sdu->timestamp,
-					sdu_offset * session->sdu_interval);
+		isoal_rx_unframed_sdu_timestamp(sink, meta);
 	} else {
 		sp->pdu_cnt++;
 	}
@@ -1417,6 +1548,10 @@ isoal_status_t isoal_rx_pdu_recombine(isoal_sink_handle_t sink_hdl,
 	if (sink && sink->sdu_production.mode != ISOAL_PRODUCTION_MODE_DISABLED) {
 		if (sink->session.framed) {
 			err = isoal_rx_framed_consume(sink, pdu_meta);
+#if defined(CONFIG_BT_CTLR_ISOAL_RX_UNFRAMED_FAST)
+		} else if (isoal_rx_unframed_is_single(sink, pdu_meta)) {
+			err = isoal_rx_unframed_consume_single(sink, pdu_meta);
+#endif /* CONFIG_BT_CTLR_ISOAL_RX_UNFRAMED_FAST */
 		} else {
 			err = isoal_rx_unframed_consume(sink, pdu_meta);
 		}
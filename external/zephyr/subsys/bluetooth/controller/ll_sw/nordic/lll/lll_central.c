@@ -36,6 +36,7 @@
 #include "lll_internal.h"
 #include "lll_df_internal.h"
 #include "lll_tim_internal.h"
+#include "lll_prof_internal.h"
 
 #include <soc.h>
 #include "hal/debug.h"
@@ -121,6 +122,7 @@ static int prepare_cb(struct lll_prepare_param *p)
 
 	/* Calculate the current event latency */
 	lll->latency_event = lll->latency_prepare + p->lazy;
+	lll_prof_skip_capture(lll->latency_event);
 
 	/* Calculate the current event counter value */
 	event_counter = lll->event_counter + lll->latency_event;
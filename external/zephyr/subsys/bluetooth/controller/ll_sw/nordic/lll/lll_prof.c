@@ -9,6 +9,7 @@
 #include <errno.h>
 
 #include <zephyr/toolchain.h>
+#include <zephyr/sys/util.h>
 
 #include "hal/ccm.h"
 #include "hal/radio.h"
@@ -21,25 +22,28 @@
 
 #include "lll.h"
 
+#include "lll_prof_internal.h"
+
 static int send(struct node_rx_pdu *rx);
 static inline void sample(uint32_t *timestamp);
-static inline void delta(uint32_t timestamp, uint8_t *cputime);
+static inline void delta(uint32_t timestamp, uint16_t *cputime);
 
 static uint32_t timestamp_radio;
 static uint32_t timestamp_lll;
 static uint32_t timestamp_ull_high;
 static uint32_t timestamp_ull_low;
-static uint8_t cputime_radio;
-static uint8_t cputime_lll;
-static uint8_t cputime_ull_high;
-static uint8_t cputime_ull_low;
-static uint8_t latency_min = (uint8_t) -1;
-static uint8_t latency_max;
-static uint8_t latency_prev;
-static uint8_t cputime_min = (uint8_t) -1;
-static uint8_t cputime_max;
-static uint8_t cputime_prev;
+static uint16_t cputime_radio;
+static uint16_t cputime_lll;
+static uint16_t cputime_ull_high;
+static uint16_t cputime_ull_low;
+static uint16_t latency_min = (uint16_t) -1;
+static uint16_t latency_max;
+static uint16_t latency_prev;
+static uint16_t cputime_min = (uint16_t) -1;
+static uint16_t cputime_max;
+static uint16_t cputime_prev;
 static uint32_t timestamp_latency;
+static uint32_t event_skips;
 
 void lll_prof_enter_radio(void)
 {
@@ -81,6 +85,27 @@ void lll_prof_exit_ull_low(void)
 	delta(timestamp_ull_low, &cputime_ull_low);
 }
 
+void lll_prof_skip_capture(uint16_t latency_event)
+{
+	/* Accumulate connection events that were not placed on air, either
+	 * skipped by the ticker or aborted before their prepare was done.
+	 */
+	event_skips += latency_event;
+}
+
+void lll_prof_stats_get(struct lll_prof_stats *stats)
+{
+	stats->latency_min = latency_min;
+	stats->latency_max = latency_max;
+	stats->cputime_min = cputime_min;
+	stats->cputime_max = cputime_max;
+	stats->cputime_radio = cputime_radio;
+	stats->cputime_lll = cputime_lll;
+	stats->cputime_ull_high = cputime_ull_high;
+	stats->cputime_ull_low = cputime_ull_low;
+	stats->event_skips = event_skips;
+}
+
 void lll_prof_latency_capture(void)
 {
 	/* sample the packet timer, use it to calculate ISR latency
@@ -155,9 +180,10 @@ void lll_prof_reserve_send(struct node_rx_pdu *rx)
 
 static int send(struct node_rx_pdu *rx)
 {
-	uint8_t latency, cputime, prev;
+	uint32_t latency, cputime;
 	struct pdu_data *pdu;
 	struct profile *p;
+	uint16_t prev;
 	uint8_t chg = 0U;
 
 	/* calculate the elapsed time in us since on-air radio packet end
@@ -168,6 +194,7 @@ static int send(struct node_rx_pdu *rx)
 #else /* !HAL_RADIO_GPIO_HAVE_PA_PIN */
 	latency = timestamp_latency - radio_tmr_end_get();
 #endif /* !HAL_RADIO_GPIO_HAVE_PA_PIN */
+	latency = MIN(latency, UINT16_MAX);
 
 	/* check changes in min, avg and max of latency */
 	if (latency > latency_max) {
@@ -180,7 +207,7 @@ static int send(struct node_rx_pdu *rx)
 	}
 
 	/* check for +/- 1us change */
-	prev = ((uint16_t)latency_prev + latency) >> 1;
+	prev = ((uint32_t)latency_prev + latency) >> 1;
 	if (prev != latency_prev) {
 		latency_prev = latency;
 		chg = 1U;
@@ -188,6 +215,7 @@ static int send(struct node_rx_pdu *rx)
 
 	/* calculate the elapsed time in us since ISR entry */
 	cputime = radio_tmr_sample_get() - timestamp_latency;
+	cputime = MIN(cputime, UINT16_MAX);
 
 	/* check changes in min, avg and max */
 	if (cputime > cputime_max) {
@@ -201,7 +229,7 @@ static int send(struct node_rx_pdu *rx)
 	}
 
 	/* check for +/- 1us change */
-	prev = ((uint16_t)cputime_prev + cputime) >> 1;
+	prev = ((uint32_t)cputime_prev + cputime) >> 1;
 	if (prev != cputime_prev) {
 		cputime_prev = cputime;
 		chg = 1U;
@@ -226,16 +254,16 @@ static int send(struct node_rx_pdu *rx)
 
 	pdu = (void *)rx->pdu;
 	p = &pdu->profile;
-	p->lcur = latency;
-	p->lmin = latency_min;
-	p->lmax = latency_max;
-	p->cur = cputime;
-	p->min = cputime_min;
-	p->max = cputime_max;
-	p->radio = cputime_radio;
-	p->lll = cputime_lll;
-	p->ull_high = cputime_ull_high;
-	p->ull_low = cputime_ull_low;
+	p->lcur = MIN(latency, UINT8_MAX);
+	p->lmin = MIN(latency_min, UINT8_MAX);
+	p->lmax = MIN(latency_max, UINT8_MAX);
+	p->cur = MIN(cputime, UINT8_MAX);
+	p->min = MIN(cputime_min, UINT8_MAX);
+	p->max = MIN(cputime_max, UINT8_MAX);
+	p->radio = MIN(cputime_radio, UINT8_MAX);
+	p->lll = MIN(cputime_lll, UINT8_MAX);
+	p->ull_high = MIN(cputime_ull_high, UINT8_MAX);
+	p->ull_low = MIN(cputime_ull_low, UINT8_MAX);
 
 	ull_rx_put_sched(rx->hdr.link, rx);
 
@@ -248,13 +276,18 @@ static inline void sample(uint32_t *timestamp)
 	*timestamp = radio_tmr_sample_get();
 }
 
-static inline void delta(uint32_t timestamp, uint8_t *cputime)
+static inline void delta(uint32_t timestamp, uint16_t *cputime)
 {
 	uint32_t delta;
 
 	radio_tmr_sample();
 	delta = radio_tmr_sample_get() - timestamp;
-	if (delta < UINT8_MAX && delta > *cputime) {
+
+	/* Saturate instead of skipping long samples, so that the maximum
+	 * is not under reported.
+	 */
+	delta = MIN(delta, UINT16_MAX);
+	if (delta > *cputime) {
 		*cputime = delta;
 	}
 }
@@ -4,6 +4,18 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+struct lll_prof_stats {
+	uint16_t latency_min;
+	uint16_t latency_max;
+	uint16_t cputime_min;
+	uint16_t cputime_max;
+	uint16_t cputime_radio;
+	uint16_t cputime_lll;
+	uint16_t cputime_ull_high;
+	uint16_t cputime_ull_low;
+	uint32_t event_skips;
+};
+
 #if defined(CONFIG_BT_CTLR_PROFILE_ISR)
 void lll_prof_enter_radio(void);
 void lll_prof_exit_radio(void);
@@ -13,6 +25,8 @@ void lll_prof_enter_ull_high(void);
 void lll_prof_exit_ull_high(void);
 void lll_prof_enter_ull_low(void);
 void lll_prof_exit_ull_low(void);
+void lll_prof_skip_capture(uint16_t latency_event);
+void lll_prof_stats_get(struct lll_prof_stats *stats);
 #else
 static inline void lll_prof_enter_radio(void) {}
 static inline void lll_prof_exit_radio(void) {}
@@ -22,10 +36,11 @@ static inline void lll_prof_enter_ull_high(void) {}
 static inline void lll_prof_exit_ull_high(void) {}
 static inline void lll_prof_enter_ull_low(void) {}
 static inline void lll_prof_exit_ull_low(void) {}
+static inline void lll_prof_skip_capture(uint16_t latency_event) {}
 #endif
 
 void lll_prof_latency_capture(void);
-void lll_prof_radio_end_backup(void);
+uint32_t lll_prof_radio_end_backup(void);
 void lll_prof_cputime_capture(void);
 void lll_prof_send(void);
 struct node_rx_pdu *lll_prof_reserve(void);
@@ -50,6 +50,7 @@
 #include "ull_adv_internal.h"
 #include "ull_conn_internal.h"
 #include "ull_conn_iso_internal.h"
+#include "ull_sched_internal.h"
 
 #include "ll_feat.h"
 
@@ -64,6 +65,25 @@ static bool ticker_match_cen_op_cb(uint8_t ticker_id, uint32_t ticks_slot,
 				   uint32_t ticks_to_expire, void *op_context);
 #endif /* CONFIG_BT_CENTRAL */
 
+#if defined(CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED)
+#if defined(CONFIG_BT_CTLR_CENTRAL_ISO)
+#define CEN_SLOTS_MAX ((TICKER_ID_CONN_LAST - TICKER_ID_CONN_BASE + 1U) + \
+		       (TICKER_ID_CONN_ISO_LAST - TICKER_ID_CONN_ISO_BASE + 1U))
+#else /* !CONFIG_BT_CTLR_CENTRAL_ISO */
+#define CEN_SLOTS_MAX (TICKER_ID_CONN_LAST - TICKER_ID_CONN_BASE + 1U)
+#endif /* !CONFIG_BT_CTLR_CENTRAL_ISO */
+
+static uint8_t cen_slots_get(uint8_t user_id, uint32_t *ticks_anchor,
+			     struct ull_sched_cen_slot *slots,
+			     uint8_t slots_max);
+static int cen_packed_offset_get(uint8_t user_id, uint16_t conn_interval,
+				 uint32_t ticks_slot, uint32_t *ticks_anchor,
+				 uint32_t *win_offset_us);
+static bool ticker_match_cen_any_op_cb(uint8_t ticker_id, uint32_t ticks_slot,
+				       uint32_t ticks_to_expire,
+				       void *op_context);
+#endif /* CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED */
+
 typedef struct ull_hdr *(*ull_hdr_get_func)(uint8_t ticker_id,
 					    uint32_t *ticks_slot);
 static uint8_t after_match_slot_get(uint8_t user_id, uint32_t ticks_slot_abs,
@@ -264,11 +284,24 @@ static void after_cen_offset_get(uint16_t conn_interval, uint32_t ticks_slot,
 	uint32_t ticks_anchor_offset = ticks_anchor;
 	int err;
 
-	err = ull_sched_after_cen_slot_get(TICKER_USER_ID_ULL_LOW, ticks_slot,
-					   &ticks_anchor_offset,
-					   win_offset_us);
+	err = -ENOTSUP;
+
+#if defined(CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED)
+	err = cen_packed_offset_get(TICKER_USER_ID_ULL_LOW, conn_interval,
+				    ticks_slot, &ticks_anchor_offset,
+				    win_offset_us);
+#endif /* CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED */
+
 	if (err) {
-		return;
+		ticks_anchor_offset = ticks_anchor;
+
+		err = ull_sched_after_cen_slot_get(TICKER_USER_ID_ULL_LOW,
+						   ticks_slot,
+						   &ticks_anchor_offset,
+						   win_offset_us);
+		if (err) {
+			return;
+		}
 	}
 
 	if ((ticks_anchor_offset - ticks_anchor) & BIT(HAL_TICKER_CNTR_MSBIT)) {
@@ -296,6 +329,194 @@ static void after_cen_offset_get(uint16_t conn_interval, uint32_t ticks_slot,
 	}
 }
 #endif /* CONFIG_BT_CENTRAL */
+
+#if defined(CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED)
+static uint8_t cen_slots_get(uint8_t user_id, uint32_t *ticks_anchor,
+			     struct ull_sched_cen_slot *slots,
+			     uint8_t slots_max)
+{
+	uint32_t ticks_anchor_prev;
+	uint32_t ticks_to_expire;
+#if defined(CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH)
+	uint32_t remainder;
+#endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+	uint8_t ticker_id;
+	uint8_t count;
+	uint8_t retry;
+
+	/* Restart iterations if tickers expire while iterating, refer to
+	 * after_match_slot_get() for the retry count rationale.
+	 */
+	retry = 4U;
+
+	/* Initialize variables required for iterations, ticks_to_expire and
+	 * remainder accumulate across the ticker nodes iterated.
+	 */
+	ticker_id = TICKER_NULL;
+	ticks_to_expire = 0U;
+#if defined(CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH)
+	remainder = 0U;
+#endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+	count = 0U;
+	while (1) {
+		uint32_t volatile ret_cb;
+		uint32_t interval_us;
+		uint32_t ticks_slot;
+		struct ull_hdr *hdr;
+		bool iterating;
+		uint32_t ret;
+		bool success;
+
+		iterating = (ticker_id != TICKER_NULL);
+		ticks_anchor_prev = *ticks_anchor;
+
+		ret_cb = TICKER_STATUS_BUSY;
+#if defined(CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH)
+		ret = ticker_next_slot_get_ext(TICKER_INSTANCE_ID_CTLR, user_id,
+					       &ticker_id, ticks_anchor,
+					       &ticks_to_expire, &remainder,
+					       NULL, /* lazy */
+					       ticker_match_cen_any_op_cb,
+					       NULL, /* match_op_context */
+					       ticker_op_cb, (void *)&ret_cb);
+#else /* !CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+		ret = ticker_next_slot_get(TICKER_INSTANCE_ID_CTLR, user_id,
+					   &ticker_id, ticks_anchor,
+					   &ticks_to_expire,
+					   ticker_op_cb, (void *)&ret_cb);
+#endif /* !CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+		if (ret == TICKER_STATUS_BUSY) {
+			while (ret_cb == TICKER_STATUS_BUSY) {
+				ticker_job_sched(TICKER_INSTANCE_ID_CTLR,
+						 user_id);
+			}
+		}
+
+		success = (ret_cb == TICKER_STATUS_SUCCESS);
+		LL_ASSERT(success);
+
+		if (iterating && (*ticks_anchor != ticks_anchor_prev)) {
+			LL_ASSERT(retry);
+			retry--;
+
+			ticker_id = TICKER_NULL;
+			ticks_to_expire = 0U;
+#if defined(CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH)
+			remainder = 0U;
+#endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+			count = 0U;
+
+			continue;
+		}
+
+		if ((ticker_id == TICKER_NULL) || (count >= slots_max)) {
+			break;
+		}
+
+#if !defined(CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH)
+		if (!ticker_match_cen_any_op_cb(ticker_id, 0, 0, NULL)) {
+			continue;
+		}
+#endif /* CONFIG_BT_TICKER_NEXT_SLOT_GET_MATCH */
+
+		hdr = ull_hdr_get_cb(ticker_id, &ticks_slot);
+		if (!hdr) {
+			continue;
+		}
+
+		if (IN_RANGE(ticker_id, TICKER_ID_CONN_BASE,
+			     TICKER_ID_CONN_LAST)) {
+			const struct ll_conn *conn;
+
+			conn = CONTAINER_OF(hdr, struct ll_conn, ull);
+			interval_us = conn->lll.interval * CONN_INT_UNIT_US;
+
+#if defined(CONFIG_BT_CTLR_CENTRAL_ISO)
+		} else if (IN_RANGE(ticker_id, TICKER_ID_CONN_ISO_BASE,
+				    TICKER_ID_CONN_ISO_LAST)) {
+			const struct ll_conn_iso_group *cig;
+
+			cig = CONTAINER_OF(hdr, struct ll_conn_iso_group, ull);
+			interval_us = cig->iso_interval * ISO_INT_UNIT_US;
+#endif /* CONFIG_BT_CTLR_CENTRAL_ISO */
+
+		} else {
+			continue;
+		}
+
+		if (!interval_us) {
+			continue;
+		}
+
+		if (IS_ENABLED(CONFIG_BT_CTLR_LOW_LAT)) {
+			ticks_slot += MAX(hdr->ticks_active_to_start,
+					  hdr->ticks_prepare_to_start);
+		}
+
+		slots[count].offset_us = HAL_TICKER_TICKS_TO_US(ticks_to_expire);
+		slots[count].slot_us = HAL_TICKER_TICKS_TO_US(ticks_slot) +
+				       (EVENT_TICKER_RES_MARGIN_US << 1);
+		slots[count].interval_us = interval_us;
+		slots[count].ticker_id = ticker_id;
+		count++;
+	}
+
+	return count;
+}
+
+static int cen_packed_offset_get(uint8_t user_id, uint16_t conn_interval,
+				 uint32_t ticks_slot, uint32_t *ticks_anchor,
+				 uint32_t *win_offset_us)
+{
+	struct ull_sched_cen_slot slots[CEN_SLOTS_MAX];
+	uint32_t slot_us;
+	uint8_t count;
+
+	count = cen_slots_get(user_id, ticks_anchor, slots, ARRAY_SIZE(slots));
+	slot_us = HAL_TICKER_TICKS_TO_US(ticks_slot) +
+		  (EVENT_TICKER_RES_MARGIN_US << 1);
+
+	return ull_sched_cen_packed_offset_calc(slots, count,
+						conn_interval *
+						CONN_INT_UNIT_US,
+						slot_us, win_offset_us);
+}
+
+int ull_sched_cen_slot_budget_get(uint16_t handle, uint32_t *budget_us)
+{
+	struct ull_sched_cen_slot slots[CEN_SLOTS_MAX];
+	uint32_t ticks_anchor;
+	uint32_t budget;
+	uint8_t count;
+	int err;
+
+	if (handle > (TICKER_ID_CONN_LAST - TICKER_ID_CONN_BASE)) {
+		return -EINVAL;
+	}
+
+	ticks_anchor = 0U;
+	count = cen_slots_get(TICKER_USER_ID_THREAD, &ticks_anchor, slots,
+			      ARRAY_SIZE(slots));
+
+	err = ull_sched_cen_slot_budget_calc(slots, count,
+					     TICKER_ID_CONN_BASE + handle,
+					     &budget);
+	if (err) {
+		return err;
+	}
+
+	/* Exclude the jitter margin included in the reservation */
+	if (budget > (EVENT_TICKER_RES_MARGIN_US << 1)) {
+		budget -= (EVENT_TICKER_RES_MARGIN_US << 1);
+	} else {
+		budget = 0U;
+	}
+
+	*budget_us = budget;
+
+	return 0;
+}
+#endif /* CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED */
 #endif /* CONFIG_BT_CONN */
 
 #if (defined(CONFIG_BT_CTLR_ADV_EXT) && defined(CONFIG_BT_BROADCASTER)) || \
@@ -621,6 +842,25 @@ static bool ticker_match_cen_op_cb(uint8_t ticker_id, uint32_t ticks_slot,
 }
 #endif /* CONFIG_BT_CENTRAL */
 
+#if defined(CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED)
+static bool ticker_match_cen_any_op_cb(uint8_t ticker_id, uint32_t ticks_slot,
+				       uint32_t ticks_to_expire,
+				       void *op_context)
+{
+	ARG_UNUSED(ticks_slot);
+	ARG_UNUSED(ticks_to_expire);
+	ARG_UNUSED(op_context);
+
+	return IN_RANGE(ticker_id, TICKER_ID_CONN_BASE,
+			TICKER_ID_CONN_LAST) ||
+#if defined(CONFIG_BT_CTLR_CENTRAL_ISO)
+	       IN_RANGE(ticker_id, TICKER_ID_CONN_ISO_BASE,
+			TICKER_ID_CONN_ISO_LAST) ||
+#endif /* CONFIG_BT_CTLR_CENTRAL_ISO */
+	       false;
+}
+#endif /* CONFIG_BT_CTLR_SCHED_CENTRAL_PACKED */
+
 static struct ull_hdr *ull_hdr_get_cb(uint8_t ticker_id, uint32_t *ticks_slot)
 {
 	if (false) {
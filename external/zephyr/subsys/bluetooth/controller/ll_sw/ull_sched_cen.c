@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include <zephyr/sys/util.h>
+
+#include "ull_sched_internal.h"
+
+static bool interval_harmonic(uint32_t interval_a_us, uint32_t interval_b_us);
+static bool slot_overlap(uint32_t offset_a_us, uint32_t slot_a_us,
+			 uint32_t offset_b_us, uint32_t slot_b_us,
+			 uint32_t period_us);
+
+int ull_sched_cen_packed_offset_calc(const struct ull_sched_cen_slot *slots,
+				     uint8_t count, uint32_t interval_us,
+				     uint32_t slot_us, uint32_t *offset_us)
+{
+	uint32_t period_us;
+	uint32_t offset;
+	bool found;
+
+	if (!count) {
+		return -ECHILD;
+	}
+
+	if (slot_us >= interval_us) {
+		return -ENOSPC;
+	}
+
+	/* With harmonic intervals, the relative position of the new event to
+	 * each active role's event repeats with the smaller of the two
+	 * intervals, hence all distinct candidate anchor points are found
+	 * within the largest such period.
+	 */
+	period_us = 0U;
+	for (uint8_t i = 0U; i < count; i++) {
+		if (!interval_harmonic(interval_us, slots[i].interval_us)) {
+			return -ENOTSUP;
+		}
+
+		period_us = MAX(period_us,
+				MIN(interval_us, slots[i].interval_us));
+	}
+
+	/* Candidate anchor points are the end of each event occurrence of the
+	 * active roles, choose the earliest one not colliding with any of
+	 * them. This places the new event back-to-back with an existing one
+	 * and keeps the free radio time contiguous.
+	 */
+	found = false;
+	offset = 0U;
+	for (uint8_t i = 0U; i < count; i++) {
+		const uint32_t end_us = slots[i].offset_us + slots[i].slot_us;
+
+		for (uint32_t occ_us = 0U; occ_us < period_us;
+		     occ_us += slots[i].interval_us) {
+			const uint32_t candidate_us = (end_us + occ_us) %
+						      interval_us;
+			bool collision;
+
+			if (found && (candidate_us >= offset)) {
+				continue;
+			}
+
+			collision = false;
+			for (uint8_t j = 0U; j < count; j++) {
+				if (slot_overlap(candidate_us, slot_us,
+						 slots[j].offset_us,
+						 slots[j].slot_us,
+						 MIN(interval_us,
+						     slots[j].interval_us))) {
+					collision = true;
+
+					break;
+				}
+			}
+
+			if (!collision) {
+				offset = candidate_us;
+				found = true;
+			}
+		}
+	}
+
+	if (!found) {
+		return -ENOSPC;
+	}
+
+	*offset_us = offset;
+
+	return 0;
+}
+
+int ull_sched_cen_slot_budget_calc(const struct ull_sched_cen_slot *slots,
+				   uint8_t count, uint8_t ticker_id,
+				   uint32_t *budget_us)
+{
+	const struct ull_sched_cen_slot *own;
+	uint32_t budget;
+
+	own = NULL;
+	for (uint8_t i = 0U; i < count; i++) {
+		if (slots[i].ticker_id == ticker_id) {
+			own = &slots[i];
+
+			break;
+		}
+	}
+
+	if (!own) {
+		return -ENOENT;
+	}
+
+	budget = own->interval_us;
+	for (uint8_t i = 0U; i < count; i++) {
+		const struct ull_sched_cen_slot *other = &slots[i];
+		uint32_t period_us;
+		uint32_t gap_us;
+
+		if (other == own) {
+			continue;
+		}
+
+		/* Relative position of events with non-harmonic intervals
+		 * drifts, only the own reservation is guaranteed.
+		 */
+		if (!interval_harmonic(own->interval_us, other->interval_us)) {
+			budget = MIN(budget, own->slot_us);
+
+			continue;
+		}
+
+		/* Time from own anchor point to the start of the other role's
+		 * event, repeating with the smaller of the two intervals.
+		 */
+		period_us = MIN(own->interval_us, other->interval_us);
+		gap_us = ((other->offset_us % period_us) + period_us -
+			  (own->offset_us % period_us)) % period_us;
+
+		budget = MIN(budget, gap_us);
+	}
+
+	*budget_us = budget;
+
+	return 0;
+}
+
+static bool interval_harmonic(uint32_t interval_a_us, uint32_t interval_b_us)
+{
+	if (!interval_a_us || !interval_b_us) {
+		return false;
+	}
+
+	if (interval_a_us > interval_b_us) {
+		return (interval_a_us % interval_b_us) == 0U;
+	}
+
+	return (interval_b_us % interval_a_us) == 0U;
+}
+
+static bool slot_overlap(uint32_t offset_a_us, uint32_t slot_a_us,
+			 uint32_t offset_b_us, uint32_t slot_b_us,
+			 uint32_t period_us)
+{
+	uint32_t diff_us;
+
+	if ((slot_a_us >= period_us) || (slot_b_us >= period_us)) {
+		return true;
+	}
+
+	/* Distance from start of event a to start of event b, modulo period */
+	diff_us = ((offset_b_us % period_us) + period_us -
+		   (offset_a_us % period_us)) % period_us;
+
+	/* Either b starts inside a, or a starts inside b */
+	return (diff_us < slot_a_us) || ((period_us - diff_us) < slot_b_us);
+}
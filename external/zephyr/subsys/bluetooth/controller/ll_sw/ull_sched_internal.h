@@ -4,6 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+/* Next radio event of an active central ACL or CIG role, in microseconds
+ * relative to the ticks_anchor used when taking the snapshot.
+ */
+struct ull_sched_cen_slot {
+	uint32_t offset_us;
+	uint32_t slot_us;
+	uint32_t interval_us;
+	uint8_t  ticker_id;
+};
+
 int ull_sched_adv_aux_sync_free_anchor_get(uint32_t ticks_slot_abs,
 					   uint32_t *ticks_anchor);
 int ull_sched_conn_iso_free_offset_get(uint32_t ticks_slot_abs,
@@ -13,3 +23,10 @@ int ull_sched_after_cen_slot_get(uint8_t user_id, uint32_t ticks_slot_abs,
 void ull_sched_mfy_win_offset_use(void *param);
 void ull_sched_mfy_free_win_offset_calc(void *param);
 void ull_sched_mfy_win_offset_select(void *param);
+int ull_sched_cen_packed_offset_calc(const struct ull_sched_cen_slot *slots,
+				     uint8_t count, uint32_t interval_us,
+				     uint32_t slot_us, uint32_t *offset_us);
+int ull_sched_cen_slot_budget_calc(const struct ull_sched_cen_slot *slots,
+				   uint8_t count, uint8_t ticker_id,
+				   uint32_t *budget_us);
+int ull_sched_cen_slot_budget_get(uint16_t handle, uint32_t *budget_us);
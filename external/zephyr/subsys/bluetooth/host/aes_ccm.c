@@ -38,7 +38,7 @@ static inline void xor16(uint8_t *dst, const uint8_t *a, const uint8_t *b)
 }
 
 /* b field is assumed to have the nonce already present in bytes 1-13 */
-static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t aad_len,
+static int ccm_calculate_X0(const struct bt_aes_ctx *ctx, const uint8_t *aad, uint8_t aad_len,
 			    size_t mic_size, uint16_t msg_len, uint8_t b[16],
 			    uint8_t X0[16])
 {
@@ -49,7 +49,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 
 	sys_put_be16(msg_len, b + 14);
 
-	err = bt_encrypt_be(key, b, X0);
+	err = bt_aes_ctx_encrypt_be(ctx, b, X0);
 	if (err) {
 		return err;
 	}
@@ -73,7 +73,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 			aad_len -= 16;
 			i = 0;
 
-			err = bt_encrypt_be(key, b, X0);
+			err = bt_aes_ctx_encrypt_be(ctx, b, X0);
 			if (err) {
 				return err;
 			}
@@ -87,7 +87,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 			b[i] = X0[i];
 		}
 
-		err = bt_encrypt_be(key, b, X0);
+		err = bt_aes_ctx_encrypt_be(ctx, b, X0);
 		if (err) {
 			return err;
 		}
@@ -96,7 +96,7 @@ static int ccm_calculate_X0(const uint8_t key[16], const uint8_t *aad, uint8_t a
 	return 0;
 }
 
-static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
+static int ccm_auth(const struct bt_aes_ctx *ctx, uint8_t nonce[13],
 		    const uint8_t *cleartext_msg, uint16_t msg_len, const uint8_t *aad,
 		    size_t aad_len, uint8_t *mic, size_t mic_size)
 {
@@ -116,12 +116,15 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 	/* S[0] = e(AppKey, 0x01 || nonce || 0x0000) */
 	sys_put_be16(0x0000, &b[14]);
 
-	err = bt_encrypt_be(key, b, s0);
+	err = bt_aes_ctx_encrypt_be(ctx, b, s0);
 	if (err) {
 		return err;
 	}
 
-	ccm_calculate_X0(key, aad, aad_len, mic_size, msg_len, b, Xn);
+	err = ccm_calculate_X0(ctx, aad, aad_len, mic_size, msg_len, b, Xn);
+	if (err) {
+		return err;
+	}
 
 	for (j = 0; j < blk_cnt; j++) {
 		/* X_1 = e(AppKey, X_0 ^ Payload[0-15]) */
@@ -135,7 +138,7 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 			xor16(b, Xn, &cleartext_msg[j * 16]);
 		}
 
-		err = bt_encrypt_be(key, b, Xn);
+		err = bt_aes_ctx_encrypt_be(ctx, b, Xn);
 		if (err) {
 			return err;
 		}
@@ -149,7 +152,7 @@ static int ccm_auth(const uint8_t key[16], uint8_t nonce[13],
 	return 0;
 }
 
-static int ccm_crypt(const uint8_t key[16], const uint8_t nonce[13],
+static int ccm_crypt(const struct bt_aes_ctx *ctx, const uint8_t nonce[13],
 		     const uint8_t *in_msg, uint8_t *out_msg, uint16_t msg_len)
 {
 	uint8_t a_i[16], s_i[16];
@@ -170,7 +173,7 @@ static int ccm_crypt(const uint8_t key[16], const uint8_t nonce[13],
 		/* S_1 = e(AppKey, 0x01 || nonce || 0x0001) */
 		sys_put_be16(j + 1, &a_i[14]);
 
-		err = bt_encrypt_be(key, a_i, s_i);
+		err = bt_aes_ctx_encrypt_be(ctx, a_i, s_i);
 		if (err) {
 			return err;
 		}
@@ -192,15 +195,30 @@ int bt_ccm_decrypt(const uint8_t key[16], uint8_t nonce[13],
 		   const uint8_t *enc_data, size_t len, const uint8_t *aad,
 		   size_t aad_len, uint8_t *plaintext, size_t mic_size)
 {
+	struct bt_aes_ctx ctx;
 	uint8_t mic[16];
+	int err;
 
 	if (aad_len >= 0xff00 || mic_size > sizeof(mic) || len > UINT16_MAX) {
 		return -EINVAL;
 	}
 
-	ccm_crypt(key, nonce, enc_data, plaintext, len);
+	/* Expand the key once for all the blocks of the message */
+	err = bt_aes_ctx_init(&ctx, key);
+	if (err) {
+		return err;
+	}
+
+	err = ccm_crypt(&ctx, nonce, enc_data, plaintext, len);
+	if (!err) {
+		err = ccm_auth(&ctx, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	}
+
+	bt_aes_ctx_clear(&ctx);
 
-	ccm_auth(key, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	if (err) {
+		return err;
+	}
 
 	if (memcmp(mic, enc_data + len, mic_size)) {
 		return -EBADMSG;
@@ -214,6 +232,8 @@ int bt_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
 		   size_t aad_len, uint8_t *enc_data, size_t mic_size)
 {
 	uint8_t *mic = enc_data + len;
+	struct bt_aes_ctx ctx;
+	int err;
 
 	LOG_DBG("key %s", bt_hex(key, 16));
 	LOG_DBG("nonce %s", bt_hex(nonce, 13));
@@ -225,9 +245,17 @@ int bt_ccm_encrypt(const uint8_t key[16], uint8_t nonce[13],
 		return -EINVAL;
 	}
 
-	ccm_auth(key, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	err = bt_aes_ctx_init(&ctx, key);
+	if (err) {
+		return err;
+	}
+
+	err = ccm_auth(&ctx, nonce, plaintext, len, aad, aad_len, mic, mic_size);
+	if (!err) {
+		err = ccm_crypt(&ctx, nonce, plaintext, enc_data, len);
+	}
 
-	ccm_crypt(key, nonce, plaintext, enc_data, len);
+	bt_aes_ctx_clear(&ctx);
 
-	return 0;
+	return err;
 }
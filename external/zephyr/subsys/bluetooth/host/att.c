@@ -20,6 +20,7 @@
 #include <zephyr/bluetooth/att.h>
 #include <zephyr/bluetooth/gatt.h>
 #include <zephyr/drivers/bluetooth/hci_driver.h>
+#include <zephyr/tracing/trace_ring.h>
 
 #include "common/bt_str.h"
 
@@ -296,6 +297,11 @@ static int chan_send(struct bt_att_chan *chan, struct net_buf *buf)
 	data->opcode = buf->data[0];
 	data->err = 0;
 
+	if (IS_ENABLED(CONFIG_BT_TRACE_RING)) {
+		trace_ring_record(TRACE_RING_EVT_BT_ATT_TX, chan->att->conn->handle,
+				  hdr->code, buf->len);
+	}
+
 	if (IS_ENABLED(CONFIG_BT_EATT) && bt_att_is_enhanced(chan)) {
 		/* Check if sent is pending already, if it does it cannot be
 		 * modified so the operation will need to be queued.
@@ -2869,6 +2875,11 @@ static int bt_att_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	LOG_DBG("Received ATT chan %p code 0x%02x len %zu", att_chan, hdr->code,
 		net_buf_frags_len(buf));
 
+	if (IS_ENABLED(CONFIG_BT_TRACE_RING)) {
+		trace_ring_record(TRACE_RING_EVT_BT_ATT_RX, conn->handle, hdr->code,
+				  buf->len);
+	}
+
 	if (conn->state != BT_CONN_CONNECTED) {
 		LOG_DBG("not connected: conn %p state %u", conn, conn->state);
 		return 0;
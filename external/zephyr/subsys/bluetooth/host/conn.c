@@ -26,6 +26,7 @@
 #include <zephyr/bluetooth/conn.h>
 #include <zephyr/drivers/bluetooth/hci_driver.h>
 #include <zephyr/bluetooth/att.h>
+#include <zephyr/tracing/trace_ring.h>
 
 #include "common/assert.h"
 #include "common/bt_str.h"
@@ -1049,6 +1050,11 @@ void bt_conn_set_state(struct bt_conn *conn, bt_conn_state_t state)
 	old_state = conn->state;
 	conn->state = state;
 
+	if (IS_ENABLED(CONFIG_BT_TRACE_RING)) {
+		trace_ring_record(TRACE_RING_EVT_BT_CONN_STATE, conn->handle, old_state,
+				  state);
+	}
+
 	/* Actions needed for exiting the old state */
 	switch (old_state) {
 	case BT_CONN_DISCONNECTED:
@@ -24,6 +24,7 @@
 
 #include "common/bt_str.h"
 
+#include "crypto.h"
 #include "hci_core.h"
 
 #define LOG_LEVEL CONFIG_BT_HCI_CORE_LOG_LEVEL
@@ -111,6 +112,104 @@ int bt_rand(void *buf, size_t len)
 }
 #endif /* CONFIG_BT_HOST_CRYPTO_PRNG */
 
+BUILD_ASSERT(sizeof(((struct bt_aes_ctx *)0)->sched) == sizeof(struct tc_aes_key_sched_struct),
+	     "Mismatch between bt_aes_ctx and TinyCrypt key schedule");
+
+#if CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE > 0
+struct key_cache_entry {
+	uint8_t key[16];
+	struct tc_aes_key_sched_struct sched;
+	/* Cache clock value of the last use, 0 for a free entry */
+	uint32_t used;
+};
+
+static struct key_cache_entry key_cache[CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE];
+static uint32_t key_cache_clock;
+
+static bool key_cache_get(const uint8_t key[16], struct tc_aes_key_sched_struct *s)
+{
+	unsigned int irq_key;
+	bool found = false;
+
+	irq_key = irq_lock();
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		struct key_cache_entry *entry = &key_cache[i];
+
+		if (entry->used && !memcmp(entry->key, key, 16)) {
+			entry->used = ++key_cache_clock;
+			*s = entry->sched;
+			found = true;
+			break;
+		}
+	}
+
+	irq_unlock(irq_key);
+
+	return found;
+}
+
+static void key_cache_add(const uint8_t key[16], const struct tc_aes_key_sched_struct *s)
+{
+	struct key_cache_entry *lru = &key_cache[0];
+	unsigned int irq_key;
+
+	irq_key = irq_lock();
+
+	/* Free entries have the lowest clock value and are picked first */
+	for (size_t i = 1; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].used < lru->used) {
+			lru = &key_cache[i];
+		}
+	}
+
+	memcpy(lru->key, key, 16);
+	lru->sched = *s;
+	lru->used = ++key_cache_clock;
+
+	irq_unlock(irq_key);
+}
+
+void bt_crypto_key_cache_clear(void)
+{
+	unsigned int irq_key;
+
+	irq_key = irq_lock();
+	(void)memset(key_cache, 0, sizeof(key_cache));
+	key_cache_clock = 0U;
+	irq_unlock(irq_key);
+}
+#else /* CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE == 0 */
+static bool key_cache_get(const uint8_t key[16], struct tc_aes_key_sched_struct *s)
+{
+	return false;
+}
+
+static void key_cache_add(const uint8_t key[16], const struct tc_aes_key_sched_struct *s)
+{
+}
+
+void bt_crypto_key_cache_clear(void)
+{
+}
+#endif /* CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE > 0 */
+
+/* Expand a big-endian key, reusing a cached schedule when available. */
+static int key_sched_get(const uint8_t key[16], struct tc_aes_key_sched_struct *s)
+{
+	if (key_cache_get(key, s)) {
+		return 0;
+	}
+
+	if (tc_aes128_set_encrypt_key(s, key) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	key_cache_add(key, s);
+
+	return 0;
+}
+
 int bt_encrypt_le(const uint8_t key[16], const uint8_t plaintext[16],
 		  uint8_t enc_data[16])
 {
@@ -126,7 +225,7 @@ int bt_encrypt_le(const uint8_t key[16], const uint8_t plaintext[16],
 
 	sys_memcpy_swap(tmp, key, 16);
 
-	if (tc_aes128_set_encrypt_key(&s, tmp) == TC_CRYPTO_FAIL) {
+	if (key_sched_get(tmp, &s)) {
 		return -EINVAL;
 	}
 
@@ -155,7 +254,7 @@ int bt_encrypt_be(const uint8_t key[16], const uint8_t plaintext[16],
 	LOG_DBG("key %s", bt_hex(key, 16));
 	LOG_DBG("plaintext %s", bt_hex(plaintext, 16));
 
-	if (tc_aes128_set_encrypt_key(&s, key) == TC_CRYPTO_FAIL) {
+	if (key_sched_get(key, &s)) {
 		return -EINVAL;
 	}
 
@@ -168,6 +267,39 @@ int bt_encrypt_be(const uint8_t key[16], const uint8_t plaintext[16],
 	return 0;
 }
 
+int bt_aes_ctx_init(struct bt_aes_ctx *ctx, const uint8_t key[16])
+{
+	CHECKIF(ctx == NULL || key == NULL) {
+		return -EINVAL;
+	}
+
+	if (tc_aes128_set_encrypt_key((TCAesKeySched_t)ctx->sched, key) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int bt_aes_ctx_encrypt_be(const struct bt_aes_ctx *ctx, const uint8_t plaintext[16],
+			  uint8_t enc_data[16])
+{
+	CHECKIF(ctx == NULL || plaintext == NULL || enc_data == NULL) {
+		return -EINVAL;
+	}
+
+	if (tc_aes_encrypt(enc_data, plaintext,
+			   (const TCAesKeySched_t)ctx->sched) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+void bt_aes_ctx_clear(struct bt_aes_ctx *ctx)
+{
+	(void)memset(ctx, 0, sizeof(*ctx));
+}
+
 #ifdef ZTEST_UNITTEST
 struct tc_hmac_prng_struct *bt_crypto_get_hmac_prng_instance(void)
 {
@@ -6,3 +6,6 @@
  */
 
 int prng_init(void);
+
+/* Drop the expanded keys cached by bt_encrypt_le() and bt_encrypt_be(). */
+void bt_crypto_key_cache_clear(void);
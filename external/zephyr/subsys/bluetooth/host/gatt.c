@@ -5754,6 +5754,11 @@ void bt_gatt_connected(struct bt_conn *conn)
 		}
 
 		settings_load_subtree_direct(key, ccc_set_direct, (void *)key);
+
+		if (IS_ENABLED(CONFIG_BT_SETTINGS_WRITE_BEHIND)) {
+			/* Values not written yet are newer than the stored ones */
+			bt_settings_load_pending(key, ccc_set_direct, (void *)key);
+		}
 	}
 
 	bt_gatt_foreach_attr(0x0001, 0xffff, update_ccc, &data);
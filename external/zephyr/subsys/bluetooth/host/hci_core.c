@@ -28,6 +28,7 @@
 #include <zephyr/bluetooth/hci.h>
 #include <zephyr/bluetooth/hci_vs.h>
 #include <zephyr/drivers/bluetooth/hci_driver.h>
+#include <zephyr/tracing/trace_ring.h>
 
 #include "common/bt_str.h"
 #include "common/assert.h"
@@ -3773,11 +3774,20 @@ static int hci_init(void)
 	return 0;
 }
 
+static void trace_hci(uint16_t id, struct net_buf *buf)
+{
+	if (IS_ENABLED(CONFIG_BT_TRACE_RING)) {
+		trace_ring_record(id, bt_buf_get_type(buf), buf->len,
+				  buf->len >= sizeof(uint16_t) ? sys_get_le16(buf->data) : 0);
+	}
+}
+
 int bt_send(struct net_buf *buf)
 {
 	LOG_DBG("buf %p len %u type %u", buf, buf->len, bt_buf_get_type(buf));
 
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
+	trace_hci(TRACE_RING_EVT_BT_HCI_TX, buf);
 
 	if (IS_ENABLED(CONFIG_BT_TINYCRYPT_ECC)) {
 		return bt_hci_ecc_send(buf);
@@ -3833,10 +3843,8 @@ void hci_event_prio(struct net_buf *buf)
 }
 
 #if !defined(CONFIG_BT_RECV_BLOCKING)
-static void rx_queue_put(struct net_buf *buf)
+static void rx_work_submit(void)
 {
-	net_buf_slist_put(&bt_dev.rx_queue, buf);
-
 #if defined(CONFIG_BT_RECV_WORKQ_SYS)
 	const int err = k_work_submit(&rx_work);
 #elif defined(CONFIG_BT_RECV_WORKQ_BT)
@@ -3846,11 +3854,24 @@ static void rx_queue_put(struct net_buf *buf)
 		LOG_ERR("Could not submit rx_work: %d", err);
 	}
 }
+
+static void rx_queue_put(struct net_buf *buf, bool submit)
+{
+	net_buf_slist_put(&bt_dev.rx_queue, buf);
+
+	if (submit) {
+		rx_work_submit();
+	}
+}
 #endif /* !CONFIG_BT_RECV_BLOCKING */
 
-int bt_recv(struct net_buf *buf)
+/* Process or queue one buffer received from the HCI driver. Queued buffers are
+ * only handed to the RX work item if submit is true.
+ */
+static int recv_buf(struct net_buf *buf, bool submit)
 {
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
+	trace_hci(TRACE_RING_EVT_BT_HCI_RX, buf);
 
 	LOG_DBG("buf %p len %u", buf, buf->len);
 
@@ -3860,7 +3881,7 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_BLOCKING)
 		hci_acl(buf);
 #else
-		rx_queue_put(buf);
+		rx_queue_put(buf, submit);
 #endif
 		return 0;
 #endif /* BT_CONN */
@@ -3877,7 +3898,7 @@ int bt_recv(struct net_buf *buf)
 		}
 
 		if (evt_flags & BT_HCI_EVT_FLAG_RECV) {
-			rx_queue_put(buf);
+			rx_queue_put(buf, submit);
 		}
 #endif
 		return 0;
@@ -3888,7 +3909,7 @@ int bt_recv(struct net_buf *buf)
 #if defined(CONFIG_BT_RECV_BLOCKING)
 		hci_iso(buf);
 #else
-		rx_queue_put(buf);
+		rx_queue_put(buf, submit);
 #endif
 		return 0;
 #endif /* CONFIG_BT_ISO */
@@ -3899,9 +3920,38 @@ int bt_recv(struct net_buf *buf)
 	}
 }
 
+int bt_recv(struct net_buf *buf)
+{
+	return recv_buf(buf, true);
+}
+
+int bt_recv_burst(struct net_buf **bufs, size_t count)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		int err;
+
+		err = recv_buf(bufs[i], false);
+		if (err && !ret) {
+			ret = err;
+		}
+	}
+
+#if !defined(CONFIG_BT_RECV_BLOCKING)
+	/* One RX work submission for the whole burst */
+	if (!sys_slist_is_empty(&bt_dev.rx_queue)) {
+		rx_work_submit();
+	}
+#endif /* !CONFIG_BT_RECV_BLOCKING */
+
+	return ret;
+}
+
 int bt_recv_prio(struct net_buf *buf)
 {
 	bt_monitor_send(bt_monitor_opcode(buf), buf->data, buf->len);
+	trace_hci(TRACE_RING_EVT_BT_HCI_RX, buf);
 
 	BT_ASSERT(bt_buf_get_type(buf) == BT_BUF_EVT);
 
@@ -3990,36 +4040,40 @@ static void init_work(struct k_work *work)
 #if !defined(CONFIG_BT_RECV_BLOCKING)
 static void rx_work_handler(struct k_work *work)
 {
-	int err;
-
 	struct net_buf *buf;
 
-	LOG_DBG("Getting net_buf from queue");
-	buf = net_buf_slist_get(&bt_dev.rx_queue);
-	if (!buf) {
-		return;
-	}
+	/* Process at most CONFIG_BT_RECV_BURST_MAX buffers per execution so
+	 * that bursts delivered by bt_recv_burst() share one work item
+	 * execution.
+	 */
+	for (uint8_t i = 0U; i < CONFIG_BT_RECV_BURST_MAX; i++) {
+		LOG_DBG("Getting net_buf from queue");
+		buf = net_buf_slist_get(&bt_dev.rx_queue);
+		if (!buf) {
+			return;
+		}
 
-	LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
+		LOG_DBG("buf %p type %u len %u", buf, bt_buf_get_type(buf), buf->len);
 
-	switch (bt_buf_get_type(buf)) {
+		switch (bt_buf_get_type(buf)) {
 #if defined(CONFIG_BT_CONN)
-	case BT_BUF_ACL_IN:
-		hci_acl(buf);
-		break;
+		case BT_BUF_ACL_IN:
+			hci_acl(buf);
+			break;
 #endif /* CONFIG_BT_CONN */
 #if defined(CONFIG_BT_ISO)
-	case BT_BUF_ISO_IN:
-		hci_iso(buf);
-		break;
+		case BT_BUF_ISO_IN:
+			hci_iso(buf);
+			break;
 #endif /* CONFIG_BT_ISO */
-	case BT_BUF_EVT:
-		hci_event(buf);
-		break;
-	default:
-		LOG_ERR("Unknown buf type %u", bt_buf_get_type(buf));
-		net_buf_unref(buf);
-		break;
+		case BT_BUF_EVT:
+			hci_event(buf);
+			break;
+		default:
+			LOG_ERR("Unknown buf type %u", bt_buf_get_type(buf));
+			net_buf_unref(buf);
+			break;
+		}
 	}
 
 	/* Schedule the work handler to be executed again if there are
@@ -4028,15 +4082,7 @@ static void rx_work_handler(struct k_work *work)
 	 * we used a while() loop with a k_yield() statement.
 	 */
 	if (!sys_slist_is_empty(&bt_dev.rx_queue)) {
-
-#if defined(CONFIG_BT_RECV_WORKQ_SYS)
-		err = k_work_submit(&rx_work);
-#elif defined(CONFIG_BT_RECV_WORKQ_BT)
-		err = k_work_submit_to_queue(&bt_workq, &rx_work);
-#endif
-		if (err < 0) {
-			LOG_ERR("Could not submit rx_work: %d", err);
-		}
+		rx_work_submit();
 	}
 }
 #endif /* !CONFIG_BT_RECV_BLOCKING */
@@ -4186,6 +4232,14 @@ int bt_disable(void)
 
 	bt_monitor_send(BT_MONITOR_CLOSE_INDEX, NULL, 0);
 
+	if (IS_ENABLED(CONFIG_BT_SETTINGS_WRITE_BEHIND)) {
+		/* Do not leave values stored by the stack only in RAM */
+		err = bt_settings_flush();
+		if (err) {
+			LOG_ERR("Failed to write settings (err %d)", err);
+		}
+	}
+
 	/* Clear BT_DEV_ENABLE here to prevent early bt_enable() calls, before disable is
 	 * completed.
 	 */
@@ -13,10 +13,12 @@
 #include <zephyr/sys/atomic.h>
 #include <zephyr/debug/stack.h>
 #include <zephyr/sys/byteorder.h>
+#if defined(CONFIG_BT_ECC_EMULATION_TINYCRYPT)
 #include <tinycrypt/constants.h>
 #include <tinycrypt/utils.h>
 #include <tinycrypt/ecc.h>
 #include <tinycrypt/ecc_dh.h>
+#endif
 
 #include <zephyr/bluetooth/bluetooth.h>
 #include <zephyr/bluetooth/conn.h>
@@ -27,6 +29,7 @@
 
 #include "hci_ecc.h"
 #include "ecc.h"
+#include "p256.h"
 
 #ifdef CONFIG_BT_HCI_RAW
 #include <zephyr/bluetooth/hci_raw.h>
@@ -99,14 +102,67 @@ static void send_cmd_status(uint16_t opcode, uint8_t status)
 	}
 }
 
-static uint8_t generate_keys(void)
+#if defined(CONFIG_BT_ECC_EMULATION_P256)
+static int make_key(void)
 {
+	int err;
+
 	do {
-		int rc;
+		err = bt_rand(ecc.private_key_be, BT_PRIV_KEY_LEN);
+		if (err) {
+			return err;
+		}
+
+		/* Draw again if the private key is out of [1, n - 1] */
+		err = bt_p256_public_key(ecc.private_key_be, ecc.public_key_be);
+	} while (err == -EINVAL);
+
+	return err;
+}
+
+static int shared_secret(const uint8_t *private_key_be)
+{
+	int err;
+
+	/* Validates the public key, and reads it before writing the DHKey */
+	err = bt_p256_dhkey(ecc.public_key_be, private_key_be, ecc.dhkey_be);
+	if (err) {
+		LOG_ERR("public key is not valid (err %d)", err);
+	}
+
+	return err;
+}
+#else
+static int make_key(void)
+{
+	int rc;
+
+	rc = uECC_make_key(ecc.public_key_be, ecc.private_key_be, &curve_secp256r1);
+
+	return rc == TC_CRYPTO_FAIL ? -EIO : 0;
+}
+
+static int shared_secret(const uint8_t *private_key_be)
+{
+	int ret;
+
+	ret = uECC_valid_public_key(ecc.public_key_be, &curve_secp256r1);
+	if (ret < 0) {
+		LOG_ERR("public key is not valid (ret %d)", ret);
+		return -EINVAL;
+	}
+
+	ret = uECC_shared_secret(ecc.public_key_be, private_key_be, ecc.dhkey_be,
+				 &curve_secp256r1);
+
+	return ret == TC_CRYPTO_FAIL ? -EIO : 0;
+}
+#endif /* CONFIG_BT_ECC_EMULATION_P256 */
 
-		rc = uECC_make_key(ecc.public_key_be, ecc.private_key_be,
-				   &curve_secp256r1);
-		if (rc == TC_CRYPTO_FAIL) {
+static uint8_t generate_keys(void)
+{
+	do {
+		if (make_key()) {
 			LOG_ERR("Failed to create ECC public/private pair");
 			return BT_HCI_ERR_UNSPECIFIED;
 		}
@@ -167,20 +223,11 @@ static void emulate_le_generate_dhkey(void)
 	struct bt_hci_evt_le_meta_event *meta;
 	struct bt_hci_evt_hdr *hdr;
 	struct net_buf *buf;
+	bool use_debug;
 	int ret;
 
-	ret = uECC_valid_public_key(ecc.public_key_be, &curve_secp256r1);
-	if (ret < 0) {
-		LOG_ERR("public key is not valid (ret %d)", ret);
-		ret = TC_CRYPTO_FAIL;
-	} else {
-		bool use_debug = atomic_test_bit(flags, USE_DEBUG_KEY);
-
-		ret = uECC_shared_secret(ecc.public_key_be,
-					 use_debug ? debug_private_key_be :
-						     ecc.private_key_be,
-					 ecc.dhkey_be, &curve_secp256r1);
-	}
+	use_debug = atomic_test_bit(flags, USE_DEBUG_KEY);
+	ret = shared_secret(use_debug ? debug_private_key_be : ecc.private_key_be);
 
 	buf = bt_buf_get_rx(BT_BUF_EVT, K_FOREVER);
 
@@ -193,7 +240,7 @@ static void emulate_le_generate_dhkey(void)
 
 	evt = net_buf_add(buf, sizeof(*evt));
 
-	if (ret == TC_CRYPTO_FAIL) {
+	if (ret) {
 		evt->status = BT_HCI_ERR_UNSPECIFIED;
 		(void)memset(evt->dhkey, 0xff, sizeof(evt->dhkey));
 	} else {
@@ -215,6 +215,22 @@ int bt_recv(struct net_buf *buf)
 	return 0;
 }
 
+int bt_recv_burst(struct net_buf **bufs, size_t count)
+{
+	int ret = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		int err;
+
+		err = bt_recv(bufs[i]);
+		if (err && !ret) {
+			ret = err;
+		}
+	}
+
+	return ret;
+}
+
 int bt_recv_prio(struct net_buf *buf)
 {
 	if (bt_buf_get_type(buf) == BT_BUF_EVT) {
@@ -24,6 +24,7 @@
 
 #include "common/rpa.h"
 #include "conn_internal.h"
+#include "crypto.h"
 #include "gatt_internal.h"
 #include "hci_core.h"
 #include "smp.h"
@@ -315,6 +316,11 @@ void bt_keys_clear(struct bt_keys *keys)
 		bt_settings_delete_keys(keys->id, &keys->addr);
 	}
 
+#if CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE > 0
+	/* Do not keep expanded copies of the keys being removed */
+	bt_crypto_key_cache_clear();
+#endif
+
 	(void)memset(keys, 0, sizeof(*keys));
 }
 
@@ -0,0 +1,830 @@
+/* p256.c - NIST P-256 key generation and ECDH */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "p256.h"
+
+/* Field elements and scalars are 8 little-endian 32-bit limbs. Field elements
+ * are always kept fully reduced modulo p, and reduction uses the special form
+ * of p (FIPS 186-4 D.2.3) instead of Montgomery multiplication.
+ *
+ * Points are kept in Jacobian coordinates (X / Z^2, Y / Z^3), the point at
+ * infinity having Z = 0.
+ */
+#define LIMBS 8
+
+typedef uint32_t fe_t[LIMBS];
+
+struct jpoint {
+	fe_t x;
+	fe_t y;
+	fe_t z;
+};
+
+struct apoint {
+	fe_t x;
+	fe_t y;
+};
+
+/* Fixed-base comb: COMB_W teeth spaced COMB_D bits apart cover the scalar,
+ * so the public key takes COMB_D - 1 doublings and COMB_D additions.
+ */
+#define COMB_W 5
+#define COMB_D 52
+
+/* Signed window: odd digits in [-(2^WIN_W - 1), 2^WIN_W - 1], so DH takes
+ * WIN_W doublings and one addition per digit.
+ */
+#define WIN_W 5
+#define WIN_SIZE (1 << (WIN_W - 1))
+#define WIN_DIGITS DIV_ROUND_UP(256, WIN_W)
+
+static const fe_t p256_p = {
+	0xffffffff, 0xffffffff, 0xffffffff, 0x00000000,
+	0x00000000, 0x00000000, 0x00000001, 0xffffffff,
+};
+
+static const fe_t p256_n = {
+	0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad,
+	0xffffffff, 0xffffffff, 0x00000000, 0xffffffff,
+};
+
+static const fe_t p256_b = {
+	0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0,
+	0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8,
+};
+
+static const fe_t fe_one = { 1 };
+
+/* comb_table[v - 1] = sum of 2^(COMB_D * j) * G for every bit j set in v */
+static const struct apoint comb_table[BIT(COMB_W) - 1] = {
+	{ { 0xd898c296, 0xf4a13945, 0x2deb33a0, 0x77037d81,
+	    0x63a440f2, 0xf8bce6e5, 0xe12c4247, 0x6b17d1f2 },
+	  { 0x37bf51f5, 0xcbb64068, 0x6b315ece, 0x2bce3357,
+	    0x7c0f9e16, 0x8ee7eb4a, 0xfe1a7f9b, 0x4fe342e2 } },
+	{ { 0x071e5c83, 0xeea6bc92, 0x8542a0be, 0x8bd27f19,
+	    0x2a58e5b1, 0x20a845b7, 0x5026d73f, 0x54ccc941 },
+	  { 0x140916a1, 0xcfd08ef7, 0x5d8ee496, 0x929e0bcc,
+	    0xdad2bf22, 0x3a8f8715, 0xb4514532, 0x1c433f45 } },
+	{ { 0x04bac870, 0xf7d24bb7, 0x3a23c6ab, 0x593a09a0,
+	    0xf94c9d1d, 0xdfcc2358, 0x297bed02, 0x3cfa0f87 },
+	  { 0x40f26940, 0xce98a30b, 0x0248a8af, 0x62121c0d,
+	    0x8309af9b, 0xa758aa80, 0x70be12c6, 0xe4e37694 } },
+	{ { 0x3ecca7e0, 0xc739a5ea, 0x6743333e, 0xa7d2c98f,
+	    0x224d9428, 0x0fef6335, 0x5c792a0c, 0x7ef2ee3c },
+	  { 0x552ac094, 0x302b22dd, 0xdfbd3d20, 0x81b21450,
+	    0xd5e609db, 0xa4f67f51, 0x30acc011, 0xafb68627 } },
+	{ { 0x86ef7d7d, 0xdd37e3ff, 0x088b86db, 0xf6d77c27,
+	    0x254c5491, 0x28fe9a4f, 0x6df0fd5e, 0xd6690337 },
+	  { 0xaddad596, 0x9ff04992, 0x9e4373f9, 0xf3d1a7af,
+	    0xdf074167, 0xa13e9578, 0xe6d13d22, 0x20e2a53c } },
+	{ { 0xb0879605, 0xd7b86aee, 0xbe3c7265, 0xa424ec2d,
+	    0x12f01e9e, 0x276203c2, 0xb77e46e9, 0xb666fac5 },
+	  { 0x3bf0c52d, 0xf431bb1a, 0x726cd8b6, 0xef46a44a,
+	    0xee3de5a9, 0xeb5abc19, 0x90246904, 0x38aaa380 } },
+	{ { 0x525d6abf, 0xaebfd735, 0x96bea25a, 0xc302f8f4,
+	    0x544920a4, 0xdb82b3ea, 0x02eadb2e, 0x621c75d1 },
+	  { 0x9ef485f0, 0x8939dc4c, 0x57c46d63, 0x225d03d8,
+	    0x522d7f70, 0x4fdac96f, 0xb4fa649d, 0xd7c4a4fe } },
+	{ { 0x943e832a, 0x9c762ef1, 0x1786df70, 0x07e50ab0,
+	    0x2589f18e, 0x90f573a8, 0xa7c2a51a, 0x0d2bf28b },
+	  { 0x5b20d37c, 0x48263af1, 0x60551446, 0x27ec9db9,
+	    0x94b4e7ed, 0x7087a10a, 0x13bd00ac, 0x0cac3f43 } },
+	{ { 0xc0b9372a, 0x8bc659aa, 0xedd9583f, 0xf7659958,
+	    0x8c267d88, 0x9f05f94a, 0xc99a739d, 0x00dc46e7 },
+	  { 0xdf55d0f2, 0x4af50a00, 0x8156bf6a, 0xb5eb202d,
+	    0x5228c111, 0x40d1e3ab, 0x45793424, 0x0312a557 } },
+	{ { 0x9e6486e0, 0x9d90cda8, 0x1c7522c0, 0xc8a820bd,
+	    0x08dcd7ab, 0x867c5580, 0x882a7892, 0x3c510ce2 },
+	  { 0x646d54c6, 0x0e283334, 0xeda4e046, 0x33392776,
+	    0x5ba997b0, 0xc3a7fc08, 0x5acf053f, 0xd35e620f } },
+	{ { 0x7eb8cfee, 0x8d9692f7, 0x0d8c013d, 0x05e3f223,
+	    0x84e32e59, 0x76347a52, 0x15b0a1e5, 0x3c53e290 },
+	  { 0xfae798d4, 0x538b7da5, 0x00d23591, 0x1b9f1bd1,
+	    0x9a08693f, 0x11a9f072, 0x140efeb3, 0xd30e7cda } },
+	{ { 0x4dd6c004, 0x81dec926, 0xdad210d5, 0xbfed14fe,
+	    0xb96b9911, 0x39f9ff69, 0x29c2024d, 0x02fd7b73 },
+	  { 0x715d29fc, 0x50cfceb8, 0x0c236311, 0xb682b999,
+	    0xc7797831, 0x00f34add, 0x59927df3, 0x42ebd3cb } },
+	{ { 0xf8e8f683, 0x6dfcf787, 0x3f7fbe90, 0x13d72b7a,
+	    0x2df232cf, 0xfd426d94, 0x5fe39aad, 0xed84bb42 },
+	  { 0x732995fc, 0x023e67a1, 0x355430e3, 0x67dd0a8e,
+	    0x97a1d703, 0x0cf83b61, 0x583c33f2, 0xa3233455 } },
+	{ { 0x68142904, 0x27014ab4, 0x00cfa617, 0xfb500882,
+	    0x7009b958, 0x6745ff87, 0xd449242d, 0x9e9889bc },
+	  { 0x575616c8, 0x035b613b, 0x138e99e2, 0x00855156,
+	    0x292e6aa0, 0x94c0d24b, 0x7e79b3a2, 0xd9ba5b68 } },
+	{ { 0x5f165d99, 0xcebbbc7b, 0x8a4eee61, 0x50cc51c1,
+	    0x1b4d0d1f, 0xb31d2353, 0x66382ada, 0x95e18452 },
+	  { 0x0a839b5b, 0xacad4f81, 0x4142ff0f, 0xa0a2a96e,
+	    0x1f4fa12f, 0x3eaa8289, 0x6b0fb8f3, 0x68d68c8f } },
+	{ { 0x839bb85f, 0x320f09c3, 0xa050e62c, 0x0101fb06,
+	    0x9ad53458, 0x557582c9, 0x1666432b, 0x55d5398d },
+	  { 0x4fed936f, 0xf7f63118, 0x1833d9e1, 0xd90d6a7f,
+	    0x8ebaa72a, 0x059c6a9e, 0x49ff8e2d, 0x576e2290 } },
+	{ { 0x51bbb3f1, 0x9311a269, 0x8d0f4f65, 0xe80f26bd,
+	    0x6beccbb9, 0x9d3dc334, 0x101e5de4, 0x54e244d5 },
+	  { 0xf1b19e28, 0xb3ad4c6e, 0x58c2e3b7, 0x4334fbc0,
+	    0x35df9c25, 0x19bd4107, 0xec106eb6, 0xd6bbec0e } },
+	{ { 0xe5046dc5, 0x788251c7, 0xf179327b, 0x12839b95,
+	    0x4a8cb46e, 0xf1c05d98, 0x3c00736b, 0x443737cd },
+	  { 0x12cd8fe5, 0xa760a456, 0x0817bdd9, 0x797489de,
+	    0xf42c23e8, 0xc56eb80a, 0xe6fe7af5, 0x83719dd7 } },
+	{ { 0x3fefcfc8, 0xe8881a83, 0xb9b5290b, 0xaea3c9e0,
+	    0x771e4688, 0x10b37ecd, 0xd4d021b6, 0xee0816a3 },
+	  { 0xb3a8caa1, 0x8e9929bf, 0xc105f2d1, 0x48915dcf,
+	    0xdb49019f, 0x3a5fdf82, 0xad9006e1, 0xc4a438e3 } },
+	{ { 0x87de4b29, 0x5db9620f, 0xd91ecb2e, 0xd7420c18,
+	    0x32acf105, 0x301ba1b2, 0x7853a937, 0xdb96bb0c },
+	  { 0xc359ac34, 0xd84bfef6, 0x64852a1d, 0xab80cef0,
+	    0xb9da1717, 0x3fbee4d3, 0x7a13222c, 0xb325074e } },
+	{ { 0xe83ad2c9, 0x5d6dc503, 0xaed035be, 0xca9f7a1d,
+	    0xcbd21e33, 0x552788ac, 0xe09cb9f0, 0x8699dd31 },
+	  { 0x329bf961, 0x38584196, 0xb82a5af9, 0x4cb20e96,
+	    0xc72c78c1, 0x24199908, 0xe92859b7, 0x16e65484 } },
+	{ { 0x052fde29, 0x6a201c4b, 0x0031dbb4, 0x6c897123,
+	    0x16c1da96, 0x4a759982, 0x2cc67214, 0xeec0b975 },
+	  { 0x812c864e, 0xb908b9f1, 0x8439f6ba, 0x367fb66a,
+	    0xf966f329, 0x789d664b, 0xf7f1d283, 0xe02af770 } },
+	{ { 0xdb3038dd, 0xa20a2c70, 0xe99d5c7c, 0x5f0b46d5,
+	    0x4b600b83, 0xc9b97d37, 0x3df3245e, 0x186c7f79 },
+	  { 0x4f1ce57f, 0x2af72460, 0x91e2d8ed, 0x9249897f,
+	    0x8d2ea797, 0x8139b36a, 0x9ab58913, 0x9c428db8 } },
+	{ { 0x6471aaa0, 0xb4a196fb, 0x1b6b9730, 0xdcbab650,
+	    0x295b57d2, 0x7afccc8a, 0x4e33a65d, 0xee2280f4 },
+	  { 0x890fcd12, 0xc47a0803, 0x82604f6b, 0x4e98a98d,
+	    0xed5fbbd2, 0x0d598f06, 0xa6a1eb84, 0xce46ec91 } },
+	{ { 0x4be6458d, 0x1f1e4f3f, 0x595e6547, 0x5f72cc22,
+	    0x271a93f1, 0x5bc5341e, 0x58a5f263, 0xc62e155c },
+	  { 0x58ba7ff4, 0x5f6f845a, 0x7e36a6ad, 0x67e1f7dc,
+	    0xeeaa4d04, 0xd33a7657, 0x18267e4e, 0xff9f2322 } },
+	{ { 0x4a53789f, 0xd369f11f, 0x3696b437, 0xc7876fb6,
+	    0x0baba29a, 0xa0e8f0a7, 0x32f6e514, 0xa0318a5f },
+	  { 0x11775a08, 0x5c4a43d1, 0x362eebb1, 0x418c507c,
+	    0x09a325aa, 0xfd08903f, 0xf0eebb3a, 0xf320b8fc } },
+	{ { 0xc7644c1d, 0xe33f0255, 0xbb9002d8, 0x4030ecc3,
+	    0xf4646f9f, 0xa4486916, 0x959c44fa, 0x5e677d0c },
+	  { 0xd88b9144, 0xe2e7d7d0, 0x6248f91f, 0x5d93a86f,
+	    0x02993aea, 0xe33d0bd5, 0x3100d31e, 0x449f0ce6 } },
+	{ { 0x73cf2678, 0x3fcd925a, 0xa6d0afc7, 0x34ca923b,
+	    0x3067791f, 0x9011091d, 0x5a7941e4, 0x8c568874 },
+	  { 0xfc339800, 0x34d37180, 0x595c51f4, 0x7744316b,
+	    0xe88c6420, 0xf2ddb693, 0x5bad14d2, 0xfb3a48b1 } },
+	{ { 0xfdaab256, 0x52df1588, 0x3127354c, 0x68c0cd44,
+	    0xa591f853, 0x2a849471, 0x93d0cb92, 0xe4da88e9 },
+	  { 0x1639c624, 0x6d1ea35d, 0x263707ba, 0x60fe2a36,
+	    0xd0f3bc51, 0x97fc50de, 0x10062e80, 0xf7fa4d15 } },
+	{ { 0x024c168d, 0xc429a113, 0x3feaa272, 0xb6c935fb,
+	    0xe639ec09, 0xb58a6071, 0xf9c13de7, 0x4b59253a },
+	  { 0xfbfb8955, 0x6d2d68f2, 0x50723fe2, 0xf0064c12,
+	    0x01f185f5, 0xe85d7820, 0x7fa79c93, 0xaa0307bf } },
+	{ { 0x5b696527, 0x2e75a266, 0x5a00169c, 0x1a2530b0,
+	    0x4286fb42, 0x76c4c180, 0x8e831d5b, 0x825f0194 },
+	  { 0xef703739, 0xdbf0a11f, 0xce5b106a, 0x106f9bc4,
+	    0x24111150, 0x61794c4f, 0xbc723a17, 0x435872fe } },
+};
+
+/* Multiples P, 3P, 5P, ... of the DH public key */
+static struct jpoint win_table[WIN_SIZE];
+
+/* All ones if a == b, zero otherwise */
+static uint32_t ct_eq(uint32_t a, uint32_t b)
+{
+	uint32_t x = a ^ b;
+
+	return ((x | (0U - x)) >> 31) - 1U;
+}
+
+static uint32_t vli_add(fe_t r, const fe_t a, const fe_t b)
+{
+	uint64_t acc = 0U;
+
+	for (int i = 0; i < LIMBS; i++) {
+		acc += (uint64_t)a[i] + b[i];
+		r[i] = (uint32_t)acc;
+		acc >>= 32;
+	}
+
+	return (uint32_t)acc;
+}
+
+static uint32_t vli_sub(fe_t r, const fe_t a, const fe_t b)
+{
+	uint32_t borrow = 0U;
+
+	for (int i = 0; i < LIMBS; i++) {
+		uint64_t diff = (uint64_t)a[i] - b[i] - borrow;
+
+		r[i] = (uint32_t)diff;
+		borrow = (uint32_t)(diff >> 32) & 1U;
+	}
+
+	return borrow;
+}
+
+static uint32_t vli_is_zero(const fe_t a)
+{
+	uint32_t acc = 0U;
+
+	for (int i = 0; i < LIMBS; i++) {
+		acc |= a[i];
+	}
+
+	return ct_eq(acc, 0U);
+}
+
+/* r = a if mask is all ones, unchanged if mask is zero */
+static void fe_cmov(fe_t r, const fe_t a, uint32_t mask)
+{
+	for (int i = 0; i < LIMBS; i++) {
+		r[i] ^= (r[i] ^ a[i]) & mask;
+	}
+}
+
+static void fe_from_be(fe_t r, const uint8_t in[32])
+{
+	for (int i = 0; i < LIMBS; i++) {
+		r[i] = sys_get_be32(&in[4 * (LIMBS - 1 - i)]);
+	}
+}
+
+static void fe_to_be(uint8_t out[32], const fe_t a)
+{
+	for (int i = 0; i < LIMBS; i++) {
+		sys_put_be32(a[i], &out[4 * (LIMBS - 1 - i)]);
+	}
+}
+
+static void fe_add(fe_t r, const fe_t a, const fe_t b)
+{
+	uint32_t carry, borrow;
+	fe_t t;
+
+	carry = vli_add(r, a, b);
+	borrow = vli_sub(t, r, p256_p);
+	fe_cmov(r, t, 0U - (carry | (borrow ^ 1U)));
+}
+
+static void fe_sub(fe_t r, const fe_t a, const fe_t b)
+{
+	uint32_t mask;
+	fe_t t;
+
+	mask = 0U - vli_sub(r, a, b);
+	for (int i = 0; i < LIMBS; i++) {
+		t[i] = p256_p[i] & mask;
+	}
+
+	(void)vli_add(r, r, t);
+}
+
+/* Add top * 2^256 = top * (2^224 - 2^192 - 2^96 + 1) modulo p to r */
+static int64_t fe_fold(fe_t r, int64_t top)
+{
+	int64_t acc;
+
+	acc = (int64_t)r[0] + top;
+	r[0] = (uint32_t)acc;
+	acc >>= 32;
+	acc += r[1];
+	r[1] = (uint32_t)acc;
+	acc >>= 32;
+	acc += r[2];
+	r[2] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)r[3] - top;
+	r[3] = (uint32_t)acc;
+	acc >>= 32;
+	acc += r[4];
+	r[4] = (uint32_t)acc;
+	acc >>= 32;
+	acc += r[5];
+	r[5] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)r[6] - top;
+	r[6] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)r[7] + top;
+	r[7] = (uint32_t)acc;
+	acc >>= 32;
+
+	return acc;
+}
+
+/* Reduce a 512-bit product modulo p */
+static void fe_reduce(fe_t r, const uint32_t c[2 * LIMBS])
+{
+	uint32_t borrow;
+	int64_t acc;
+	fe_t t;
+
+	acc = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+	r[0] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+	r[1] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+	r[2] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[3] + 2 * (int64_t)c[11] + 2 * (int64_t)c[12] + c[13] - c[15] - c[8] -
+	       c[9];
+	r[3] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[4] + 2 * (int64_t)c[12] + 2 * (int64_t)c[13] + c[14] - c[9] - c[10];
+	r[4] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[5] + 2 * (int64_t)c[13] + 2 * (int64_t)c[14] + c[15] - c[10] - c[11];
+	r[5] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+	r[6] = (uint32_t)acc;
+	acc >>= 32;
+	acc += (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+	r[7] = (uint32_t)acc;
+	acc >>= 32;
+
+	/* The carry is small: the first fold leaves at most one unit, which
+	 * the second one absorbs, and the result is then below 2p.
+	 */
+	acc = fe_fold(r, acc);
+	(void)fe_fold(r, acc);
+
+	borrow = vli_sub(t, r, p256_p);
+	fe_cmov(r, t, 0U - (borrow ^ 1U));
+}
+
+static void fe_mul(fe_t r, const fe_t a, const fe_t b)
+{
+	uint32_t c[2 * LIMBS] = { 0 };
+
+	for (int i = 0; i < LIMBS; i++) {
+		uint32_t carry = 0U;
+
+		for (int j = 0; j < LIMBS; j++) {
+			uint64_t acc = (uint64_t)a[i] * b[j] + c[i + j] + carry;
+
+			c[i + j] = (uint32_t)acc;
+			carry = (uint32_t)(acc >> 32);
+		}
+
+		c[i + LIMBS] = carry;
+	}
+
+	fe_reduce(r, c);
+}
+
+static void fe_sqr(fe_t r, const fe_t a)
+{
+	uint32_t c[2 * LIMBS] = { 0 };
+	uint64_t acc = 0U;
+
+	/* Cross products once, doubled, then the squares of the limbs */
+	for (int i = 0; i < LIMBS - 1; i++) {
+		uint32_t carry = 0U;
+
+		for (int j = i + 1; j < LIMBS; j++) {
+			uint64_t prod = (uint64_t)a[i] * a[j] + c[i + j] + carry;
+
+			c[i + j] = (uint32_t)prod;
+			carry = (uint32_t)(prod >> 32);
+		}
+
+		c[i + LIMBS] = carry;
+	}
+
+	for (int i = 2 * LIMBS - 1; i > 0; i--) {
+		c[i] = (c[i] << 1) | (c[i - 1] >> 31);
+	}
+	c[0] <<= 1;
+
+	for (int i = 0; i < LIMBS; i++) {
+		uint64_t prod = (uint64_t)a[i] * a[i];
+
+		acc += (uint64_t)c[2 * i] + (uint32_t)prod;
+		c[2 * i] = (uint32_t)acc;
+		acc >>= 32;
+		acc += (uint64_t)c[2 * i + 1] + (prod >> 32);
+		c[2 * i + 1] = (uint32_t)acc;
+		acc >>= 32;
+	}
+
+	fe_reduce(r, c);
+}
+
+static void fe_sqr_n(fe_t r, const fe_t a, int n)
+{
+	fe_sqr(r, a);
+	while (--n > 0) {
+		fe_sqr(r, r);
+	}
+}
+
+/* r = a^(p - 2) = 1 / a, with 255 squarings and 12 multiplications */
+static void fe_inv(fe_t r, const fe_t a)
+{
+	fe_t x2, x3, x6, x12, x15, x30, x32;
+
+	fe_sqr(x2, a);
+	fe_mul(x2, x2, a);
+	fe_sqr(x3, x2);
+	fe_mul(x3, x3, a);
+	fe_sqr_n(x6, x3, 3);
+	fe_mul(x6, x6, x3);
+	fe_sqr_n(x12, x6, 6);
+	fe_mul(x12, x12, x6);
+	fe_sqr_n(x15, x12, 3);
+	fe_mul(x15, x15, x3);
+	fe_sqr_n(x30, x15, 15);
+	fe_mul(x30, x30, x15);
+	fe_sqr_n(x32, x30, 2);
+	fe_mul(x32, x32, x2);
+
+	/* p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff
+	 *         ffffffff fffffffd
+	 */
+	fe_sqr_n(r, x32, 32);
+	fe_mul(r, r, a);
+	fe_sqr_n(r, r, 128);
+	fe_mul(r, r, x32);
+	fe_sqr_n(r, r, 32);
+	fe_mul(r, r, x32);
+	fe_sqr_n(r, r, 30);
+	fe_mul(r, r, x30);
+	fe_sqr_n(r, r, 2);
+	fe_mul(r, r, a);
+}
+
+static void point_set_infinity(struct jpoint *r)
+{
+	(void)memcpy(r->x, fe_one, sizeof(fe_t));
+	(void)memcpy(r->y, fe_one, sizeof(fe_t));
+	(void)memset(r->z, 0, sizeof(fe_t));
+}
+
+/* r = 2p, with a = -3 (dbl-2001-b). Infinity (1, 1, 0) maps to itself. */
+static void point_double(struct jpoint *r, const struct jpoint *p)
+{
+	fe_t delta, gamma, beta, alpha, t;
+
+	fe_sqr(delta, p->z);
+	fe_sqr(gamma, p->y);
+	fe_mul(beta, p->x, gamma);
+
+	/* alpha = 3 * (X - delta) * (X + delta) */
+	fe_sub(t, p->x, delta);
+	fe_add(alpha, p->x, delta);
+	fe_mul(alpha, alpha, t);
+	fe_add(t, alpha, alpha);
+	fe_add(alpha, t, alpha);
+
+	/* Z3 = (Y + Z)^2 - gamma - delta */
+	fe_add(t, p->y, p->z);
+	fe_sqr(t, t);
+	fe_sub(t, t, gamma);
+	fe_sub(r->z, t, delta);
+
+	/* X3 = alpha^2 - 8 * beta */
+	fe_add(beta, beta, beta);
+	fe_add(beta, beta, beta);
+	fe_sqr(r->x, alpha);
+	fe_sub(r->x, r->x, beta);
+	fe_sub(r->x, r->x, beta);
+
+	/* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+	fe_sub(t, beta, r->x);
+	fe_mul(t, t, alpha);
+	fe_sqr(gamma, gamma);
+	fe_add(gamma, gamma, gamma);
+	fe_add(gamma, gamma, gamma);
+	fe_add(gamma, gamma, gamma);
+	fe_sub(r->y, t, gamma);
+}
+
+/* r = p + (X, Y, Z1 * Z2 * h) from u1, s1 and the differences h and rr of
+ * the other operand (add-1998-cmo-2, shared with the mixed addition).
+ */
+static void point_add_finish(struct jpoint *r, const struct jpoint *p, const fe_t z2,
+			     const fe_t u1, const fe_t s1, const fe_t h, const fe_t rr)
+{
+	fe_t hh, hhh, v, x3;
+
+	if (vli_is_zero(h)) {
+		/* Equal or opposite points, which scalar multiplication only
+		 * meets for a negligible number of scalars.
+		 */
+		if (vli_is_zero(rr)) {
+			point_double(r, p);
+		} else {
+			point_set_infinity(r);
+		}
+
+		return;
+	}
+
+	fe_sqr(hh, h);
+	fe_mul(hhh, h, hh);
+	fe_mul(v, u1, hh);
+
+	/* X3 = rr^2 - hhh - 2 * v */
+	fe_sqr(x3, rr);
+	fe_sub(x3, x3, hhh);
+	fe_sub(x3, x3, v);
+	fe_sub(x3, x3, v);
+
+	/* Y3 = rr * (v - X3) - s1 * hhh */
+	fe_sub(v, v, x3);
+	fe_mul(v, v, rr);
+	fe_mul(hhh, hhh, s1);
+	fe_sub(r->y, v, hhh);
+
+	/* Z3 = Z1 * Z2 * h */
+	if (z2 != NULL) {
+		fe_mul(r->z, p->z, z2);
+		fe_mul(r->z, r->z, h);
+	} else {
+		fe_mul(r->z, p->z, h);
+	}
+
+	(void)memcpy(r->x, x3, sizeof(fe_t));
+}
+
+/* r = p + q, with p not at infinity */
+static void point_add(struct jpoint *r, const struct jpoint *p, const struct jpoint *q)
+{
+	fe_t z1z1, z2z2, u1, u2, s1, s2;
+
+	fe_sqr(z1z1, p->z);
+	fe_sqr(z2z2, q->z);
+	fe_mul(u1, p->x, z2z2);
+	fe_mul(u2, q->x, z1z1);
+	fe_mul(s1, p->y, q->z);
+	fe_mul(s1, s1, z2z2);
+	fe_mul(s2, q->y, p->z);
+	fe_mul(s2, s2, z1z1);
+
+	fe_sub(u2, u2, u1);
+	fe_sub(s2, s2, s1);
+
+	point_add_finish(r, p, q->z, u1, s1, u2, s2);
+}
+
+/* r = p + q for an affine q */
+static void point_add_mixed(struct jpoint *r, const struct jpoint *p, const struct apoint *q)
+{
+	fe_t z1z1, u2, s2;
+
+	fe_sqr(z1z1, p->z);
+	fe_mul(u2, q->x, z1z1);
+	fe_mul(s2, q->y, p->z);
+	fe_mul(s2, s2, z1z1);
+
+	fe_sub(u2, u2, p->x);
+	fe_sub(s2, s2, p->y);
+
+	point_add_finish(r, p, NULL, p->x, p->y, u2, s2);
+}
+
+static void point_to_affine(fe_t x, fe_t y, const struct jpoint *p)
+{
+	fe_t zinv, zinv2;
+
+	fe_inv(zinv, p->z);
+	fe_sqr(zinv2, zinv);
+	fe_mul(x, p->x, zinv2);
+
+	if (y != NULL) {
+		fe_mul(zinv2, zinv2, zinv);
+		fe_mul(y, p->y, zinv2);
+	}
+}
+
+/* Load a scalar, all ones if it is in the range [1, n - 1] */
+static uint32_t scalar_from_be(fe_t k, const uint8_t in[32])
+{
+	fe_t t;
+
+	fe_from_be(k, in);
+
+	return (0U - vli_sub(t, k, p256_n)) & ~vli_is_zero(k);
+}
+
+static uint32_t comb_column(const fe_t k, int i)
+{
+	uint32_t v = 0U;
+
+	for (int j = 0; j < COMB_W; j++) {
+		int bit = COMB_D * j + i;
+
+		if (bit < 256) {
+			v |= ((k[bit / 32] >> (bit % 32)) & 1U) << j;
+		}
+	}
+
+	return v;
+}
+
+static void comb_lookup(struct apoint *r, uint32_t v)
+{
+	(void)memset(r, 0, sizeof(*r));
+
+	for (uint32_t i = 0U; i < ARRAY_SIZE(comb_table); i++) {
+		uint32_t mask = ct_eq(i + 1U, v);
+
+		for (int j = 0; j < LIMBS; j++) {
+			r->x[j] |= comb_table[i].x[j] & mask;
+			r->y[j] |= comb_table[i].y[j] & mask;
+		}
+	}
+}
+
+/* r = k * G */
+static void comb_mul(struct jpoint *r, const fe_t k)
+{
+	uint32_t inf = UINT32_MAX;
+	struct apoint q;
+	struct jpoint t;
+
+	point_set_infinity(r);
+
+	for (int i = COMB_D - 1; i >= 0; i--) {
+		uint32_t v = comb_column(k, i);
+		uint32_t nz = ~ct_eq(v, 0U);
+
+		point_double(r, r);
+		comb_lookup(&q, v);
+		point_add_mixed(&t, r, &q);
+
+		/* Keep r for a zero column, take q while r is at infinity */
+		fe_cmov(r->x, t.x, nz & ~inf);
+		fe_cmov(r->y, t.y, nz & ~inf);
+		fe_cmov(r->z, t.z, nz & ~inf);
+		fe_cmov(r->x, q.x, nz & inf);
+		fe_cmov(r->y, q.y, nz & inf);
+		fe_cmov(r->z, fe_one, nz & inf);
+		inf &= ~nz;
+	}
+}
+
+/* Recode an odd scalar into WIN_DIGITS odd signed digits, most significant
+ * last. Unlike a NAF, every digit is non-zero so the sequence of operations
+ * does not depend on the scalar.
+ */
+static void scalar_recode(int8_t digits[WIN_DIGITS], fe_t k)
+{
+	for (int i = 0; i < WIN_DIGITS - 1; i++) {
+		int32_t d = (int32_t)(k[0] & ((2U << WIN_W) - 1U)) - (1 << WIN_W);
+		int64_t acc;
+
+		digits[i] = (int8_t)d;
+
+		/* k = (k - d) / 2^WIN_W, which stays odd */
+		acc = (int64_t)k[0] - d;
+		for (int j = 0; j < LIMBS; j++) {
+			if (j > 0) {
+				acc += k[j];
+			}
+			k[j] = (uint32_t)acc;
+			acc >>= 32;
+		}
+
+		for (int j = 0; j < LIMBS - 1; j++) {
+			k[j] = (k[j] >> WIN_W) | (k[j + 1] << (32 - WIN_W));
+		}
+		k[LIMBS - 1] >>= WIN_W;
+	}
+
+	digits[WIN_DIGITS - 1] = (int8_t)k[0];
+}
+
+/* r = d * P for an odd digit d */
+static void win_lookup(struct jpoint *r, int8_t d)
+{
+	uint32_t neg = (uint32_t)((int32_t)d >> 31);
+	uint32_t idx = ((((uint32_t)d ^ neg) - neg) - 1U) >> 1;
+	fe_t y;
+
+	(void)memset(r, 0, sizeof(*r));
+
+	for (uint32_t i = 0U; i < WIN_SIZE; i++) {
+		uint32_t mask = ct_eq(i, idx);
+
+		for (int j = 0; j < LIMBS; j++) {
+			r->x[j] |= win_table[i].x[j] & mask;
+			r->y[j] |= win_table[i].y[j] & mask;
+			r->z[j] |= win_table[i].z[j] & mask;
+		}
+	}
+
+	(void)memset(y, 0, sizeof(y));
+	fe_sub(y, y, r->y);
+	fe_cmov(r->y, y, neg);
+}
+
+int bt_p256_public_key(const uint8_t private_key[32], uint8_t public_key[64])
+{
+	struct jpoint r;
+	fe_t k, x, y;
+	uint32_t valid;
+
+	valid = scalar_from_be(k, private_key);
+	if (!valid) {
+		return -EINVAL;
+	}
+
+	comb_mul(&r, k);
+	point_to_affine(x, y, &r);
+
+	fe_to_be(public_key, x);
+	fe_to_be(&public_key[32], y);
+
+	(void)memset(k, 0, sizeof(k));
+
+	return 0;
+}
+
+bool bt_p256_public_key_valid(const uint8_t public_key[64])
+{
+	fe_t x, y, lhs, rhs, t;
+
+	fe_from_be(x, public_key);
+	fe_from_be(y, &public_key[32]);
+
+	if (!vli_sub(t, x, p256_p) || !vli_sub(t, y, p256_p)) {
+		return false;
+	}
+
+	/* y^2 = x^3 - 3x + b */
+	fe_sqr(lhs, y);
+
+	fe_sqr(rhs, x);
+	fe_mul(rhs, rhs, x);
+	fe_add(t, x, x);
+	fe_add(t, t, x);
+	fe_sub(rhs, rhs, t);
+	fe_add(rhs, rhs, p256_b);
+
+	return memcmp(lhs, rhs, sizeof(fe_t)) == 0;
+}
+
+int bt_p256_dhkey(const uint8_t public_key[64], const uint8_t private_key[32],
+		  uint8_t dhkey[32])
+{
+	int8_t digits[WIN_DIGITS];
+	struct jpoint r, t;
+	fe_t k, nk;
+
+	if (!bt_p256_public_key_valid(public_key)) {
+		return -EINVAL;
+	}
+
+	if (!scalar_from_be(k, private_key)) {
+		return -EINVAL;
+	}
+
+	/* n - k is odd when k is even, and (n - k) * P = -(k * P) has the
+	 * same X coordinate.
+	 */
+	(void)vli_sub(nk, p256_n, k);
+	fe_cmov(k, nk, (k[0] & 1U) - 1U);
+	scalar_recode(digits, k);
+
+	fe_from_be(win_table[0].x, public_key);
+	fe_from_be(win_table[0].y, &public_key[32]);
+	(void)memcpy(win_table[0].z, fe_one, sizeof(fe_t));
+
+	point_double(&t, &win_table[0]);
+	for (int i = 1; i < WIN_SIZE; i++) {
+		point_add(&win_table[i], &win_table[i - 1], &t);
+	}
+
+	win_lookup(&r, digits[WIN_DIGITS - 1]);
+	for (int i = WIN_DIGITS - 2; i >= 0; i--) {
+		for (int j = 0; j < WIN_W; j++) {
+			point_double(&r, &r);
+		}
+
+		win_lookup(&t, digits[i]);
+		point_add(&r, &r, &t);
+	}
+
+	point_to_affine(k, NULL, &r);
+	fe_to_be(dhkey, k);
+
+	(void)memset(nk, 0, sizeof(nk));
+	(void)memset(digits, 0, sizeof(digits));
+	(void)memset(win_table, 0, sizeof(win_table));
+
+	return 0;
+}
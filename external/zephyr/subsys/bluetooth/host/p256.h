@@ -0,0 +1,51 @@
+/* p256.h - NIST P-256 key generation and ECDH */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* All keys are big-endian. Public keys are the X coordinate followed by the
+ * Y coordinate, private keys are scalars in the range [1, n - 1].
+ *
+ * The functions run in constant time with respect to the private key and are
+ * not reentrant: callers must be serialized.
+ */
+
+/** @brief Compute the public key of a private key.
+ *
+ *  Uses a fixed-base comb over a table of multiples of the generator.
+ *
+ *  @param private_key 32 byte private key.
+ *  @param public_key  64 byte buffer for the public key.
+ *
+ *  @retval 0 Success.
+ *  @retval -EINVAL @p private_key is not in the range [1, n - 1].
+ */
+int bt_p256_public_key(const uint8_t private_key[32], uint8_t public_key[64]);
+
+/** @brief Check that a public key is a point of the curve.
+ *
+ *  @param public_key 64 byte public key.
+ *
+ *  @return true if both coordinates are field elements and satisfy the curve
+ *          equation, false otherwise.
+ */
+bool bt_p256_public_key_valid(const uint8_t public_key[64]);
+
+/** @brief Compute the Diffie-Hellman key of a public and a private key.
+ *
+ *  Uses a signed fixed window recoding of the private key.
+ *
+ *  @param public_key  64 byte public key of the remote device.
+ *  @param private_key 32 byte private key.
+ *  @param dhkey       32 byte buffer for the X coordinate of the shared point.
+ *
+ *  @retval 0 Success.
+ *  @retval -EINVAL @p public_key is not valid or @p private_key is not in the
+ *                  range [1, n - 1].
+ */
+int bt_p256_dhkey(const uint8_t public_key[64], const uint8_t private_key[32],
+		  uint8_t dhkey[32]);
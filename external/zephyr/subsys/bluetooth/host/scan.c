@@ -48,6 +48,12 @@ struct fragmented_advertiser {
 
 static struct fragmented_advertiser reassembling_advertiser;
 
+/* Advertisement data of the advertiser being reassembled, as references to
+ * the HCI event buffers it was received in. Only used with
+ * CONFIG_BT_EXT_SCAN_FRAG_CHAIN, otherwise the data is copied to ext_scan_buf.
+ */
+static struct net_buf *ext_scan_frags;
+
 static bool fragmented_advertisers_equal(const struct fragmented_advertiser *a,
 					 const bt_addr_le_t *addr, uint8_t sid)
 {
@@ -66,9 +72,90 @@ static void init_reassembling_advertiser(const bt_addr_le_t *addr, uint8_t sid)
 static void reset_reassembling_advertiser(void)
 {
 	net_buf_simple_reset(&ext_scan_buf);
+
+	if (ext_scan_frags) {
+		net_buf_unref(ext_scan_frags);
+		ext_scan_frags = NULL;
+	}
+
 	reassembling_advertiser.state = FRAG_ADV_INACTIVE;
 }
 
+/* Copy the advertisement data in the fragment chain into ext_scan_buf */
+static struct net_buf_simple *ext_scan_frags_linearize(struct net_buf *frags,
+							uint16_t *len)
+{
+	net_buf_simple_reset(&ext_scan_buf);
+
+	for (; frags; frags = frags->frags) {
+		net_buf_simple_add_mem(&ext_scan_buf, frags->data, frags->len);
+	}
+
+	*len = ext_scan_buf.len;
+
+	return &ext_scan_buf;
+}
+
+static uint16_t ext_scan_data_len(void)
+{
+	return ext_scan_buf.len + net_buf_frags_len(ext_scan_frags);
+}
+
+/* Whether ext_scan_frags may reference one more buffer of the pool of buf.
+ * At most half of the buffers of a pool are referenced, leaving the others
+ * for receiving the remaining reports of the advertiser and other events.
+ * Reports are usually received in the small discardable event pool, which
+ * would otherwise be exhausted before the reassembly can complete.
+ */
+static bool ext_scan_frags_available(const struct net_buf *buf)
+{
+	const struct net_buf_pool *pool = net_buf_pool_get(buf->pool_id);
+	uint16_t count = 0U;
+
+	for (struct net_buf *frag = ext_scan_frags; frag; frag = frag->frags) {
+		if (frag->pool_id == buf->pool_id) {
+			count++;
+		}
+	}
+
+	return count < (pool->buf_count / 2U);
+}
+
+static void ext_scan_data_add(struct net_buf *buf, uint16_t len)
+{
+	/* Reference the data instead of copying it if it is the last report
+	 * in the event buffer, as buf->data and buf->len are then not changed
+	 * anymore once the event has been processed.
+	 */
+	if (IS_ENABLED(CONFIG_BT_EXT_SCAN_FRAG_CHAIN) && (buf->len == len) &&
+	    (ext_scan_buf.len == 0U) &&
+	    ext_scan_frags_available(buf)) {
+		struct net_buf *frag = net_buf_ref(buf);
+
+		if (ext_scan_frags) {
+			net_buf_frag_add(ext_scan_frags, frag);
+		} else {
+			ext_scan_frags = frag;
+		}
+
+		return;
+	}
+
+	/* Otherwise continue the reassembly by copying, starting with the
+	 * data referenced so far.
+	 */
+	if (ext_scan_frags) {
+		uint16_t frags_len;
+
+		(void)ext_scan_frags_linearize(ext_scan_frags, &frags_len);
+
+		net_buf_unref(ext_scan_frags);
+		ext_scan_frags = NULL;
+	}
+
+	net_buf_simple_add_mem(&ext_scan_buf, buf->data, len);
+}
+
 #if defined(CONFIG_BT_PER_ADV_SYNC)
 static struct bt_le_per_adv_sync *get_pending_per_adv_sync(void);
 static struct bt_le_per_adv_sync per_adv_sync_pool[CONFIG_BT_PER_ADV_SYNC_MAX];
@@ -436,8 +523,13 @@ static uint8_t get_adv_props_legacy(uint8_t evt_type)
 	}
 }
 
+/* The advertisement data is given in buf, or in the frags chain, or both; in
+ * which case buf is the data of the single buffer in frags and len octets of
+ * it are valid.
+ */
 static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
-			struct net_buf_simple *buf, uint16_t len)
+			struct net_buf_simple *buf, uint16_t len,
+			struct net_buf *frags)
 {
 	struct bt_le_scan_cb *listener, *next;
 	struct net_buf_simple_state state;
@@ -464,6 +556,12 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	}
 
 	if (scan_dev_found_cb) {
+#if defined(CONFIG_BT_EXT_SCAN_FRAG_CHAIN)
+		if (!buf) {
+			buf = ext_scan_frags_linearize(frags, &len);
+		}
+#endif /* CONFIG_BT_EXT_SCAN_FRAG_CHAIN */
+
 		net_buf_simple_save(buf, &state);
 
 		buf->len = len;
@@ -475,6 +573,27 @@ static void le_adv_recv(bt_addr_le_t *addr, struct bt_le_scan_recv_info *info,
 	info->addr = &id_addr;
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&scan_cbs, listener, next, node) {
+#if defined(CONFIG_BT_EXT_SCAN_FRAG_CHAIN)
+		if (listener->recv_frags && frags) {
+			if (buf) {
+				net_buf_simple_save(buf, &state);
+				buf->len = len;
+			}
+
+			listener->recv_frags(info, frags);
+
+			if (buf) {
+				net_buf_simple_restore(buf, &state);
+			}
+
+			continue;
+		}
+
+		if (listener->recv && !buf) {
+			buf = ext_scan_frags_linearize(frags, &len);
+		}
+#endif /* CONFIG_BT_EXT_SCAN_FRAG_CHAIN */
+
 		if (listener->recv) {
 			net_buf_simple_save(buf, &state);
 
@@ -607,7 +726,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			 * Create event immediately.
 			 */
 			create_ext_adv_info(evt, &scan_info);
-			le_adv_recv(&evt->addr, &scan_info, &buf->b, evt->length);
+			le_adv_recv(&evt->addr, &scan_info, &buf->b, evt->length, buf);
 			goto cont;
 		}
 
@@ -620,7 +739,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			 * Create event immediately.
 			 */
 			create_ext_adv_info(evt, &scan_info);
-			le_adv_recv(&evt->addr, &scan_info, &buf->b, evt->length);
+			le_adv_recv(&evt->addr, &scan_info, &buf->b, evt->length, buf);
 			goto cont;
 		}
 
@@ -656,7 +775,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			init_reassembling_advertiser(&evt->addr, evt->sid);
 		}
 
-		if (evt->length + ext_scan_buf.len > ext_scan_buf.size) {
+		if (evt->length + ext_scan_data_len() > ext_scan_buf.size) {
 			/* The report does not fit in the reassemby buffer
 			 * Discard this and future reports from the advertiser.
 			 */
@@ -673,7 +792,7 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 			goto cont;
 		}
 
-		net_buf_simple_add_mem(&ext_scan_buf, buf->data, evt->length);
+		ext_scan_data_add(buf, evt->length);
 		if (more_to_come) {
 			/* The controller will send additional reports to be reassembled */
 			continue;
@@ -684,7 +803,12 @@ void bt_hci_le_adv_ext_report(struct net_buf *buf)
 		 */
 		__ASSERT_NO_MSG(is_report_complete);
 		create_ext_adv_info(evt, &scan_info);
-		le_adv_recv(&evt->addr, &scan_info, &ext_scan_buf, ext_scan_buf.len);
+		if (ext_scan_frags) {
+			le_adv_recv(&evt->addr, &scan_info, NULL, 0U, ext_scan_frags);
+		} else {
+			le_adv_recv(&evt->addr, &scan_info, &ext_scan_buf,
+				    ext_scan_buf.len, NULL);
+		}
 
 		/* We do no longer need to keep track of this advertiser. */
 		reset_reassembling_advertiser();
@@ -1416,7 +1540,7 @@ void bt_hci_le_adv_report(struct net_buf *buf)
 		adv_info.adv_type = evt->evt_type;
 		adv_info.adv_props = get_adv_props_legacy(evt->evt_type);
 
-		le_adv_recv(&evt->addr, &adv_info, &buf->b, evt->length);
+		le_adv_recv(&evt->addr, &adv_info, &buf->b, evt->length, buf);
 
 		net_buf_pull(buf, evt->length + sizeof(adv_info.rssi));
 	}
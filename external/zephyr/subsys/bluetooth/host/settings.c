@@ -5,6 +5,7 @@
  */
 
 #include <errno.h>
+#include <string.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
@@ -298,30 +299,253 @@ int bt_settings_init(void)
 	return 0;
 }
 
-int bt_settings_store(const char *key, uint8_t id, const bt_addr_le_t *addr, const void *value,
-		      size_t val_len)
+#if defined(CONFIG_BT_SETTINGS_WRITE_BEHIND)
+/* Values stored by the stack and not yet written to the settings backend.
+ * An entry of length zero is a deletion.
+ */
+struct pending_entry {
+	/* Order of the first store, entries are written oldest first */
+	uint32_t seq;
+	uint16_t len;
+	bool used;
+	char key[BT_SETTINGS_KEY_MAX];
+	uint8_t val[CONFIG_BT_SETTINGS_WRITE_BEHIND_VAL_MAX];
+};
+
+static struct pending_entry pending[CONFIG_BT_SETTINGS_WRITE_BEHIND_ENTRIES];
+static uint32_t pending_seq;
+
+/* Protects the pending entries */
+static K_MUTEX_DEFINE(pending_lock);
+/* Serializes the writes to the backend, so that the values of a key reach
+ * it in the order they were stored.
+ */
+static K_MUTEX_DEFINE(flush_lock);
+
+static void flush_work_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+
+static struct pending_entry *pending_find(const char *key)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		if (pending[i].used && !strcmp(pending[i].key, key)) {
+			return &pending[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct pending_entry *pending_alloc(const char *key, uint32_t seq)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		if (!pending[i].used) {
+			pending[i].used = true;
+			pending[i].seq = seq;
+			strcpy(pending[i].key, key);
+
+			return &pending[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct pending_entry *pending_oldest(void)
+{
+	struct pending_entry *oldest = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		if (pending[i].used &&
+		    (!oldest || (int32_t)(pending[i].seq - oldest->seq) < 0)) {
+			oldest = &pending[i];
+		}
+	}
+
+	return oldest;
+}
+
+/* Write the oldest pending entry, with flush_lock held */
+static int pending_write_oldest(void)
 {
+	/* Only used with flush_lock held */
+	static struct pending_entry entry;
+	struct pending_entry *e;
 	int err;
-	char id_str[4];
-	char key_str[BT_SETTINGS_KEY_MAX];
 
-	if (addr) {
-		if (id) {
-			u8_to_dec(id_str, sizeof(id_str), id);
+	k_mutex_lock(&pending_lock, K_FOREVER);
+
+	e = pending_oldest();
+	if (!e) {
+		k_mutex_unlock(&pending_lock);
+		return -ENOENT;
+	}
+
+	/* Stores of the key from now on make a new entry */
+	memcpy(&entry, e, sizeof(entry));
+	e->used = false;
+
+	k_mutex_unlock(&pending_lock);
+
+	err = settings_save_one(entry.key, entry.len ? entry.val : NULL, entry.len);
+	if (!err) {
+		return 0;
+	}
+
+	LOG_ERR("Failed to write %s (err %d)", entry.key, err);
+
+	/* Retry later, unless a newer value was stored meanwhile */
+	k_mutex_lock(&pending_lock, K_FOREVER);
+
+	if (!pending_find(entry.key)) {
+		e = pending_alloc(entry.key, entry.seq);
+		if (e) {
+			e->len = entry.len;
+			memcpy(e->val, entry.val, entry.len);
+		} else {
+			LOG_ERR("Dropped value of %s", entry.key);
 		}
+	}
 
-		bt_settings_encode_key(key_str, sizeof(key_str), key, addr, (id ? id_str : NULL));
-	} else {
-		err = snprintk(key_str, sizeof(key_str), "bt/%s", key);
-		if (err < 0) {
-			return -EINVAL;
+	k_mutex_unlock(&pending_lock);
+
+	return err;
+}
+
+int bt_settings_flush(void)
+{
+	int err;
+
+	k_mutex_lock(&flush_lock, K_FOREVER);
+
+	do {
+		err = pending_write_oldest();
+	} while (!err);
+
+	k_mutex_unlock(&flush_lock);
+
+	return err == -ENOENT ? 0 : err;
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	if (bt_settings_flush()) {
+		k_work_schedule(&flush_work, K_MSEC(CONFIG_BT_SETTINGS_WRITE_BEHIND_DELAY_MS));
+	}
+}
+
+static int pending_store(const char *key, const void *value, size_t val_len)
+{
+	struct pending_entry *e;
+	int err;
+
+	if (val_len > sizeof(e->val)) {
+		/* Too large to be kept, written now in place of any pending
+		 * value of the key.
+		 */
+		k_mutex_lock(&flush_lock, K_FOREVER);
+
+		k_mutex_lock(&pending_lock, K_FOREVER);
+		e = pending_find(key);
+		if (e) {
+			e->used = false;
 		}
+		k_mutex_unlock(&pending_lock);
+
+		err = settings_save_one(key, value, val_len);
+
+		k_mutex_unlock(&flush_lock);
+
+		return err;
 	}
 
-	return settings_save_one(key_str, value, val_len);
+	while (true) {
+		k_mutex_lock(&pending_lock, K_FOREVER);
+
+		e = pending_find(key);
+		if (!e) {
+			e = pending_alloc(key, pending_seq);
+			if (e) {
+				pending_seq++;
+			}
+		}
+
+		if (e) {
+			break;
+		}
+
+		k_mutex_unlock(&pending_lock);
+
+		/* All entries are in use, make room from this context */
+		k_mutex_lock(&flush_lock, K_FOREVER);
+		err = pending_write_oldest();
+		k_mutex_unlock(&flush_lock);
+
+		if (err && err != -ENOENT) {
+			return err;
+		}
+	}
+
+	e->len = val_len;
+	if (val_len) {
+		memcpy(e->val, value, val_len);
+	}
+
+	k_mutex_unlock(&pending_lock);
+
+	/* The first store since the last flush sets the deadline */
+	k_work_schedule(&flush_work, K_MSEC(CONFIG_BT_SETTINGS_WRITE_BEHIND_DELAY_MS));
+
+	return 0;
 }
 
-int bt_settings_delete(const char *key, uint8_t id, const bt_addr_le_t *addr)
+static ssize_t pending_read(void *cb_arg, void *data, size_t len)
+{
+	struct pending_entry *e = cb_arg;
+
+	len = MIN(len, e->len);
+	memcpy(data, e->val, len);
+
+	return len;
+}
+
+void bt_settings_load_pending(const char *subtree, settings_load_direct_cb cb, void *param)
+{
+	struct pending_entry entry;
+	const char *next;
+
+	for (size_t i = 0; i < ARRAY_SIZE(pending); i++) {
+		k_mutex_lock(&pending_lock, K_FOREVER);
+
+		if (!pending[i].used || !settings_name_steq(pending[i].key, subtree, &next)) {
+			k_mutex_unlock(&pending_lock);
+			continue;
+		}
+
+		memcpy(&entry, &pending[i], sizeof(entry));
+
+		k_mutex_unlock(&pending_lock);
+
+		(void)cb(next, entry.len, pending_read, &entry, param);
+	}
+}
+
+#if defined(CONFIG_BT_CONN)
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	/* The values stored on disconnection, e.g. CCC, are already pending */
+	k_work_reschedule(&flush_work, K_NO_WAIT);
+}
+
+BT_CONN_CB_DEFINE(settings_conn_callbacks) = {
+	.disconnected = disconnected,
+};
+#endif /* CONFIG_BT_CONN */
+#endif /* CONFIG_BT_SETTINGS_WRITE_BEHIND */
+
+static int settings_write(const char *key, uint8_t id, const bt_addr_le_t *addr,
+			  const void *value, size_t val_len)
 {
 	int err;
 	char id_str[4];
@@ -340,7 +564,23 @@ int bt_settings_delete(const char *key, uint8_t id, const bt_addr_le_t *addr)
 		}
 	}
 
-	return settings_delete(key_str);
+#if defined(CONFIG_BT_SETTINGS_WRITE_BEHIND)
+	return pending_store(key_str, value, val_len);
+#else
+	return settings_save_one(key_str, value, val_len);
+#endif
+}
+
+int bt_settings_store(const char *key, uint8_t id, const bt_addr_le_t *addr, const void *value,
+		      size_t val_len)
+{
+	return settings_write(key, id, addr, value, val_len);
+}
+
+int bt_settings_delete(const char *key, uint8_t id, const bt_addr_le_t *addr)
+{
+	/* Same as settings_delete() */
+	return settings_write(key, id, addr, NULL, 0);
 }
 
 int bt_settings_store_sc(uint8_t id, const bt_addr_le_t *addr, const void *value, size_t val_len)
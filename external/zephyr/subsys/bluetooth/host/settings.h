@@ -28,6 +28,16 @@ int bt_settings_decode_key(const char *key, bt_addr_le_t *addr);
 
 void bt_settings_save_id(void);
 
+/* Write the values buffered with CONFIG_BT_SETTINGS_WRITE_BEHIND to the
+ * settings backend.
+ */
+int bt_settings_flush(void);
+
+/* Call cb for the buffered values of subtree, which are newer than the ones
+ * loaded with settings_load_subtree_direct().
+ */
+void bt_settings_load_pending(const char *subtree, settings_load_direct_cb cb, void *param);
+
 int bt_settings_init(void);
 
 int bt_settings_store_sc(uint8_t id, const bt_addr_le_t *addr, const void *value, size_t val_len);
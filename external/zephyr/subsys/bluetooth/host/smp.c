@@ -207,6 +207,17 @@ struct bt_smp {
 	/* Delayed work for timeout handling */
 	struct k_work_delayable		work;
 
+#if defined(CONFIG_BT_SMP_WORKQ)
+	/* Received PDUs waiting for the SMP work queue */
+	struct k_fifo			rx_queue;
+
+	/* Work processing the received PDUs */
+	struct k_work			rx_work;
+
+	/* Number of PDUs in rx_queue */
+	atomic_t			rx_queued;
+#endif /* CONFIG_BT_SMP_WORKQ */
+
 	/* Used Bluetooth authentication callbacks. */
 	atomic_ptr_t			auth_cb;
 
@@ -286,6 +297,54 @@ static bool sc_supported;
 static const uint8_t *sc_public_key;
 static K_SEM_DEFINE(sc_local_pkey_ready, 0, 1);
 
+#if defined(CONFIG_BT_SMP_WORKQ)
+static K_KERNEL_STACK_DEFINE(smp_workq_stack, CONFIG_BT_SMP_WORKQ_STACK_SIZE);
+static struct k_work_q smp_workq;
+static bool smp_workq_started;
+
+/* Serializes the SMP contexts between the PDU handlers, which run in the SMP
+ * work queue, and the entry points called from other contexts.
+ */
+static K_MUTEX_DEFINE(smp_mutex);
+
+static void smp_lock(void)
+{
+	(void)k_mutex_lock(&smp_mutex, K_FOREVER);
+}
+
+static void smp_unlock(void)
+{
+	(void)k_mutex_unlock(&smp_mutex);
+}
+
+/* Process the PDUs received so far before an event of the RX context that
+ * depends on them, e.g. an LTK request following a Pairing Random.
+ */
+static void smp_rx_flush(struct bt_smp *smp)
+{
+	struct k_work_sync sync;
+
+	/* Nothing to wait for when called by a PDU handler */
+	if (k_current_get() == &smp_workq.thread) {
+		return;
+	}
+
+	(void)k_work_flush(&smp->rx_work, &sync);
+}
+#else
+static inline void smp_lock(void)
+{
+}
+
+static inline void smp_unlock(void)
+{
+}
+
+static inline void smp_rx_flush(struct bt_smp *smp)
+{
+}
+#endif /* CONFIG_BT_SMP_WORKQ */
+
 /* Pointer to internal data is used to mark that callbacks of given SMP channel are not initialized.
  * Value of NULL represents no authenticaiton capabilities and cannot be used for that purpose.
  */
@@ -1737,12 +1796,16 @@ static void smp_timeout(struct k_work *work)
 
 	LOG_ERR("SMP Timeout");
 
+	smp_lock();
+
 	smp_pairing_complete(smp, BT_SMP_ERR_UNSPECIFIED);
 
 	/* smp_pairing_complete clears flags so setting timeout flag must come
 	 * after it.
 	 */
 	atomic_set_bit(smp->flags, SMP_FLAG_TIMEOUT);
+
+	smp_unlock();
 }
 
 static void smp_send(struct bt_smp *smp, struct net_buf *buf,
@@ -2683,16 +2746,11 @@ static struct bt_smp *smp_chan_get(struct bt_conn *conn)
 	return CONTAINER_OF(chan, struct bt_smp, chan.chan);
 }
 
-bool bt_smp_request_ltk(struct bt_conn *conn, uint64_t rand, uint16_t ediv, uint8_t *ltk)
+static bool smp_request_ltk(struct bt_smp *smp, struct bt_conn *conn, uint64_t rand,
+			    uint16_t ediv, uint8_t *ltk)
 {
-	struct bt_smp *smp;
 	uint8_t enc_size;
 
-	smp = smp_chan_get(conn);
-	if (!smp) {
-		return false;
-	}
-
 	/*
 	 * Both legacy STK and LE SC LTK have rand and ediv equal to zero.
 	 * If pairing is in progress use the TK for encryption.
@@ -2768,6 +2826,25 @@ bool bt_smp_request_ltk(struct bt_conn *conn, uint64_t rand, uint16_t ediv, uint
 	return false;
 }
 
+bool bt_smp_request_ltk(struct bt_conn *conn, uint64_t rand, uint16_t ediv, uint8_t *ltk)
+{
+	struct bt_smp *smp;
+	bool ret;
+
+	smp = smp_chan_get(conn);
+	if (!smp) {
+		return false;
+	}
+
+	smp_rx_flush(smp);
+
+	smp_lock();
+	ret = smp_request_ltk(smp, conn, rand, ediv, ltk);
+	smp_unlock();
+
+	return ret;
+}
+
 #if defined(CONFIG_BT_PERIPHERAL)
 static int smp_send_security_req(struct bt_conn *conn)
 {
@@ -3468,6 +3545,8 @@ static void bt_smp_dhkey_ready(const uint8_t *dhkey)
 	LOG_DBG("%p", (void *)dhkey);
 	int err;
 
+	smp_lock();
+
 	struct bt_smp *smp = smp_find(SMP_FLAG_DHKEY_GEN);
 	if (smp) {
 		atomic_clear_bit(smp->flags, SMP_FLAG_DHKEY_GEN);
@@ -3487,6 +3566,8 @@ static void bt_smp_dhkey_ready(const uint8_t *dhkey)
 			}
 		}
 	} while (smp && err);
+
+	smp_unlock();
 }
 
 static uint8_t sc_smp_check_confirm(struct bt_smp *smp)
@@ -4452,9 +4533,8 @@ static bool is_in_pairing_procedure(struct bt_smp *smp)
 	return atomic_test_bit(smp->flags, SMP_FLAG_PAIRING);
 }
 
-static int bt_smp_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+static int smp_recv(struct bt_smp *smp, struct net_buf *buf)
 {
-	struct bt_smp *smp = CONTAINER_OF(chan, struct bt_smp, chan.chan);
 	struct bt_smp_hdr *hdr;
 	uint8_t err;
 
@@ -4515,6 +4595,68 @@ static int bt_smp_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
 	return 0;
 }
 
+#if defined(CONFIG_BT_SMP_WORKQ)
+static void smp_rx_work(struct k_work *work)
+{
+	struct bt_smp *smp = CONTAINER_OF(work, struct bt_smp, rx_work);
+	struct net_buf *buf;
+
+	while ((buf = net_buf_get(&smp->rx_queue, K_NO_WAIT))) {
+		smp_lock();
+		(void)smp_recv(smp, buf);
+		smp_unlock();
+
+		atomic_dec(&smp->rx_queued);
+		net_buf_unref(buf);
+	}
+}
+
+static void smp_rx_cancel(struct bt_smp *smp)
+{
+	struct k_work_sync sync;
+	struct net_buf *buf;
+
+	if (k_current_get() == &smp_workq.thread) {
+		(void)k_work_cancel(&smp->rx_work);
+	} else {
+		(void)k_work_cancel_sync(&smp->rx_work, &sync);
+	}
+
+	while ((buf = net_buf_get(&smp->rx_queue, K_NO_WAIT))) {
+		net_buf_unref(buf);
+	}
+
+	atomic_clear(&smp->rx_queued);
+}
+#endif /* CONFIG_BT_SMP_WORKQ */
+
+static int bt_smp_recv(struct bt_l2cap_chan *chan, struct net_buf *buf)
+{
+	struct bt_smp *smp = CONTAINER_OF(chan, struct bt_smp, chan.chan);
+
+#if defined(CONFIG_BT_SMP_WORKQ)
+	/* SMP is a request/response protocol: a peer sending more PDUs
+	 * than the key distribution needs is not waiting for our responses.
+	 * Do not let it hold the ACL RX buffers.
+	 */
+	if (atomic_inc(&smp->rx_queued) >= CONFIG_BT_SMP_WORKQ_RX_MAX) {
+		atomic_dec(&smp->rx_queued);
+		LOG_WRN("Too many SMP PDUs queued, dropping");
+		return 0;
+	}
+
+	/* The pairing cryptography runs in the SMP work queue, PDUs of a
+	 * connection are processed in order of reception.
+	 */
+	net_buf_put(&smp->rx_queue, net_buf_ref(buf));
+	(void)k_work_submit_to_queue(&smp_workq, &smp->rx_work);
+
+	return 0;
+#else
+	return smp_recv(smp, buf);
+#endif /* CONFIG_BT_SMP_WORKQ */
+}
+
 static void bt_smp_pkey_ready(const uint8_t *pkey)
 {
 	int i;
@@ -4530,6 +4672,8 @@ static void bt_smp_pkey_ready(const uint8_t *pkey)
 
 	k_sem_give(&sc_local_pkey_ready);
 
+	smp_lock();
+
 	for (i = 0; i < ARRAY_SIZE(bt_smp_pool); i++) {
 		struct bt_smp *smp = &bt_smp_pool[i];
 		uint8_t err;
@@ -4557,6 +4701,8 @@ static void bt_smp_pkey_ready(const uint8_t *pkey)
 		}
 #endif /* CONFIG_BT_PERIPHERAL */
 	}
+
+	smp_unlock();
 }
 
 static void bt_smp_connected(struct bt_l2cap_chan *chan)
@@ -4567,6 +4713,10 @@ static void bt_smp_connected(struct bt_l2cap_chan *chan)
 		CONTAINER_OF(chan, struct bt_l2cap_le_chan, chan)->tx.cid);
 
 	k_work_init_delayable(&smp->work, smp_timeout);
+#if defined(CONFIG_BT_SMP_WORKQ)
+	k_fifo_init(&smp->rx_queue);
+	k_work_init(&smp->rx_work, smp_rx_work);
+#endif /* CONFIG_BT_SMP_WORKQ */
 	smp_reset(smp);
 
 	atomic_ptr_set(&smp->auth_cb, BT_SMP_AUTH_CB_UNINITIALIZED);
@@ -4586,6 +4736,13 @@ static void bt_smp_disconnected(struct bt_l2cap_chan *chan)
 	 */
 	(void)k_work_cancel_delayable(&smp->work);
 
+#if defined(CONFIG_BT_SMP_WORKQ)
+	/* Wait for a PDU being processed, and drop the others */
+	smp_rx_cancel(smp);
+#endif /* CONFIG_BT_SMP_WORKQ */
+
+	smp_lock();
+
 	if (atomic_test_bit(smp->flags, SMP_FLAG_PAIRING) ||
 	    atomic_test_bit(smp->flags, SMP_FLAG_ENC_PENDING) ||
 	    atomic_test_bit(smp->flags, SMP_FLAG_SEC_REQ)) {
@@ -4605,17 +4762,12 @@ static void bt_smp_disconnected(struct bt_l2cap_chan *chan)
 	}
 
 	(void)memset(smp, 0, sizeof(*smp));
+
+	smp_unlock();
 }
 
-static void bt_smp_encrypt_change(struct bt_l2cap_chan *chan,
-				  uint8_t hci_status)
+static void smp_encrypt_change(struct bt_smp *smp, struct bt_conn *conn, uint8_t hci_status)
 {
-	struct bt_smp *smp = CONTAINER_OF(chan, struct bt_smp, chan.chan);
-	struct bt_conn *conn = chan->conn;
-
-	LOG_DBG("chan %p conn %p handle %u encrypt 0x%02x hci status 0x%02x", chan, conn,
-		conn->handle, conn->encrypt, hci_status);
-
 	if (!atomic_test_and_clear_bit(smp->flags, SMP_FLAG_ENC_PENDING)) {
 		/* We where not waiting for encryption procedure.
 		 * This happens when encrypt change is called to notify that
@@ -4733,6 +4885,22 @@ static void bt_smp_encrypt_change(struct bt_l2cap_chan *chan,
 	}
 }
 
+static void bt_smp_encrypt_change(struct bt_l2cap_chan *chan,
+				  uint8_t hci_status)
+{
+	struct bt_smp *smp = CONTAINER_OF(chan, struct bt_smp, chan.chan);
+	struct bt_conn *conn = chan->conn;
+
+	LOG_DBG("chan %p conn %p handle %u encrypt 0x%02x hci status 0x%02x", chan, conn,
+		conn->handle, conn->encrypt, hci_status);
+
+	smp_rx_flush(smp);
+
+	smp_lock();
+	smp_encrypt_change(smp, conn, hci_status);
+	smp_unlock();
+}
+
 #if defined(CONFIG_BT_SIGNING) || defined(CONFIG_BT_SMP_SELFTEST)
 /* Sign message using msg as a buffer, len is a size of the message,
  * msg buffer contains message itself, 32 bit count and signature,
@@ -5377,7 +5545,7 @@ static int smp_send_keypress_notif(struct bt_smp *smp, uint8_t type)
 #endif
 
 #if defined(CONFIG_BT_PASSKEY_KEYPRESS)
-int bt_smp_auth_keypress_notify(struct bt_conn *conn, enum bt_conn_auth_keypress type)
+static int smp_auth_keypress_notify(struct bt_conn *conn, enum bt_conn_auth_keypress type)
 {
 	struct bt_smp *smp;
 
@@ -5401,9 +5569,20 @@ int bt_smp_auth_keypress_notify(struct bt_conn *conn, enum bt_conn_auth_keypress
 
 	return smp_send_keypress_notif(smp, type);
 }
+
+int bt_smp_auth_keypress_notify(struct bt_conn *conn, enum bt_conn_auth_keypress type)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_auth_keypress_notify(conn, type);
+	smp_unlock();
+
+	return ret;
+}
 #endif
 
-int bt_smp_auth_passkey_entry(struct bt_conn *conn, unsigned int passkey)
+static int smp_auth_passkey_entry(struct bt_conn *conn, unsigned int passkey)
 {
 	struct bt_smp *smp;
 	uint8_t err;
@@ -5450,7 +5629,18 @@ int bt_smp_auth_passkey_entry(struct bt_conn *conn, unsigned int passkey)
 	return 0;
 }
 
-int bt_smp_auth_passkey_confirm(struct bt_conn *conn)
+int bt_smp_auth_passkey_entry(struct bt_conn *conn, unsigned int passkey)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_auth_passkey_entry(conn, passkey);
+	smp_unlock();
+
+	return ret;
+}
+
+static int smp_auth_passkey_confirm(struct bt_conn *conn)
 {
 	struct bt_smp *smp;
 
@@ -5499,8 +5689,19 @@ int bt_smp_auth_passkey_confirm(struct bt_conn *conn)
 	return 0;
 }
 
+int bt_smp_auth_passkey_confirm(struct bt_conn *conn)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_auth_passkey_confirm(conn);
+	smp_unlock();
+
+	return ret;
+}
+
 #if !defined(CONFIG_BT_SMP_SC_PAIR_ONLY)
-int bt_smp_le_oob_set_tk(struct bt_conn *conn, const uint8_t *tk)
+static int smp_le_oob_set_tk(struct bt_conn *conn, const uint8_t *tk)
 {
 	struct bt_smp *smp;
 
@@ -5528,6 +5729,17 @@ int bt_smp_le_oob_set_tk(struct bt_conn *conn, const uint8_t *tk)
 
 	return 0;
 }
+
+int bt_smp_le_oob_set_tk(struct bt_conn *conn, const uint8_t *tk)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_le_oob_set_tk(conn, tk);
+	smp_unlock();
+
+	return ret;
+}
 #endif /* !defined(CONFIG_BT_SMP_SC_PAIR_ONLY) */
 
 int bt_smp_le_oob_generate_sc_data(struct bt_le_oob_sc_data *le_sc_oob)
@@ -5621,9 +5833,9 @@ static int le_sc_oob_pairing_continue(struct bt_smp *smp)
 	return smp_send_pairing_random(smp);
 }
 
-int bt_smp_le_oob_set_sc_data(struct bt_conn *conn,
-			      const struct bt_le_oob_sc_data *oobd_local,
-			      const struct bt_le_oob_sc_data *oobd_remote)
+static int smp_le_oob_set_sc_data(struct bt_conn *conn,
+				  const struct bt_le_oob_sc_data *oobd_local,
+				  const struct bt_le_oob_sc_data *oobd_remote)
 {
 	struct bt_smp *smp;
 
@@ -5647,6 +5859,19 @@ int bt_smp_le_oob_set_sc_data(struct bt_conn *conn,
 	return le_sc_oob_pairing_continue(smp);
 }
 
+int bt_smp_le_oob_set_sc_data(struct bt_conn *conn,
+			      const struct bt_le_oob_sc_data *oobd_local,
+			      const struct bt_le_oob_sc_data *oobd_remote)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_le_oob_set_sc_data(conn, oobd_local, oobd_remote);
+	smp_unlock();
+
+	return ret;
+}
+
 int bt_smp_le_oob_get_sc_data(struct bt_conn *conn,
 			      const struct bt_le_oob_sc_data **oobd_local,
 			      const struct bt_le_oob_sc_data **oobd_remote)
@@ -5674,7 +5899,7 @@ int bt_smp_le_oob_get_sc_data(struct bt_conn *conn,
 }
 #endif /* !CONFIG_BT_SMP_OOB_LEGACY_PAIR_ONLY */
 
-int bt_smp_auth_cancel(struct bt_conn *conn)
+static int smp_auth_cancel(struct bt_conn *conn)
 {
 	struct bt_smp *smp;
 
@@ -5706,8 +5931,19 @@ int bt_smp_auth_cancel(struct bt_conn *conn)
 	}
 }
 
+int bt_smp_auth_cancel(struct bt_conn *conn)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_auth_cancel(conn);
+	smp_unlock();
+
+	return ret;
+}
+
 #if !defined(CONFIG_BT_SMP_SC_PAIR_ONLY)
-int bt_smp_auth_pairing_confirm(struct bt_conn *conn)
+static int smp_auth_pairing_confirm(struct bt_conn *conn)
 {
 	struct bt_smp *smp;
 
@@ -5752,6 +5988,17 @@ int bt_smp_auth_pairing_confirm(struct bt_conn *conn)
 
 	return 0;
 }
+
+int bt_smp_auth_pairing_confirm(struct bt_conn *conn)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_auth_pairing_confirm(conn);
+	smp_unlock();
+
+	return ret;
+}
 #else
 int bt_smp_auth_pairing_confirm(struct bt_conn *conn)
 {
@@ -5777,7 +6024,7 @@ int bt_passkey_set(unsigned int passkey)
 }
 #endif /* CONFIG_BT_FIXED_PASSKEY */
 
-int bt_smp_start_security(struct bt_conn *conn)
+static int smp_start_security(struct bt_conn *conn)
 {
 	switch (conn->role) {
 #if defined(CONFIG_BT_CENTRAL)
@@ -5829,7 +6076,18 @@ int bt_smp_start_security(struct bt_conn *conn)
 	}
 }
 
-void bt_smp_update_keys(struct bt_conn *conn)
+int bt_smp_start_security(struct bt_conn *conn)
+{
+	int ret;
+
+	smp_lock();
+	ret = smp_start_security(conn);
+	smp_unlock();
+
+	return ret;
+}
+
+static void smp_update_keys(struct bt_conn *conn)
 {
 	struct bt_smp *smp;
 
@@ -5914,6 +6172,13 @@ void bt_smp_update_keys(struct bt_conn *conn)
 	}
 }
 
+void bt_smp_update_keys(struct bt_conn *conn)
+{
+	smp_lock();
+	smp_update_keys(conn);
+	smp_unlock();
+}
+
 static int bt_smp_accept(struct bt_conn *conn, struct bt_l2cap_chan **chan)
 {
 	int i;
@@ -5974,5 +6239,16 @@ int bt_smp_init(void)
 		bt_pub_key_gen(&pub_key_cb);
 	}
 
+#if defined(CONFIG_BT_SMP_WORKQ)
+	/* The work queue is kept across bt_disable() */
+	if (!smp_workq_started) {
+		k_work_queue_start(&smp_workq, smp_workq_stack,
+				   K_KERNEL_STACK_SIZEOF(smp_workq_stack),
+				   CONFIG_BT_SMP_WORKQ_PRIO, NULL);
+		k_thread_name_set(&smp_workq.thread, "BT SMP WQ");
+		smp_workq_started = true;
+	}
+#endif /* CONFIG_BT_SMP_WORKQ */
+
 	return smp_self_test();
 }
@@ -0,0 +1,384 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/bluetooth/ead.h>
+#include <zephyr/bluetooth/bluetooth.h>
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/sys/slist.h>
+
+#include "common/bt_str.h"
+
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bt_ead_scan, CONFIG_BT_EAD_LOG_LEVEL);
+
+#define EAD_SCAN_PAYLOAD_MAX BT_EAD_DECRYPTED_PAYLOAD_SIZE(CONFIG_BT_EAD_SCAN_PAYLOAD_MAX)
+
+struct ead_scan_key {
+	bt_addr_le_t addr;
+	uint8_t session_key[BT_EAD_KEY_SIZE];
+	uint8_t iv[BT_EAD_IV_SIZE];
+	bool valid;
+};
+
+/* Identifies an encrypted payload of an advertiser. The Randomizer is
+ * renewed for every new payload, and the MIC depends on the whole payload.
+ */
+struct ead_scan_tag {
+	uint8_t key_id;
+	uint8_t randomizer[BT_EAD_RANDOMIZER_SIZE];
+	uint8_t mic[BT_EAD_MIC_SIZE];
+};
+
+struct ead_scan_job {
+	bt_addr_le_t addr;
+	int8_t rssi;
+	uint8_t key_id;
+	uint8_t len;
+	uint8_t data[CONFIG_BT_EAD_SCAN_PAYLOAD_MAX];
+};
+
+static struct ead_scan_key keys[CONFIG_BT_EAD_SCAN_MAX_KEYS];
+
+/* Tags of the payloads queued or decrypted, oldest overwritten first. */
+static struct ead_scan_tag tags[CONFIG_BT_EAD_SCAN_CACHE_SIZE];
+static uint8_t tags_count;
+static uint8_t tags_next;
+
+static struct k_spinlock lock;
+
+static sys_slist_t callbacks = SYS_SLIST_STATIC_INIT(&callbacks);
+
+K_MSGQ_DEFINE(job_msgq, sizeof(struct ead_scan_job), CONFIG_BT_EAD_SCAN_QUEUE_SIZE, 1);
+
+/* Must be called with the lock held. */
+static int key_find(const bt_addr_le_t *addr)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+		if (keys[i].valid && bt_addr_le_eq(&keys[i].addr, addr)) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+/* Must be called with the lock held. */
+static struct ead_scan_tag *tag_find(const struct ead_scan_tag *tag)
+{
+	for (uint8_t i = 0; i < tags_count; i++) {
+		if (!memcmp(&tags[i], tag, sizeof(*tag))) {
+			return &tags[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Returns false if the tag was already known. */
+static bool tag_add(const struct ead_scan_tag *tag)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	bool added = false;
+
+	if (!tag_find(tag)) {
+		tags[tags_next] = *tag;
+		tags_next = (tags_next + 1) % ARRAY_SIZE(tags);
+		if (tags_count < ARRAY_SIZE(tags)) {
+			tags_count++;
+		}
+
+		added = true;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return added;
+}
+
+static void tag_remove(const struct ead_scan_tag *tag)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	struct ead_scan_tag *entry;
+
+	/* Forget the tag without changing the age of the other entries, the
+	 * slot is reused when its turn comes.
+	 */
+	entry = tag_find(tag);
+	if (entry) {
+		(void)memset(entry, 0, sizeof(*entry));
+		entry->key_id = UINT8_MAX;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+/* Must be called with the lock held. */
+static void tags_flush(uint8_t key_id)
+{
+	for (uint8_t i = 0; i < tags_count; i++) {
+		if (tags[i].key_id == key_id) {
+			tags[i].key_id = UINT8_MAX;
+		}
+	}
+}
+
+int bt_ead_scan_key_add(const bt_addr_le_t *addr, const uint8_t session_key[BT_EAD_KEY_SIZE],
+			const uint8_t iv[BT_EAD_IV_SIZE])
+{
+	k_spinlock_key_t key;
+	int id;
+
+	CHECKIF(addr == NULL || session_key == NULL || iv == NULL) {
+		LOG_DBG("Invalid parameters");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	id = key_find(addr);
+	if (id < 0) {
+		for (size_t i = 0; i < ARRAY_SIZE(keys); i++) {
+			if (!keys[i].valid) {
+				id = i;
+				break;
+			}
+		}
+	}
+
+	if (id >= 0) {
+		bt_addr_le_copy(&keys[id].addr, addr);
+		memcpy(keys[id].session_key, session_key, BT_EAD_KEY_SIZE);
+		memcpy(keys[id].iv, iv, BT_EAD_IV_SIZE);
+		keys[id].valid = true;
+
+		/* Payloads seen with the previous key material are no proof of
+		 * anything with the new one.
+		 */
+		tags_flush(id);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return id < 0 ? -ENOMEM : 0;
+}
+
+int bt_ead_scan_key_remove(const bt_addr_le_t *addr)
+{
+	k_spinlock_key_t key;
+	int id;
+
+	CHECKIF(addr == NULL) {
+		LOG_DBG("addr is NULL");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	id = key_find(addr);
+	if (id >= 0) {
+		(void)memset(&keys[id], 0, sizeof(keys[id]));
+		tags_flush(id);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return id < 0 ? -ENOENT : 0;
+}
+
+struct ead_scan_parse {
+	const bt_addr_le_t *addr;
+	int8_t rssi;
+	uint8_t key_id;
+	int queued;
+};
+
+static bool ead_scan_parse_cb(struct bt_data *data, void *user_data)
+{
+	struct ead_scan_parse *parse = user_data;
+	struct ead_scan_tag tag;
+	struct ead_scan_job job;
+
+	if (data->type != BT_DATA_ENCRYPTED_AD_DATA) {
+		return true;
+	}
+
+	if (data->data_len < BT_EAD_RANDOMIZER_SIZE + BT_EAD_MIC_SIZE ||
+	    data->data_len > CONFIG_BT_EAD_SCAN_PAYLOAD_MAX) {
+		LOG_DBG("Unsupported encrypted data size %u", data->data_len);
+		return true;
+	}
+
+	tag.key_id = parse->key_id;
+	memcpy(tag.randomizer, data->data, BT_EAD_RANDOMIZER_SIZE);
+	memcpy(tag.mic, &data->data[data->data_len - BT_EAD_MIC_SIZE], BT_EAD_MIC_SIZE);
+
+	if (!tag_add(&tag)) {
+		/* Already queued or decrypted */
+		return true;
+	}
+
+	bt_addr_le_copy(&job.addr, parse->addr);
+	job.rssi = parse->rssi;
+	job.key_id = parse->key_id;
+	job.len = data->data_len;
+	memcpy(job.data, data->data, data->data_len);
+
+	if (k_msgq_put(&job_msgq, &job, K_NO_WAIT)) {
+		LOG_DBG("Decryption queue full");
+		/* Let a later copy of the payload through */
+		tag_remove(&tag);
+		return true;
+	}
+
+	parse->queued++;
+
+	return true;
+}
+
+int bt_ead_scan_process(const bt_addr_le_t *addr, int8_t rssi, struct net_buf_simple *ad)
+{
+	struct ead_scan_parse parse = {
+		.addr = addr,
+		.rssi = rssi,
+	};
+	struct net_buf_simple_state state;
+	k_spinlock_key_t key;
+	int id;
+
+	CHECKIF(addr == NULL || ad == NULL) {
+		LOG_DBG("Invalid parameters");
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+	id = key_find(addr);
+	k_spin_unlock(&lock, key);
+
+	if (id < 0) {
+		return 0;
+	}
+
+	parse.key_id = id;
+
+	net_buf_simple_save(ad, &state);
+	bt_data_parse(ad, ead_scan_parse_cb, &parse);
+	net_buf_simple_restore(ad, &state);
+
+	return parse.queued;
+}
+
+static void ead_scan_job_process(const struct ead_scan_job *job)
+{
+	static uint8_t payload[EAD_SCAN_PAYLOAD_MAX];
+	uint8_t session_key[BT_EAD_KEY_SIZE];
+	uint8_t iv[BT_EAD_IV_SIZE];
+	struct net_buf_simple_state state;
+	struct bt_ead_scan_cb *cb;
+	struct net_buf_simple ad;
+	k_spinlock_key_t key;
+	bool valid;
+	int err;
+
+	key = k_spin_lock(&lock);
+
+	/* The key material may have been removed or replaced meanwhile */
+	valid = keys[job->key_id].valid && bt_addr_le_eq(&keys[job->key_id].addr, &job->addr);
+	if (valid) {
+		memcpy(session_key, keys[job->key_id].session_key, sizeof(session_key));
+		memcpy(iv, keys[job->key_id].iv, sizeof(iv));
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (!valid) {
+		return;
+	}
+
+	err = bt_ead_decrypt(session_key, iv, job->data, job->len, payload);
+	(void)memset(session_key, 0, sizeof(session_key));
+
+	if (err) {
+		struct ead_scan_tag tag;
+
+		LOG_DBG("Failed to decrypt data from %s (err %d)", bt_addr_le_str(&job->addr),
+			err);
+
+		/* A forged payload must not hide the genuine one */
+		tag.key_id = job->key_id;
+		memcpy(tag.randomizer, job->data, BT_EAD_RANDOMIZER_SIZE);
+		memcpy(tag.mic, &job->data[job->len - BT_EAD_MIC_SIZE], BT_EAD_MIC_SIZE);
+		tag_remove(&tag);
+		return;
+	}
+
+	net_buf_simple_init_with_data(&ad, payload, BT_EAD_DECRYPTED_PAYLOAD_SIZE(job->len));
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&callbacks, cb, node) {
+		net_buf_simple_save(&ad, &state);
+		cb->recv(&job->addr, job->rssi, &ad);
+		net_buf_simple_restore(&ad, &state);
+	}
+}
+
+static void ead_scan_thread(void *p1, void *p2, void *p3)
+{
+	static struct ead_scan_job job;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&job_msgq, &job, K_FOREVER);
+
+		ead_scan_job_process(&job);
+	}
+}
+
+K_THREAD_DEFINE(ead_scan_tid, CONFIG_BT_EAD_SCAN_STACK_SIZE, ead_scan_thread, NULL, NULL, NULL,
+		CONFIG_BT_EAD_SCAN_THREAD_PRIO, 0, 0);
+
+static void scan_recv(const struct bt_le_scan_recv_info *info, struct net_buf_simple *buf)
+{
+	(void)bt_ead_scan_process(info->addr, info->rssi, buf);
+}
+
+static struct bt_le_scan_cb scan_cb = {
+	.recv = scan_recv,
+};
+
+int bt_ead_scan_cb_register(struct bt_ead_scan_cb *cb)
+{
+	static bool scan_cb_registered;
+	struct bt_ead_scan_cb *tmp;
+
+	CHECKIF(cb == NULL) {
+		LOG_DBG("cb is NULL");
+		return -EINVAL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&callbacks, tmp, node) {
+		if (tmp == cb) {
+			return -EEXIST;
+		}
+	}
+
+	if (!scan_cb_registered) {
+		bt_le_scan_cb_register(&scan_cb);
+		scan_cb_registered = true;
+	}
+
+	sys_slist_append(&callbacks, &cb->node);
+
+	return 0;
+}
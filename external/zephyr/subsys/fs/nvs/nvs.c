@@ -19,9 +19,7 @@ LOG_MODULE_REGISTER(fs_nvs, CONFIG_NVS_LOG_LEVEL);
 static int nvs_prev_ate(struct nvs_fs *fs, uint32_t *addr, struct nvs_ate *ate);
 static int nvs_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-
-static inline size_t nvs_lookup_cache_pos(uint16_t id)
+static inline uint16_t nvs_id_hash(uint16_t id)
 {
 	uint16_t hash;
 
@@ -33,7 +31,14 @@ static inline size_t nvs_lookup_cache_pos(uint16_t id)
 	hash *= 0xdb2dU;
 	hash ^= hash >> 9;
 
-	return hash % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return nvs_id_hash(id) % CONFIG_NVS_LOOKUP_CACHE_SIZE;
 }
 
 static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
@@ -84,6 +89,143 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_ID_INDEX
+
+/* The ID index is an open addressing hash table with linear probing. One entry
+ * is always left free so that the probing of an ID not in the index ends.
+ */
+
+static void nvs_id_index_clear(struct nvs_fs *fs)
+{
+	memset(fs->id_index_addr, 0xff, sizeof(fs->id_index_addr));
+	fs->id_index_cnt = 0U;
+	fs->id_index_overflow = false;
+}
+
+/* Position of the ID in the index, or of the free entry it would be added at */
+static size_t nvs_id_index_pos(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_id_hash(id) % CONFIG_NVS_ID_INDEX_SIZE;
+
+	while ((fs->id_index_addr[pos] != NVS_ID_INDEX_NO_ADDR) &&
+	       (fs->id_index_id[pos] != id)) {
+		pos = (pos + 1) % CONFIG_NVS_ID_INDEX_SIZE;
+	}
+
+	return pos;
+}
+
+/* Address of the most recent ATE of the ID, or NVS_ID_INDEX_NO_ADDR if the ID
+ * has no entry. IDs that did not fit in the index are looked up from the
+ * newest ATE.
+ */
+static uint32_t nvs_id_index_get(struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_id_index_pos(fs, id);
+
+	if (fs->id_index_addr[pos] != NVS_ID_INDEX_NO_ADDR) {
+		return fs->id_index_addr[pos];
+	}
+
+	return fs->id_index_overflow ? fs->ate_wra : NVS_ID_INDEX_NO_ADDR;
+}
+
+static void nvs_id_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	size_t pos = nvs_id_index_pos(fs, id);
+
+	if (fs->id_index_addr[pos] == NVS_ID_INDEX_NO_ADDR) {
+		if (fs->id_index_cnt == (CONFIG_NVS_ID_INDEX_SIZE - 1)) {
+			fs->id_index_overflow = true;
+			return;
+		}
+
+		fs->id_index_id[pos] = id;
+		fs->id_index_cnt++;
+	}
+
+	fs->id_index_addr[pos] = addr;
+}
+
+/* Remove the entry at pos, moving back the entries of its probe sequence */
+static void nvs_id_index_remove(struct nvs_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	while (true) {
+		next = (next + 1) % CONFIG_NVS_ID_INDEX_SIZE;
+		if (fs->id_index_addr[next] == NVS_ID_INDEX_NO_ADDR) {
+			break;
+		}
+
+		/* The entry can fill the hole unless its home position lies
+		 * cyclically in (pos, next].
+		 */
+		home = nvs_id_hash(fs->id_index_id[next]) % CONFIG_NVS_ID_INDEX_SIZE;
+		if ((next > pos) ? ((home <= pos) || (home > next)) :
+				   ((home <= pos) && (home > next))) {
+			fs->id_index_id[pos] = fs->id_index_id[next];
+			fs->id_index_addr[pos] = fs->id_index_addr[next];
+			pos = next;
+		}
+	}
+
+	fs->id_index_addr[pos] = NVS_ID_INDEX_NO_ADDR;
+	fs->id_index_cnt--;
+}
+
+static int nvs_id_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	nvs_id_index_clear(fs);
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		/* ATEs are walked from the newest, keep the first one found */
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate) &&
+		    fs->id_index_addr[nvs_id_index_pos(fs, ate.id)] == NVS_ID_INDEX_NO_ADDR) {
+			nvs_id_index_set(fs, ate.id, ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* The most recent ATEs left in an erased sector are deletes, drop their IDs */
+static void nvs_id_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	size_t pos = 0;
+
+	while (pos < CONFIG_NVS_ID_INDEX_SIZE) {
+		if ((fs->id_index_addr[pos] != NVS_ID_INDEX_NO_ADDR) &&
+		    ((fs->id_index_addr[pos] >> ADDR_SECT_SHIFT) == sector)) {
+			/* An entry moved back to pos has to be checked too */
+			nvs_id_index_remove(fs, pos);
+			continue;
+		}
+
+		pos++;
+	}
+}
+
+#endif /* CONFIG_NVS_ID_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -168,6 +310,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_NVS_ID_INDEX
+	if (entry->id != 0xFFFF) {
+		nvs_id_index_set(fs, entry->id, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -301,6 +448,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_ID_INDEX
+	nvs_id_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -556,6 +706,56 @@ static int nvs_sector_close(struct nvs_fs *fs)
 
 	fs->data_wra = fs->ate_wra & ADDR_SECT_MASK;
 
+#ifdef CONFIG_NVS_GC_STEP
+	/* The sector to garbage collect next has changed */
+	fs->gc_step_addr = NVS_GC_STEP_NO_ADDR;
+#endif
+
+	return 0;
+}
+
+/* Find the most recent valid ATE of an id, walking from its lookup cache or
+ * ID index entry when available. addr is set to the address of that ATE.
+ */
+static int nvs_latest_ate_addr(struct nvs_fs *fs, uint16_t id, uint32_t *addr)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(id)];
+
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	wlk_addr = nvs_id_index_get(fs, id);
+
+	if (wlk_addr == NVS_ID_INDEX_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == id) && (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	*addr = wlk_prev_addr;
+
 	return 0;
 }
 
@@ -580,9 +780,9 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_prev_addr, data_addr,
+	      stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -626,31 +826,10 @@ static int nvs_gc(struct nvs_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
-
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
+		rc = nvs_latest_ate_addr(fs, gc_ate.id, &wlk_prev_addr);
+		if (rc) {
+			return rc;
 		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
 
 		/* if walk has reached the same address as gc_addr copy is
 		 * needed unless it is a deleted item.
@@ -715,6 +894,13 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_ID_INDEX
+	nvs_id_index_clear(fs);
+#endif
+#ifdef CONFIG_NVS_GC_STEP
+	fs->gc_step_addr = NVS_GC_STEP_NO_ADDR;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -868,6 +1054,15 @@ static int nvs_startup(struct nvs_fs *fs)
 		for (i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
 			fs->lookup_cache[i] = fs->ate_wra;
 		}
+#endif
+#ifdef CONFIG_NVS_ID_INDEX
+		/* The gc function needs the index, which would otherwise only
+		 * be built afterwards.
+		 */
+		rc = nvs_id_index_rebuild(fs);
+		if (rc) {
+			goto end;
+		}
 #endif
 		rc = nvs_gc(fs);
 		goto end;
@@ -908,6 +1103,11 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_NVS_ID_INDEX
+	if (!rc) {
+		rc = nvs_id_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -1037,6 +1237,12 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
 	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	wlk_addr = nvs_id_index_get(fs, id);
+
+	if (wlk_addr == NVS_ID_INDEX_NO_ADDR) {
+		goto no_cached_entry;
+	}
 #else
 	wlk_addr = fs->ate_wra;
 #endif
@@ -1057,7 +1263,7 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
+#if defined(CONFIG_NVS_LOOKUP_CACHE) || defined(CONFIG_NVS_ID_INDEX)
 no_cached_entry:
 #endif
 
@@ -1168,6 +1374,13 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		rc = -ENOENT;
 		goto err;
 	}
+#elif defined(CONFIG_NVS_ID_INDEX)
+	wlk_addr = nvs_id_index_get(fs, id);
+
+	if (wlk_addr == NVS_ID_INDEX_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
 #else
 	wlk_addr = fs->ate_wra;
 #endif
@@ -1267,3 +1480,116 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#ifdef CONFIG_NVS_GC_STEP
+int nvs_gc_step(struct nvs_fs *fs, k_timeout_t budget)
+{
+	int rc;
+	k_timepoint_t end = sys_timepoint_calc(budget);
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, close_addr, data_addr, latest_addr;
+	size_t ate_size;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* With two sectors the next sector to garbage collect is the write
+	 * sector itself.
+	 */
+	if (fs->sector_count < 3) {
+		return -ENOTSUP;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* When the write sector is full, nvs_gc() collects the sector after
+	 * the empty one that follows it.
+	 */
+	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &sec_addr);
+	nvs_sector_advance(fs, &sec_addr);
+	close_addr = sec_addr + fs->sector_size - ate_size;
+
+	if (fs->gc_step_addr == NVS_GC_STEP_NO_ADDR) {
+		rc = nvs_flash_ate_rd(fs, close_addr, &close_ate);
+		if (rc) {
+			goto end;
+		}
+
+		if (!nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value)) {
+			/* the sector is not closed, nothing to copy */
+			fs->gc_step_addr = close_addr;
+		} else if (nvs_close_ate_valid(fs, &close_ate)) {
+			fs->gc_step_addr = sec_addr + close_ate.offset;
+		} else {
+			fs->gc_step_addr = close_addr;
+			rc = nvs_recover_last_ate(fs, &fs->gc_step_addr);
+			if (rc) {
+				fs->gc_step_addr = NVS_GC_STEP_NO_ADDR;
+				goto end;
+			}
+		}
+	}
+
+	/* Walk the ATEs of the sector from the newest, as nvs_gc() does, and
+	 * copy the entries it would copy.
+	 */
+	while (fs->gc_step_addr != close_addr) {
+		rc = nvs_flash_ate_rd(fs, fs->gc_step_addr, &gc_ate);
+		if (rc) {
+			goto end;
+		}
+
+		if (nvs_ate_valid(fs, &gc_ate) && gc_ate.len) {
+			rc = nvs_latest_ate_addr(fs, gc_ate.id, &latest_addr);
+			if (rc) {
+				goto end;
+			}
+
+			if (latest_addr == fs->gc_step_addr) {
+				/* Same space requirement as nvs_write(), leave
+				 * the sector switch to it.
+				 */
+				if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate.len) +
+						   ate_size)) {
+					rc = -ENOSPC;
+					goto end;
+				}
+
+				LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+
+				data_addr = sec_addr + gc_ate.offset;
+
+				gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+				nvs_ate_crc8_update(&gc_ate);
+
+				rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
+				if (rc) {
+					goto end;
+				}
+
+				rc = nvs_flash_ate_wrt(fs, &gc_ate);
+				if (rc) {
+					goto end;
+				}
+			}
+		}
+
+		fs->gc_step_addr += ate_size;
+
+		if ((fs->gc_step_addr != close_addr) && sys_timepoint_expired(end)) {
+			rc = -EAGAIN;
+			goto end;
+		}
+	}
+
+	rc = 0;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif /* CONFIG_NVS_GC_STEP */
@@ -30,6 +30,10 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+#define NVS_ID_INDEX_NO_ADDR 0xFFFFFFFF
+
+#define NVS_GC_STEP_NO_ADDR 0xFFFFFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
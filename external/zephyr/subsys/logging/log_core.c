@@ -604,6 +604,11 @@ bool z_log_dropped_pending(void)
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		z_log_stage_init(buf32, ARRAY_SIZE(buf32));
+		return;
+	}
+
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
@@ -624,6 +629,10 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		return z_log_stage_alloc(wlen);
+	}
+
 	return msg_alloc(&log_buffer, wlen);
 }
 
@@ -646,6 +655,13 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		z_log_stage_commit(msg);
+		z_log_msg_post_finalize();
+		return;
+	}
+
 	msg_commit(&log_buffer, msg);
 }
 
@@ -730,6 +746,10 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 {
 	size_t len;
 
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		return z_log_stage_claim();
+	}
+
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
@@ -749,6 +769,11 @@ static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generi
 
 void z_log_msg_free(union log_msg_generic *msg)
 {
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		z_log_stage_free(msg);
+		return;
+	}
+
 	msg_free(curr_log_buffer, msg);
 }
 
@@ -766,6 +791,10 @@ bool z_log_msg_pending(void)
 	size_t len;
 	int i = 0;
 
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		return z_log_stage_pending();
+	}
+
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
@@ -848,6 +877,11 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		z_log_stage_get_usage(buf_size, usage);
+		return 0;
+	}
+
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
 	return 0;
@@ -861,6 +895,10 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		return -ENOTSUP;
+	}
+
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
 }
 
@@ -0,0 +1,233 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Lock-free staging of log messages.
+ *
+ * The log buffer is split into one ring per CPU, optionally doubled to give
+ * interrupt handlers a ring of their own. Producers reserve space in a ring by
+ * moving its write index with a compare-and-swap, build the message in place
+ * and commit it by setting the valid bit of its header. The log processing
+ * thread is the only consumer: it takes the oldest committed head among all
+ * rings, and zeroes messages it frees so that a reserved but not yet written
+ * slot always reads as not valid.
+ *
+ * Indexes run over twice the ring length so that a full ring can be told
+ * apart from an empty one.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/logging/log_msg.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#define RING_CNT (CONFIG_MP_MAX_NUM_CPUS * (IS_ENABLED(CONFIG_LOG_STAGING_ISR) ? 2 : 1))
+
+struct log_stage_ring {
+	uint32_t *buf;
+	atomic_t wr;
+	atomic_t rd;
+	atomic_t dropped;
+};
+
+static struct log_stage_ring rings[RING_CNT];
+static uint32_t ring_wlen;
+
+static inline uint32_t idx_add(uint32_t idx, uint32_t n)
+{
+	idx += n;
+
+	return (idx >= 2 * ring_wlen) ? idx - 2 * ring_wlen : idx;
+}
+
+static inline uint32_t idx_pos(uint32_t idx)
+{
+	return (idx >= ring_wlen) ? idx - ring_wlen : idx;
+}
+
+static inline uint32_t used_get(uint32_t wr, uint32_t rd)
+{
+	return (wr >= rd) ? wr - rd : wr + 2 * ring_wlen - rd;
+}
+
+static struct log_stage_ring *ring_get(void)
+{
+	uint32_t idx = 0;
+
+#if defined(CONFIG_SMP)
+	/* Migrating before the reservation is harmless, any producer may use
+	 * any ring, the CPU only picks the one least likely to be contended.
+	 */
+	idx = arch_curr_cpu()->id;
+#endif
+
+	if (IS_ENABLED(CONFIG_LOG_STAGING_ISR)) {
+		idx = 2 * idx + (k_is_in_isr() ? 1 : 0);
+	}
+
+	return &rings[idx];
+}
+
+static struct log_stage_ring *ring_of(const void *item)
+{
+	uint32_t off = (const uint32_t *)item - rings[0].buf;
+
+	return &rings[off / ring_wlen];
+}
+
+static void ring_release(struct log_stage_ring *ring, uint32_t rd, uint32_t wlen)
+{
+	memset(&ring->buf[idx_pos(rd)], 0, wlen * sizeof(uint32_t));
+
+	/* Zeroed content must be visible before the space is handed back. */
+	barrier_dmem_fence_full();
+	atomic_set(&ring->rd, idx_add(rd, wlen));
+}
+
+/* Return the committed message at the head of the ring, if any. */
+static union log_msg_generic *ring_peek(struct log_stage_ring *ring)
+{
+	while (true) {
+		uint32_t rd = atomic_get(&ring->rd);
+		union mpsc_pbuf_generic *item;
+
+		if (rd == (uint32_t)atomic_get(&ring->wr)) {
+			return NULL;
+		}
+
+		item = (union mpsc_pbuf_generic *)&ring->buf[idx_pos(rd)];
+		if (item->hdr.valid) {
+			barrier_dmem_fence_full();
+			return (union log_msg_generic *)item;
+		}
+
+		if (!item->hdr.busy) {
+			/* Reserved but not committed yet. */
+			return NULL;
+		}
+
+		ring_release(ring, rd, item->skip.len);
+	}
+}
+
+void z_log_stage_init(uint32_t *buf, size_t wlen)
+{
+	ring_wlen = wlen / RING_CNT;
+
+	memset(buf, 0, wlen * sizeof(uint32_t));
+	for (size_t i = 0; i < RING_CNT; i++) {
+		rings[i].buf = &buf[i * ring_wlen];
+		atomic_set(&rings[i].wr, 0);
+		atomic_set(&rings[i].rd, 0);
+		atomic_set(&rings[i].dropped, 0);
+	}
+}
+
+struct log_msg *z_log_stage_alloc(uint32_t wlen)
+{
+	struct log_stage_ring *ring = ring_get();
+	uint32_t wr, rd, pos, pad;
+
+	do {
+		wr = atomic_get(&ring->wr);
+		rd = atomic_get(&ring->rd);
+		pos = idx_pos(wr);
+
+		/* Messages are contiguous, skip the end of the ring if needed. */
+		pad = (ring_wlen - pos < wlen) ? ring_wlen - pos : 0;
+
+		if (used_get(wr, rd) + pad + wlen > ring_wlen) {
+			atomic_inc(&ring->dropped);
+			return NULL;
+		}
+	} while (!atomic_cas(&ring->wr, wr, idx_add(wr, pad + wlen)));
+
+	if (pad) {
+		union mpsc_pbuf_generic skip = {
+			.skip = { .valid = 0, .busy = 1, .len = pad }
+		};
+
+		ring->buf[pos] = skip.raw;
+		pos = 0;
+	}
+
+	return (struct log_msg *)&ring->buf[pos];
+}
+
+void z_log_stage_commit(struct log_msg *msg)
+{
+	union mpsc_pbuf_generic *item = (union mpsc_pbuf_generic *)msg;
+
+	/* Content must be visible before the message is marked as valid. */
+	barrier_dmem_fence_full();
+	item->hdr.valid = 1;
+}
+
+union log_msg_generic *z_log_stage_claim(void)
+{
+	union log_msg_generic *oldest = NULL;
+	log_timestamp_t t_min = 0;
+
+	for (size_t i = 0; i < RING_CNT; i++) {
+		union log_msg_generic *msg = ring_peek(&rings[i]);
+		log_timestamp_t t;
+
+		if (msg == NULL) {
+			continue;
+		}
+
+		t = log_msg_get_timestamp(&msg->log);
+		if ((oldest == NULL) || (t < t_min)) {
+			oldest = msg;
+			t_min = t;
+		}
+	}
+
+	return oldest;
+}
+
+void z_log_stage_free(union log_msg_generic *msg)
+{
+	struct log_stage_ring *ring = ring_of(msg);
+	uint32_t rd = atomic_get(&ring->rd);
+
+	__ASSERT_NO_MSG(&ring->buf[idx_pos(rd)] == (uint32_t *)msg);
+
+	ring_release(ring, rd, log_msg_generic_get_wlen(&msg->buf));
+}
+
+bool z_log_stage_pending(void)
+{
+	for (size_t i = 0; i < RING_CNT; i++) {
+		if (atomic_get(&rings[i].rd) != atomic_get(&rings[i].wr)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void z_log_stage_get_usage(uint32_t *buf_size, uint32_t *usage)
+{
+	*buf_size = RING_CNT * ring_wlen * sizeof(uint32_t);
+	*usage = 0;
+
+	for (size_t i = 0; i < RING_CNT; i++) {
+		*usage += used_get(atomic_get(&rings[i].wr), atomic_get(&rings[i].rd)) *
+			  sizeof(uint32_t);
+	}
+}
+
+uint32_t z_log_stage_ring_count(void)
+{
+	return RING_CNT;
+}
+
+uint32_t z_log_stage_dropped_get(uint32_t ring)
+{
+	__ASSERT_NO_MSG(ring < RING_CNT);
+
+	return atomic_get(&rings[ring].dropped);
+}
@@ -222,6 +222,61 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
+/* Attach data to a buffer just taken from its pool and reset its state.
+ * On failure buf->__buf is left NULL.
+ */
+static int buf_setup(struct net_buf *buf, size_t size, k_timeout_t timeout)
+{
+	if (size) {
+#if __ASSERT_ON
+		size_t req_size = size;
+#endif
+		buf->__buf = data_alloc(buf, &size, timeout);
+		if (!buf->__buf) {
+			return -ENOMEM;
+		}
+
+#if __ASSERT_ON
+		NET_BUF_ASSERT(req_size <= size);
+#endif
+	} else {
+		buf->__buf = NULL;
+	}
+
+	buf->ref   = 1U;
+	buf->flags = 0U;
+	buf->frags = NULL;
+	buf->size  = size;
+	net_buf_reset(buf);
+
+	return 0;
+}
+
+/* Return a list of buffers, linked through their node and with their
+ * data already released, to the free LIFO of their pool in one go.
+ */
+static void pool_free_list(struct net_buf_pool *pool, struct net_buf *head,
+			   struct net_buf *tail)
+{
+	if (head == NULL) {
+		return;
+	}
+
+	tail->node.next = NULL;
+	(void)k_queue_append_list(&pool->free._queue, head, tail);
+}
+
+/* Release the data of a buffer whose last reference was dropped */
+static void buf_data_unref(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	if (buf->__buf) {
+		if (!(buf->flags & NET_BUF_EXTERNAL_DATA)) {
+			pool->alloc->cb->unref(buf, buf->__buf);
+		}
+		buf->__buf = NULL;
+	}
+}
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -308,37 +363,157 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 success:
 	NET_BUF_DBG("allocated buf %p", buf);
 
-	if (size) {
-#if __ASSERT_ON
-		size_t req_size = size;
-#endif
-		timeout = sys_timepoint_timeout(end);
-		buf->__buf = data_alloc(buf, &size, timeout);
-		if (!buf->__buf) {
-			NET_BUF_ERR("%s():%d: Failed to allocate data",
-				    func, line);
-			net_buf_destroy(buf);
-			return NULL;
-		}
+	if (buf_setup(buf, size, sys_timepoint_timeout(end)) < 0) {
+		NET_BUF_ERR("%s():%d: Failed to allocate data", func, line);
+		net_buf_destroy(buf);
+		return NULL;
+	}
 
-#if __ASSERT_ON
-		NET_BUF_ASSERT(req_size <= size);
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+	atomic_dec(&pool->avail_count);
+	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
 #endif
-	} else {
+	return buf;
+}
+
+struct net_buf *net_buf_alloc_batch(struct net_buf_pool *pool, size_t size,
+				    size_t count, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+	struct net_buf *buf;
+	k_spinlock_key_t key;
+	sys_slist_t list;
+	size_t n = 0;
+
+	__ASSERT_NO_MSG(pool);
+
+	if (count == 0 || count > pool->buf_count) {
+		return NULL;
+	}
+
+	sys_slist_init(&list);
+
+	/* Take as many never used buffers as possible under a single
+	 * acquisition of the pool lock.
+	 */
+	key = k_spin_lock(&pool->lock);
+	while (n < count && pool->uninit_count) {
+		buf = pool_get_uninit(pool, pool->uninit_count--);
 		buf->__buf = NULL;
+		buf->flags = 0U;
+		sys_slist_append(&list, &buf->node);
+		n++;
 	}
+	k_spin_unlock(&pool->lock, key);
 
-	buf->ref   = 1U;
-	buf->flags = 0U;
-	buf->frags = NULL;
-	buf->size  = size;
-	net_buf_reset(buf);
+	while (n < count) {
+		buf = k_lifo_get(&pool->free, sys_timepoint_timeout(end));
+		if (!buf) {
+			NET_BUF_ERR("Failed to get %zu free buffers", count);
+			goto release;
+		}
+
+		sys_slist_append(&list, &buf->node);
+		n++;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&list, buf, node) {
+		if (buf_setup(buf, size, sys_timepoint_timeout(end)) < 0) {
+			NET_BUF_ERR("Failed to allocate data");
+			goto release;
+		}
+
+		if (tail) {
+			tail->frags = buf;
+		} else {
+			head = buf;
+		}
+		tail = buf;
+	}
 
 #if defined(CONFIG_NET_BUF_POOL_USAGE)
-	atomic_dec(&pool->avail_count);
+	atomic_sub(&pool->avail_count, count);
 	__ASSERT_NO_MSG(atomic_get(&pool->avail_count) >= 0);
 #endif
-	return buf;
+
+	NET_BUF_DBG("allocated %zu bufs from %p", count, pool);
+
+	return head;
+
+release:
+	/* Undo: the list is still linked through the buffer nodes */
+	SYS_SLIST_FOR_EACH_CONTAINER(&list, buf, node) {
+		buf->frags = NULL;
+		buf_data_unref(pool, buf);
+		tail = buf;
+	}
+
+	pool_free_list(pool, SYS_SLIST_PEEK_HEAD_CONTAINER(&list, buf, node),
+		       tail);
+
+	return NULL;
+}
+
+struct net_buf *net_buf_alloc_iovec(struct net_buf_pool *pool,
+				    size_t headroom,
+				    const struct net_buf_iovec *iov,
+				    size_t iovcnt, k_timeout_t timeout)
+{
+	size_t total = 0;
+	size_t size, per_buf, count;
+	struct net_buf *head, *buf;
+
+	__ASSERT_NO_MSG(pool);
+	__ASSERT_NO_MSG(iov != NULL || iovcnt == 0);
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		total += iov[i].len;
+	}
+
+	if (pool->alloc->max_alloc_size) {
+		/* Fixed size blocks: spread the data over as many as needed */
+		size = pool->alloc->max_alloc_size;
+		__ASSERT(headroom < size, "headroom %zu doesn't fit in %zu",
+			 headroom, size);
+		per_buf = size - headroom;
+		count = MAX(1, DIV_ROUND_UP(total, per_buf));
+	} else {
+		size = headroom + total;
+		per_buf = total;
+		count = 1;
+	}
+
+	head = net_buf_alloc_batch(pool, size, count, timeout);
+	if (!head) {
+		return NULL;
+	}
+
+	for (buf = head; buf; buf = buf->frags) {
+		net_buf_reserve(buf, headroom);
+	}
+
+	buf = head;
+	for (size_t i = 0; i < iovcnt; i++) {
+		const uint8_t *data = iov[i].data;
+		size_t len = iov[i].len;
+
+		while (len) {
+			size_t copy;
+
+			if (buf->len == per_buf) {
+				buf = buf->frags;
+			}
+
+			copy = MIN(len, per_buf - buf->len);
+			net_buf_add_mem(buf, data, copy);
+			data += copy;
+			len -= copy;
+		}
+	}
+
+	return head;
 }
 
 #if defined(CONFIG_NET_BUF_LOG)
@@ -490,6 +665,63 @@ void net_buf_unref(struct net_buf *buf)
 	}
 }
 
+void net_buf_unref_chain(struct net_buf *buf)
+{
+	struct net_buf_pool *batch_pool = NULL;
+	struct net_buf *head = NULL;
+	struct net_buf *tail = NULL;
+
+	__ASSERT_NO_MSG(buf);
+
+	while (buf) {
+		struct net_buf *frags = buf->frags;
+		struct net_buf_pool *pool;
+
+		NET_BUF_DBG("buf %p ref %u pool_id %u frags %p", buf, buf->ref,
+			    buf->pool_id, buf->frags);
+
+		if (--buf->ref > 0) {
+			break;
+		}
+
+		buf->data = NULL;
+		buf->frags = NULL;
+
+		pool = net_buf_pool_get(buf->pool_id);
+
+#if defined(CONFIG_NET_BUF_POOL_USAGE)
+		atomic_inc(&pool->avail_count);
+		__ASSERT_NO_MSG(atomic_get(&pool->avail_count) <= pool->buf_count);
+#endif
+
+		if (pool->destroy) {
+			pool->destroy(buf);
+		} else {
+			/* Consecutive buffers of the same pool go back to
+			 * its free LIFO together.
+			 */
+			if (pool != batch_pool) {
+				pool_free_list(batch_pool, head, tail);
+				batch_pool = pool;
+				head = NULL;
+			}
+
+			buf_data_unref(pool, buf);
+
+			if (head) {
+				tail->node.next = &buf->node;
+			} else {
+				head = buf;
+			}
+			tail = buf;
+		}
+
+		buf = frags;
+	}
+
+	pool_free_list(batch_pool, head, tail);
+}
+
 struct net_buf *net_buf_ref(struct net_buf *buf)
 {
 	__ASSERT_NO_MSG(buf);
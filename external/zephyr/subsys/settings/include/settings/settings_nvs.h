@@ -29,9 +29,16 @@ extern "C" {
  *
  * Deleted records will not be found, only the last record will be
  * read.
+ *
+ * With CONFIG_SETTINGS_NVS_NAME_INDEX the entry at NVS_NAME_INDEX_ID, which
+ * is the unused value ID of NVS_NAMECNT_ID, holds the hash of every name and
+ * of its first component, indexed by name ID. It is deleted before any name
+ * entry is added or removed and rewritten by the next load, so it is only
+ * found when it matches the name entries.
  */
 #define NVS_NAMECNT_ID 0x8000
 #define NVS_NAME_ID_OFFSET 0x4000
+#define NVS_NAME_INDEX_ID (NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET)
 
 struct settings_nvs {
 	struct settings_store cf_store;
@@ -46,6 +53,19 @@ struct settings_nvs {
 
 	uint16_t cache_next;
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	struct {
+		uint16_t last_name_id;
+		uint16_t crc;
+		struct {
+			uint16_t name_hash;
+			uint16_t root_hash;
+		} entry[CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE];
+	} index;
+
+	bool index_valid;
+	bool index_stored;
+#endif
 };
 
 /* register nvs to be a source of settings */
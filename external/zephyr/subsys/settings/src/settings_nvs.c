@@ -118,6 +118,185 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+/* Hash of entries without a name */
+#define SETTINGS_NVS_INDEX_EMPTY 0
+
+#define SETTINGS_NVS_INDEX_CNT(last_name_id) ((last_name_id) - NVS_NAMECNT_ID)
+
+static uint16_t settings_nvs_index_hash(const char *name, size_t len)
+{
+	uint16_t hash = crc16_ccitt(0xffff, name, len);
+
+	return (hash == SETTINGS_NVS_INDEX_EMPTY) ? hash + 1 : hash;
+}
+
+static uint16_t settings_nvs_index_root_hash(const char *name)
+{
+	return settings_nvs_index_hash(name, settings_name_next(name, NULL));
+}
+
+/* Length of the stored index, the entries of unused name IDs are left out */
+static size_t settings_nvs_index_len(struct settings_nvs *cf)
+{
+	return offsetof(struct settings_nvs, index.entry) -
+	       offsetof(struct settings_nvs, index) +
+	       SETTINGS_NVS_INDEX_CNT(cf->last_name_id) *
+	       sizeof(cf->index.entry[0]);
+}
+
+static uint16_t settings_nvs_index_crc(struct settings_nvs *cf)
+{
+	return crc16_ccitt(0xffff, (const uint8_t *)cf->index.entry,
+			   SETTINGS_NVS_INDEX_CNT(cf->index.last_name_id) *
+			   sizeof(cf->index.entry[0]));
+}
+
+static void settings_nvs_index_set(struct settings_nvs *cf, uint16_t name_id,
+				   const char *name)
+{
+	uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+	if (i >= CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) {
+		cf->index_valid = false;
+		return;
+	}
+
+	cf->index.entry[i].name_hash = settings_nvs_index_hash(name, strlen(name));
+	cf->index.entry[i].root_hash = settings_nvs_index_root_hash(name);
+}
+
+static void settings_nvs_index_clear(struct settings_nvs *cf, uint16_t name_id)
+{
+	uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+	if (i < CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) {
+		cf->index.entry[i].name_hash = SETTINGS_NVS_INDEX_EMPTY;
+		cf->index.entry[i].root_hash = SETTINGS_NVS_INDEX_EMPTY;
+	}
+}
+
+/* Delete the stored index before the name entries are modified */
+static int settings_nvs_index_unstore(struct settings_nvs *cf)
+{
+	int rc;
+
+	if (!cf->index_stored) {
+		return 0;
+	}
+
+	rc = nvs_delete(&cf->cf_nvs, NVS_NAME_INDEX_ID);
+	if (rc < 0) {
+		return rc;
+	}
+
+	cf->index_stored = false;
+
+	return 0;
+}
+
+static void settings_nvs_index_store(struct settings_nvs *cf)
+{
+	int rc;
+
+	if (!cf->index_valid || cf->index_stored) {
+		return;
+	}
+
+	cf->index.last_name_id = cf->last_name_id;
+	cf->index.crc = settings_nvs_index_crc(cf);
+
+	rc = nvs_write(&cf->cf_nvs, NVS_NAME_INDEX_ID, &cf->index,
+		       settings_nvs_index_len(cf));
+	if (rc < 0) {
+		/* The RAM index is still used */
+		LOG_DBG("Name index not stored (err %d)", rc);
+		return;
+	}
+
+	cf->index_stored = true;
+}
+
+static void settings_nvs_index_init(struct settings_nvs *cf, bool name_cnt_found)
+{
+	ssize_t rc;
+
+	memset(&cf->index, 0, sizeof(cf->index));
+	cf->index_valid = false;
+	cf->index_stored = false;
+
+	if (SETTINGS_NVS_INDEX_CNT(cf->last_name_id) >
+	    CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) {
+		return;
+	}
+
+	if (!name_cnt_found) {
+		/* Names are only written after the name counter */
+		cf->index_valid = true;
+		return;
+	}
+
+	rc = nvs_read(&cf->cf_nvs, NVS_NAME_INDEX_ID, &cf->index,
+		      sizeof(cf->index));
+	if (rc <= 0) {
+		memset(&cf->index, 0, sizeof(cf->index));
+		return;
+	}
+
+	/* Found even if not valid: delete it before modifying the names */
+	cf->index_stored = true;
+
+	if ((rc != settings_nvs_index_len(cf)) ||
+	    (cf->index.last_name_id != cf->last_name_id) ||
+	    (cf->index.crc != settings_nvs_index_crc(cf))) {
+		LOG_DBG("Name index outdated");
+		memset(&cf->index, 0, sizeof(cf->index));
+		return;
+	}
+
+	cf->index_valid = true;
+}
+
+static uint16_t settings_nvs_index_match(struct settings_nvs *cf, const char *name,
+					 char *rdname, size_t len,
+					 uint16_t *free_name_id)
+{
+	uint16_t name_hash = settings_nvs_index_hash(name, strlen(name));
+	uint16_t name_id;
+	int rc;
+
+	*free_name_id = cf->last_name_id + 1;
+
+	for (name_id = cf->last_name_id; name_id > NVS_NAMECNT_ID; name_id--) {
+		uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+		if (cf->index.entry[i].name_hash == SETTINGS_NVS_INDEX_EMPTY) {
+			*free_name_id = name_id;
+			continue;
+		}
+
+		if (cf->index.entry[i].name_hash != name_hash) {
+			continue;
+		}
+
+		rc = nvs_read(&cf->cf_nvs, name_id, rdname, len);
+		if (rc < 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+
+		if (strcmp(name, rdname)) {
+			continue;
+		}
+
+		return name_id;
+	}
+
+	return NVS_NAMECNT_ID;
+}
+#endif /* CONFIG_SETTINGS_NVS_NAME_INDEX */
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -131,6 +310,25 @@ static int settings_nvs_load(struct settings_store *cs,
 
 	name_id = cf->last_name_id + 1;
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Without a valid index every entry is read, rebuild it meanwhile */
+	bool index_rebuild = !cf->index_valid &&
+			     (SETTINGS_NVS_INDEX_CNT(cf->last_name_id) <=
+			      CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE);
+	uint16_t root_hash = SETTINGS_NVS_INDEX_EMPTY;
+
+	if (index_rebuild && settings_nvs_index_unstore(cf)) {
+		index_rebuild = false;
+	}
+
+	if (index_rebuild) {
+		memset(cf->index.entry, 0, sizeof(cf->index.entry));
+	} else if (cf->index_valid && arg && arg->subtree &&
+		   settings_name_next(arg->subtree, NULL)) {
+		root_hash = settings_nvs_index_root_hash(arg->subtree);
+	}
+#endif
+
 	while (1) {
 
 		name_id--;
@@ -138,6 +336,22 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (cf->index_valid) {
+			uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+			if (cf->index.entry[i].name_hash ==
+			    SETTINGS_NVS_INDEX_EMPTY) {
+				continue;
+			}
+
+			if ((root_hash != SETTINGS_NVS_INDEX_EMPTY) &&
+			    (cf->index.entry[i].root_hash != root_hash)) {
+				continue;
+			}
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -152,7 +366,13 @@ static int settings_nvs_load(struct settings_store *cs,
 			 * Decrement it and check the next ID in subsequent
 			 * iteration.
 			 */
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			settings_nvs_index_clear(cf, name_id);
+#endif
 			if (name_id == cf->last_name_id) {
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+				(void)settings_nvs_index_unstore(cf);
+#endif
 				cf->last_name_id--;
 				nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
 					  &cf->last_name_id, sizeof(uint16_t));
@@ -167,6 +387,10 @@ static int settings_nvs_load(struct settings_store *cs,
 			 * or deleted. Clean dirty entries to make space for
 			 * future settings item.
 			 */
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			settings_nvs_index_clear(cf, name_id);
+			(void)settings_nvs_index_unstore(cf);
+#endif
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
 
@@ -187,6 +411,11 @@ static int settings_nvs_load(struct settings_store *cs,
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
 		settings_nvs_cache_add(cf, name, name_id);
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		if (index_rebuild) {
+			settings_nvs_index_set(cf, name_id, name);
+		}
+#endif
 
 		ret = settings_call_set_handler(
 			name, rc2,
@@ -196,6 +425,18 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	/* Names saved by the handlers meanwhile were indexed by the save */
+	if (index_rebuild && !ret &&
+	    (SETTINGS_NVS_INDEX_CNT(cf->last_name_id) <=
+	     CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE)) {
+		cf->index_valid = true;
+	}
+
+	settings_nvs_index_store(cf);
+#endif
+
 	return ret;
 }
 
@@ -226,6 +467,18 @@ static int settings_nvs_save(struct settings_store *cs, const char *name,
 		goto found;
 	}
 #endif
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (cf->index_valid) {
+		name_id = settings_nvs_index_match(cf, name, rdname,
+						   sizeof(rdname),
+						   &write_name_id);
+		write_name = (name_id == NVS_NAMECNT_ID);
+		if (!write_name) {
+			write_name_id = name_id;
+		}
+		goto found;
+	}
+#endif
 
 	name_id = cf->last_name_id + 1;
 	write_name_id = cf->last_name_id + 1;
@@ -267,8 +520,18 @@ found:
 			return 0;
 		}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		rc = settings_nvs_index_unstore(cf);
+		if (rc < 0) {
+			return rc;
+		}
+#endif
+
 		rc = nvs_delete(&cf->cf_nvs, name_id);
 		if (rc >= 0) {
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+			settings_nvs_index_clear(cf, name_id);
+#endif
 			rc = nvs_delete(&cf->cf_nvs, name_id +
 					NVS_NAME_ID_OFFSET);
 		}
@@ -297,8 +560,26 @@ found:
 		return -ENOMEM;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	if (write_name) {
+		rc = settings_nvs_index_unstore(cf);
+		if (rc < 0) {
+			return rc;
+		}
+	}
+#endif
+
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		/* The index has no entry for the new name ID, stop using it
+		 * before the writes below can fail.
+		 */
+		if (SETTINGS_NVS_INDEX_CNT(write_name_id) >
+		    CONFIG_SETTINGS_NVS_NAME_INDEX_SIZE) {
+			cf->index_valid = false;
+		}
+#endif
 		cf->last_name_id = write_name_id;
 		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
 			       sizeof(uint16_t));
@@ -320,6 +601,10 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+		settings_nvs_index_set(cf, write_name_id, name);
+#endif
 	}
 
 #if CONFIG_SETTINGS_NVS_NAME_CACHE
@@ -355,6 +640,10 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+#if CONFIG_SETTINGS_NVS_NAME_INDEX
+	settings_nvs_index_init(cf, rc >= 0);
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
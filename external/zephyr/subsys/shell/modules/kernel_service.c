@@ -105,6 +105,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	const char *tname;
 	int ret;
 	char state_str[32];
+	k_ticks_t timeout = 0;
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
 	k_thread_runtime_stats_t rt_stats_thread;
@@ -117,11 +118,19 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      (thread == k_current_get()) ? "*" : " ",
 		      thread,
 		      tname ? tname : "NA");
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+	/* The timeout ticks stored in the thread are relative to other
+	 * timeouts or absolute, depending on the timeout queue, hence print
+	 * the ticks remaining until the thread wakes up.
+	 */
+	timeout = k_thread_timeout_remaining_ticks(thread);
+#endif /* CONFIG_SYS_CLOCK_EXISTS */
+
 	/* Cannot use lld as it's less portable. */
 	shell_print(sh, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      (int64_t)timeout);
 	shell_print(sh, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
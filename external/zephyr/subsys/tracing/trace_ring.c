@@ -0,0 +1,265 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tracing/trace_ring.h>
+
+#define RING_LEN CONFIG_TRACE_RING_EVENTS
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_LEN), "Ring length must be a power of two");
+
+#define CTF_MAGIC 0xC1FC1FC1
+
+/* Serialized event: 32 bit timestamp, 16 bit ID, 3 x 32 bit arguments. */
+#define EVT_SIZE (sizeof(uint32_t) + sizeof(uint16_t) + 3 * sizeof(uint32_t))
+#define DUMP_CHUNK_EVENTS 8
+
+struct trace_ring {
+	uint32_t head;
+	uint32_t count;
+	uint32_t discarded;
+	struct trace_ring_event events[RING_LEN];
+};
+
+static struct trace_ring rings[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t enabled;
+
+void trace_ring_record(uint16_t id, uint32_t a0, uint32_t a1, uint32_t a2)
+{
+	struct trace_ring_event *evt;
+	struct trace_ring *ring;
+	unsigned int key;
+
+	if (!atomic_get(&enabled)) {
+		return;
+	}
+
+	/* Each CPU only writes its own ring, masking local interrupts is
+	 * enough and keeps timestamps in recording order.
+	 */
+	key = arch_irq_lock();
+
+#if defined(CONFIG_SMP)
+	ring = &rings[arch_curr_cpu()->id];
+#else
+	ring = &rings[0];
+#endif
+
+	evt = &ring->events[ring->head & (RING_LEN - 1)];
+	ring->head++;
+	if (ring->count < RING_LEN) {
+		ring->count++;
+	} else {
+		ring->discarded++;
+	}
+
+	evt->timestamp = (uint32_t)timing_counter_get();
+	evt->id = id;
+	evt->arg[0] = a0;
+	evt->arg[1] = a1;
+	evt->arg[2] = a2;
+
+	arch_irq_unlock(key);
+}
+
+void trace_ring_enable(bool enable)
+{
+	atomic_set(&enabled, enable ? 1 : 0);
+}
+
+void trace_ring_clear(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rings); i++) {
+		rings[i].head = 0;
+		rings[i].count = 0;
+		rings[i].discarded = 0;
+	}
+}
+
+int trace_ring_stats_get(uint32_t cpu, uint32_t *count, uint32_t *discarded)
+{
+	if (cpu >= ARRAY_SIZE(rings)) {
+		return -EINVAL;
+	}
+
+	*count = rings[cpu].count;
+	*discarded = rings[cpu].discarded;
+
+	return 0;
+}
+
+static const char *const metadata_head =
+	"/* CTF 1.8 */\n"
+	"typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n"
+	"typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n"
+	"\n"
+	"trace {\n"
+	"\tmajor = 1;\n"
+	"\tminor = 8;\n"
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	"\tbyte_order = le;\n"
+#else
+	"\tbyte_order = be;\n"
+#endif
+	"\tpacket.header := struct {\n"
+	"\t\tuint32_t magic;\n"
+	"\t\tuint32_t stream_id;\n"
+	"\t};\n"
+	"};\n"
+	"\n"
+	"env {\n"
+	"\tdomain = \"zephyr\";\n"
+	"\ttracer_name = \"trace_ring\";\n"
+	"};\n"
+	"\n";
+
+static const char *const metadata_tail =
+	"typealias integer {\n"
+	"\tsize = 32; align = 8; signed = false;\n"
+	"\tmap = clock.cycles.value;\n"
+	"} := cycles_t;\n"
+	"\n"
+	"stream {\n"
+	"\tid = 0;\n"
+	"\tpacket.context := struct {\n"
+	"\t\tuint32_t cpu_id;\n"
+	"\t\tuint32_t events_discarded;\n"
+	"\t};\n"
+	"\tevent.header := struct {\n"
+	"\t\tcycles_t timestamp;\n"
+	"\t\tuint16_t id;\n"
+	"\t};\n"
+	"};\n"
+	"\n";
+
+static const struct {
+	uint16_t id;
+	const char *name;
+	const char *args[3];
+} metadata_events[] = {
+	{ TRACE_RING_EVT_BT_HCI_RX, "bt_hci_rx", { "buf_type", "len", "hdr" } },
+	{ TRACE_RING_EVT_BT_HCI_TX, "bt_hci_tx", { "buf_type", "len", "hdr" } },
+	{ TRACE_RING_EVT_BT_ATT_TX, "bt_att_tx", { "handle", "opcode", "len" } },
+	{ TRACE_RING_EVT_BT_ATT_RX, "bt_att_rx", { "handle", "opcode", "len" } },
+	{ TRACE_RING_EVT_BT_CONN_STATE, "bt_conn_state", { "handle", "old", "new" } },
+	{ TRACE_RING_EVT_USER0, "user0", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER1, "user1", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER2, "user2", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER3, "user3", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER4, "user4", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER5, "user5", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER6, "user6", { "a0", "a1", "a2" } },
+	{ TRACE_RING_EVT_USER7, "user7", { "a0", "a1", "a2" } },
+};
+
+static int dump_str(trace_ring_dump_cb_t cb, void *user_data, const char *str)
+{
+	return cb(str, strlen(str), user_data);
+}
+
+int trace_ring_dump_metadata(trace_ring_dump_cb_t cb, void *user_data)
+{
+	char line[192];
+	int err;
+
+	err = dump_str(cb, user_data, metadata_head);
+	if (err) {
+		return err;
+	}
+
+	snprintk(line, sizeof(line),
+		 "clock {\n\tname = cycles;\n\tfreq = %u;\n\toffset = 0;\n};\n\n",
+		 (uint32_t)timing_freq_get());
+	err = dump_str(cb, user_data, line);
+	if (err) {
+		return err;
+	}
+
+	err = dump_str(cb, user_data, metadata_tail);
+	if (err) {
+		return err;
+	}
+
+	ARRAY_FOR_EACH_PTR(metadata_events, evt) {
+		snprintk(line, sizeof(line),
+			 "event {\n\tname = \"%s\";\n\tid = %u;\n\tstream_id = 0;\n"
+			 "\tfields := struct {\n\t\tuint32_t %s;\n\t\tuint32_t %s;\n"
+			 "\t\tuint32_t %s;\n\t};\n};\n\n",
+			 evt->name, evt->id, evt->args[0], evt->args[1], evt->args[2]);
+		err = dump_str(cb, user_data, line);
+		if (err) {
+			return err;
+		}
+	}
+
+	return 0;
+}
+
+int trace_ring_dump(uint32_t cpu, trace_ring_dump_cb_t cb, void *user_data)
+{
+	uint8_t chunk[DUMP_CHUNK_EVENTS * EVT_SIZE];
+	struct trace_ring *ring;
+	uint32_t packet[4];
+	uint32_t start;
+	size_t len = 0;
+	int err;
+
+	if (cpu >= ARRAY_SIZE(rings)) {
+		return -EINVAL;
+	}
+
+	ring = &rings[cpu];
+
+	/* Packet header (magic, stream ID) then packet context (CPU, discarded). */
+	packet[0] = CTF_MAGIC;
+	packet[1] = 0;
+	packet[2] = cpu;
+	packet[3] = ring->discarded;
+
+	err = cb(packet, sizeof(packet), user_data);
+	if (err) {
+		return err;
+	}
+
+	start = ring->head - ring->count;
+	for (uint32_t i = 0; i < ring->count; i++) {
+		const struct trace_ring_event *evt =
+			&ring->events[(start + i) & (RING_LEN - 1)];
+
+		memcpy(&chunk[len], &evt->timestamp, sizeof(evt->timestamp));
+		len += sizeof(evt->timestamp);
+		memcpy(&chunk[len], &evt->id, sizeof(evt->id));
+		len += sizeof(evt->id);
+		memcpy(&chunk[len], evt->arg, sizeof(evt->arg));
+		len += sizeof(evt->arg);
+
+		if (len == sizeof(chunk)) {
+			err = cb(chunk, len, user_data);
+			if (err) {
+				return err;
+			}
+			len = 0;
+		}
+	}
+
+	return len ? cb(chunk, len, user_data) : 0;
+}
+
+static int trace_ring_init(void)
+{
+	timing_init();
+	timing_start();
+	atomic_set(&enabled, 1);
+
+	return 0;
+}
+
+SYS_INIT(trace_ring_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <zephyr/bluetooth/crypto.h>
+
+/* Bluetooth Host AES microbenchmark.  Each case is run many times and the
+ * average cost of one call is reported, so that the per block key expansion
+ * of bt_encrypt_be() can be compared with a prepared bt_aes_ctx and with the
+ * key cache (CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE).
+ */
+
+#define N_RUNS 1000
+
+/* Size of an encrypted advertising data payload and a typical mesh PDU */
+#define CCM_SHORT_LEN 24
+#define CCM_LONG_LEN 64
+#define CCM_MIC_SIZE 4
+
+static const uint8_t key[16] = {
+	0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x20, 0x4b,
+	0x65, 0x79, 0x20, 0x42, 0x65, 0x6e, 0x63, 0x68,
+};
+static uint8_t nonce[13];
+static const uint8_t aad[1] = { 0xea };
+static uint8_t block[16];
+static uint8_t msg[CCM_LONG_LEN];
+static uint8_t enc[CCM_LONG_LEN + CCM_MIC_SIZE];
+static struct bt_aes_ctx ctx;
+
+#define BENCH(name, expr) do { \
+	timing_t start, end; \
+	uint64_t cycles; \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < N_RUNS; i++) { \
+		(void)(expr); \
+	} \
+	end = timing_counter_get(); \
+	cycles = timing_cycles_get(&start, &end) / N_RUNS; \
+	printk("%-12s %6u cycles (%u ns)\n", name, (uint32_t)cycles, \
+	       (uint32_t)timing_cycles_to_ns(cycles)); \
+} while (false)
+
+int main(void)
+{
+	int err;
+
+	timing_init();
+	timing_start();
+
+	printk("key cache %u\n", CONFIG_BT_HOST_CRYPTO_KEY_CACHE_SIZE);
+
+	err = bt_aes_ctx_init(&ctx, key);
+	if (err) {
+		printk("Context init failed (err %d)\n", err);
+		return 0;
+	}
+
+	BENCH("ctx_init", bt_aes_ctx_init(&ctx, key));
+	BENCH("encrypt_be", bt_encrypt_be(key, block, block));
+	BENCH("encrypt_le", bt_encrypt_le(key, block, block));
+	BENCH("ctx_encrypt", bt_aes_ctx_encrypt_be(&ctx, block, block));
+	BENCH("ccm_enc_24", bt_ccm_encrypt(key, nonce, msg, CCM_SHORT_LEN, aad, sizeof(aad),
+					   enc, CCM_MIC_SIZE));
+	BENCH("ccm_enc_64", bt_ccm_encrypt(key, nonce, msg, CCM_LONG_LEN, aad, sizeof(aad),
+					   enc, CCM_MIC_SIZE));
+
+	err = bt_ccm_encrypt(key, nonce, msg, CCM_LONG_LEN, aad, sizeof(aad), enc, CCM_MIC_SIZE);
+	if (err) {
+		printk("CCM encrypt failed (err %d)\n", err);
+		return 0;
+	}
+
+	BENCH("ccm_dec_64", bt_ccm_decrypt(key, nonce, enc, CCM_LONG_LEN, aad, sizeof(aad),
+					   msg, CCM_MIC_SIZE));
+
+	bt_aes_ctx_clear(&ctx);
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#if defined(CONFIG_ARCH_POSIX)
+#include <time.h>
+#endif
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <tinycrypt/constants.h>
+#include <tinycrypt/ecc.h>
+#include <tinycrypt/ecc_dh.h>
+
+#include "p256.h"
+
+/* Bluetooth HCI ECC emulation microbenchmark. The public key generation and
+ * the DHKey computation of the two backends of the emulation are timed on
+ * the same keys: TinyCrypt micro-ecc (CONFIG_BT_ECC_EMULATION_TINYCRYPT) and
+ * the Host implementation with precomputed tables
+ * (CONFIG_BT_ECC_EMULATION_P256).
+ */
+
+#define N_RUNS 8
+
+/* Core Specification Vol 3, Part H, 2.3.5.6.1 */
+static const uint8_t private_key_a[32] = {
+	0x3f, 0x49, 0xf6, 0xd4, 0xa3, 0xc5, 0x5f, 0x38,
+	0x74, 0xc9, 0xb3, 0xe3, 0xd2, 0x10, 0x3f, 0x50,
+	0x4a, 0xff, 0x60, 0x7b, 0xeb, 0x40, 0xb7, 0x99,
+	0x58, 0x99, 0xb8, 0xa6, 0xcd, 0x3c, 0x1a, 0xbd,
+};
+
+static const uint8_t private_key_b[32] = {
+	0x36, 0xf6, 0x75, 0xcc, 0x81, 0xe7, 0x4e, 0xf5,
+	0xe8, 0xe2, 0x5d, 0x94, 0x0e, 0xd9, 0x04, 0x75,
+	0x95, 0x31, 0x98, 0x5d, 0x5d, 0x9d, 0xc9, 0xf8,
+	0x18, 0x18, 0xe8, 0x11, 0x89, 0x2f, 0x90, 0x2c,
+};
+
+static uint8_t public_key_b[64];
+static uint8_t public_key[64];
+static uint8_t dhkey_tc[32];
+static uint8_t dhkey_p256[32];
+
+#if defined(CONFIG_ARCH_POSIX)
+/* The simulated time does not advance while the host computes, time the
+ * computations with the host clock instead.
+ */
+static uint64_t host_time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * NSEC_PER_SEC + ts.tv_nsec;
+}
+
+#define BENCH(name, expr) do { \
+	uint64_t start, ns; \
+	\
+	start = host_time_ns(); \
+	for (int i = 0; i < N_RUNS; i++) { \
+		(void)(expr); \
+	} \
+	ns = (host_time_ns() - start) / N_RUNS; \
+	printk("%-12s %9u ns\n", name, (uint32_t)ns); \
+} while (false)
+#else
+#define BENCH(name, expr) do { \
+	timing_t start, end; \
+	uint64_t cycles; \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < N_RUNS; i++) { \
+		(void)(expr); \
+	} \
+	end = timing_counter_get(); \
+	cycles = timing_cycles_get(&start, &end) / N_RUNS; \
+	printk("%-12s %9u ns (%u cycles)\n", name, \
+	       (uint32_t)timing_cycles_to_ns(cycles), (uint32_t)cycles); \
+} while (false)
+#endif /* CONFIG_ARCH_POSIX */
+
+/* Only micro-ecc key generation draws random numbers, which is not timed */
+int default_CSPRNG(uint8_t *dst, unsigned int len)
+{
+	(void)memset(dst, 0x5a, len);
+
+	return 1;
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	if (bt_p256_public_key(private_key_b, public_key_b) ||
+	    uECC_compute_public_key(private_key_b, public_key, &curve_secp256r1) !=
+	    TC_CRYPTO_SUCCESS || memcmp(public_key, public_key_b, sizeof(public_key))) {
+		printk("Public key mismatch\n");
+		return 0;
+	}
+
+	if (bt_p256_dhkey(public_key_b, private_key_a, dhkey_p256) ||
+	    uECC_shared_secret(public_key_b, private_key_a, dhkey_tc, &curve_secp256r1) !=
+	    TC_CRYPTO_SUCCESS || memcmp(dhkey_tc, dhkey_p256, sizeof(dhkey_tc))) {
+		printk("DHKey mismatch\n");
+		return 0;
+	}
+
+	BENCH("tc_pubkey", uECC_compute_public_key(private_key_a, public_key, &curve_secp256r1));
+	BENCH("p256_pubkey", bt_p256_public_key(private_key_a, public_key));
+	BENCH("tc_valid", uECC_valid_public_key(public_key_b, &curve_secp256r1));
+	BENCH("p256_valid", bt_p256_public_key_valid(public_key_b));
+	BENCH("tc_dhkey", uECC_shared_secret(public_key_b, private_key_a, dhkey_tc,
+					     &curve_secp256r1));
+	BENCH("p256_dhkey", bt_p256_dhkey(public_key_b, private_key_a, dhkey_p256));
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+
+/* Vendor event generated by the synthetic controller. */
+#define BENCH_EVT_PREFIX 0xBE
+
+struct bench_evt {
+	uint8_t prefix;
+	uint8_t seq[4];   /* Little endian sequence number */
+	uint8_t stamp[4]; /* Little endian cycle count at generation */
+} __packed;
+
+enum bench_stat {
+	/* Event generation to pick up by the driver RX thread */
+	BENCH_STAT_EVT2DRV,
+	/* Event generation to application callback */
+	BENCH_STAT_EVT2CB,
+	/* HCI command round trip through the TX thread */
+	BENCH_STAT_CMD_RTT,
+	BENCH_STAT_COUNT,
+};
+
+void bench_record(enum bench_stat stat, uint32_t cycles);
+
+int bench_driver_register(void);
+void bench_driver_start(void);
+void bench_driver_stop(void);
+uint32_t bench_driver_overruns(void);
+
+#endif /* BENCH_H_ */
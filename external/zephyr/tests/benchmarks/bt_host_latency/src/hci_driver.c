@@ -0,0 +1,316 @@
+/* hci_driver.c - Synthetic controller for the Host latency benchmark */
+
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/buf.h>
+#include <zephyr/drivers/bluetooth/hci_driver.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "bench.h"
+
+/* The driver mirrors the threads of the HCI drivers in tree: events raised
+ * by the controller (a timer interrupt here) are picked up by a driver RX
+ * thread which delivers them to the Host, and Command Complete events are
+ * delivered either by the same thread (STM32WB IPM) or by a separate higher
+ * priority one (controller prio_recv_thread).
+ */
+
+#if defined(CONFIG_BENCHMARK_DRIVER_BURST)
+#define DRIVER_BURST CONFIG_BENCHMARK_DRIVER_BURST
+#else
+#define DRIVER_BURST 1
+#endif
+
+#define RX_STACK_SIZE 2048
+
+struct rx_msg {
+	/* Command Complete event, NULL for a synthetic event */
+	struct net_buf *buf;
+	uint32_t seq;
+	uint32_t stamp;
+};
+
+K_MSGQ_DEFINE(rx_msgq, sizeof(struct rx_msg), 32, 4);
+static K_THREAD_STACK_DEFINE(rx_stack, RX_STACK_SIZE);
+static struct k_thread rx_thread_data;
+
+#if defined(CONFIG_BENCHMARK_DRIVER_SPLIT_RX)
+K_MSGQ_DEFINE(prio_msgq, sizeof(struct rx_msg), 4, 4);
+static K_THREAD_STACK_DEFINE(prio_rx_stack, RX_STACK_SIZE);
+static struct k_thread prio_rx_thread_data;
+#define PRIO_MSGQ (&prio_msgq)
+#else
+#define PRIO_MSGQ (&rx_msgq)
+#endif
+
+static uint32_t evt_seq;
+static uint32_t overruns;
+
+/* Command handler structure for cmd_handle(). */
+struct cmd_handler {
+	uint16_t opcode; /* HCI command opcode */
+	uint8_t len;     /* HCI command response length */
+	void (*handler)(struct net_buf **evt, uint8_t len, uint16_t opcode);
+};
+
+/* Create a command complete event. */
+static void *cmd_complete(struct net_buf **buf, uint8_t plen, uint16_t opcode)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+	struct bt_hci_evt_hdr *hdr;
+
+	*buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+	hdr = net_buf_add(*buf, sizeof(*hdr));
+	hdr->evt = BT_HCI_EVT_CMD_COMPLETE;
+	hdr->len = sizeof(*cc) + plen;
+	cc = net_buf_add(*buf, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+
+	return net_buf_add(*buf, plen);
+}
+
+/* Generic command complete with success status. */
+static void generic_success(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(evt, len, opcode);
+
+	/* Fill any event parameters with zero */
+	(void)memset(ccst, 0, len);
+
+	ccst->status = BT_HCI_ERR_SUCCESS;
+}
+
+/* Command complete with all feature or command bits set. */
+static void all_supported(struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	uint8_t *rp;
+
+	rp = cmd_complete(evt, len, opcode);
+	(void)memset(rp, 0xFF, len);
+	rp[0] = BT_HCI_ERR_SUCCESS;
+}
+
+/* Handlers needed for bt_enable() and the benchmark commands. */
+static const struct cmd_handler cmds[] = {
+	{ BT_HCI_OP_READ_LOCAL_VERSION_INFO,
+	  sizeof(struct bt_hci_rp_read_local_version_info),
+	  generic_success },
+	{ BT_HCI_OP_READ_SUPPORTED_COMMANDS,
+	  sizeof(struct bt_hci_rp_read_supported_commands),
+	  all_supported },
+	{ BT_HCI_OP_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_read_local_features),
+	  all_supported },
+	{ BT_HCI_OP_READ_BD_ADDR,
+	  sizeof(struct bt_hci_rp_read_bd_addr),
+	  generic_success },
+	{ BT_HCI_OP_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_EVENT_MASK,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_LOCAL_FEATURES,
+	  sizeof(struct bt_hci_rp_le_read_local_features),
+	  all_supported },
+	{ BT_HCI_OP_LE_READ_SUPP_STATES,
+	  sizeof(struct bt_hci_rp_le_read_supp_states),
+	  all_supported },
+	{ BT_HCI_OP_LE_RAND,
+	  sizeof(struct bt_hci_rp_le_rand),
+	  generic_success },
+	{ BT_HCI_OP_LE_SET_RANDOM_ADDRESS,
+	  sizeof(struct bt_hci_evt_cc_status),
+	  generic_success },
+};
+
+/* Lookup the command opcode and build its Command Complete event. */
+static struct net_buf *cmd_handle(struct net_buf *cmd)
+{
+	struct net_buf *evt = NULL;
+	struct bt_hci_evt_cc_status *ccst;
+	struct bt_hci_cmd_hdr *chdr;
+	uint16_t opcode;
+
+	chdr = net_buf_pull_mem(cmd, sizeof(*chdr));
+	opcode = sys_le16_to_cpu(chdr->opcode);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		if (cmds[i].opcode == opcode) {
+			cmds[i].handler(&evt, cmds[i].len, opcode);
+			return evt;
+		}
+	}
+
+	ccst = cmd_complete(&evt, sizeof(*ccst), opcode);
+	ccst->status = BT_HCI_ERR_UNKNOWN_CMD;
+
+	return evt;
+}
+
+/* Build the vendor event for a synthetic controller event. */
+static struct net_buf *evt_create(const struct rx_msg *msg)
+{
+	struct bt_hci_evt_hdr *hdr;
+	struct bench_evt *evt;
+	struct net_buf *buf;
+
+	bench_record(BENCH_STAT_EVT2DRV, k_cycle_get_32() - msg->stamp);
+
+	/* Model the driver copying the event out of the controller */
+	k_busy_wait(CONFIG_BENCHMARK_DRIVER_COST_US);
+
+	buf = bt_buf_get_rx(BT_BUF_EVT, K_FOREVER);
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = BT_HCI_EVT_VENDOR;
+	hdr->len = sizeof(*evt);
+
+	evt = net_buf_add(buf, sizeof(*evt));
+	evt->prefix = BENCH_EVT_PREFIX;
+	sys_put_le32(msg->seq, evt->seq);
+	sys_put_le32(msg->stamp, evt->stamp);
+
+	return buf;
+}
+
+static void rx_thread(void *p1, void *p2, void *p3)
+{
+	struct net_buf *bufs[DRIVER_BURST];
+	struct rx_msg msg;
+	size_t count;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&rx_msgq, &msg, K_FOREVER);
+
+		/* Deliver what is already pending in one go */
+		count = 0;
+		do {
+			bufs[count++] = msg.buf ? msg.buf : evt_create(&msg);
+		} while ((count < ARRAY_SIZE(bufs)) &&
+			 (k_msgq_get(&rx_msgq, &msg, K_NO_WAIT) == 0));
+
+		if (count > 1) {
+			(void)bt_recv_burst(bufs, count);
+		} else {
+			(void)bt_recv(bufs[0]);
+		}
+	}
+}
+
+#if defined(CONFIG_BENCHMARK_DRIVER_SPLIT_RX)
+static void prio_rx_thread(void *p1, void *p2, void *p3)
+{
+	struct rx_msg msg;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		(void)k_msgq_get(&prio_msgq, &msg, K_FOREVER);
+
+		if (IS_ENABLED(CONFIG_BT_RECV_BLOCKING)) {
+			(void)bt_recv_prio(msg.buf);
+		} else {
+			(void)bt_recv(msg.buf);
+		}
+	}
+}
+#endif /* CONFIG_BENCHMARK_DRIVER_SPLIT_RX */
+
+/* Controller event, raised from interrupt context. */
+static void evt_timer_expiry(struct k_timer *timer)
+{
+	struct rx_msg msg = {
+		.seq = evt_seq,
+		.stamp = k_cycle_get_32(),
+	};
+
+	if (evt_seq >= CONFIG_BENCHMARK_NUM_SAMPLES) {
+		k_timer_stop(timer);
+		return;
+	}
+
+	if (k_msgq_put(&rx_msgq, &msg, K_NO_WAIT) != 0) {
+		overruns++;
+		return;
+	}
+
+	evt_seq++;
+}
+
+static K_TIMER_DEFINE(evt_timer, evt_timer_expiry, NULL);
+
+static int driver_open(void)
+{
+	k_thread_create(&rx_thread_data, rx_stack, K_THREAD_STACK_SIZEOF(rx_stack),
+			rx_thread, NULL, NULL, NULL,
+			CONFIG_BENCHMARK_DRIVER_RX_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(&rx_thread_data, "recv_thread");
+
+#if defined(CONFIG_BENCHMARK_DRIVER_SPLIT_RX)
+	k_thread_create(&prio_rx_thread_data, prio_rx_stack,
+			K_THREAD_STACK_SIZEOF(prio_rx_stack),
+			prio_rx_thread, NULL, NULL, NULL,
+			CONFIG_BENCHMARK_DRIVER_PRIO_RX_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(&prio_rx_thread_data, "prio_recv_thread");
+#endif
+
+	return 0;
+}
+
+static int driver_send(struct net_buf *buf)
+{
+	if (bt_buf_get_type(buf) == BT_BUF_CMD) {
+		struct rx_msg msg = {
+			.buf = cmd_handle(buf),
+		};
+
+		(void)k_msgq_put(PRIO_MSGQ, &msg, K_FOREVER);
+	}
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static const struct bt_hci_driver drv = {
+	.name         = "bench",
+	.bus          = BT_HCI_DRIVER_BUS_VIRTUAL,
+	.open         = driver_open,
+	.send         = driver_send,
+	.quirks       = BT_QUIRK_NO_RESET,
+};
+
+int bench_driver_register(void)
+{
+	return bt_hci_driver_register(&drv);
+}
+
+void bench_driver_start(void)
+{
+	k_timer_start(&evt_timer, K_USEC(CONFIG_BENCHMARK_EVENT_INTERVAL_US),
+		      K_USEC(CONFIG_BENCHMARK_EVENT_INTERVAL_US));
+}
+
+void bench_driver_stop(void)
+{
+	k_timer_stop(&evt_timer);
+}
+
+uint32_t bench_driver_overruns(void)
+{
+	return overruns;
+}
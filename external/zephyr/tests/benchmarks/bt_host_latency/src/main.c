@@ -0,0 +1,254 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/hci.h>
+
+#include "bench.h"
+
+/* Bluetooth Host latency benchmark.
+ *
+ * A synthetic controller raises vendor events periodically from a timer
+ * interrupt. They travel through the same threads as real HCI traffic:
+ * driver RX thread, Host RX context (BT work queue, system work queue or
+ * driver thread with CONFIG_BT_RECV_BLOCKING) and finally the application
+ * callback. Meanwhile the application sends HCI commands through the HCI TX
+ * thread, and optional load competes for the system work queue or for a
+ * mutex shared with a low priority thread.
+ *
+ * The distribution of the latencies is reported as percentiles, so that
+ * thread priorities and Host options can be compared on the same traffic.
+ * On native_sim only the modelled processing times (k_busy_wait()) elapse,
+ * which makes the results deterministic and only dependent on scheduling.
+ */
+
+#define CMD_STACK_SIZE 1024
+#define CMD_PRIO 5
+
+#define PI_STACK_SIZE 512
+
+static uint32_t samples[BENCH_STAT_COUNT][CONFIG_BENCHMARK_NUM_SAMPLES];
+static uint32_t sample_cnt[BENCH_STAT_COUNT];
+static atomic_t done;
+
+static K_SEM_DEFINE(done_sem, 0, 1);
+static K_MUTEX_DEFINE(app_mutex);
+
+static K_THREAD_STACK_DEFINE(cmd_stack, CMD_STACK_SIZE);
+static struct k_thread cmd_thread_data;
+
+static K_THREAD_STACK_DEFINE(pi_stack, PI_STACK_SIZE);
+static struct k_thread pi_thread_data;
+
+void bench_record(enum bench_stat stat, uint32_t cycles)
+{
+	if (!atomic_get(&done) && (sample_cnt[stat] < CONFIG_BENCHMARK_NUM_SAMPLES)) {
+		samples[stat][sample_cnt[stat]++] = cycles;
+	}
+}
+
+static bool vnd_evt_cb(struct net_buf_simple *buf)
+{
+	uint32_t now = k_cycle_get_32();
+	struct bench_evt *evt;
+
+	if ((buf->len < sizeof(*evt)) || (buf->data[0] != BENCH_EVT_PREFIX)) {
+		return false;
+	}
+
+	evt = net_buf_simple_pull_mem(buf, sizeof(*evt));
+
+	if (CONFIG_BENCHMARK_PI_HOLD_US > 0) {
+		(void)k_mutex_lock(&app_mutex, K_FOREVER);
+		now = k_cycle_get_32();
+	}
+
+	bench_record(BENCH_STAT_EVT2CB, now - sys_get_le32(evt->stamp));
+
+	/* Model the application handling the event */
+	k_busy_wait(CONFIG_BENCHMARK_CALLBACK_COST_US);
+
+	if (CONFIG_BENCHMARK_PI_HOLD_US > 0) {
+		(void)k_mutex_unlock(&app_mutex);
+	}
+
+	if (sys_get_le32(evt->seq) == (CONFIG_BENCHMARK_NUM_SAMPLES - 1)) {
+		k_sem_give(&done_sem);
+	}
+
+	return true;
+}
+
+static void cmd_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&done)) {
+		struct net_buf *rsp;
+		uint32_t start;
+
+		k_sleep(K_USEC(CONFIG_BENCHMARK_CMD_INTERVAL_US));
+
+		start = k_cycle_get_32();
+		if (bt_hci_cmd_send_sync(BT_HCI_OP_LE_RAND, NULL, &rsp) == 0) {
+			bench_record(BENCH_STAT_CMD_RTT, k_cycle_get_32() - start);
+			net_buf_unref(rsp);
+		}
+	}
+}
+
+static void pi_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&done)) {
+		(void)k_mutex_lock(&app_mutex, K_FOREVER);
+		k_busy_wait(CONFIG_BENCHMARK_PI_HOLD_US);
+		(void)k_mutex_unlock(&app_mutex);
+
+		k_sleep(K_USEC(CONFIG_BENCHMARK_PI_PERIOD_US));
+	}
+}
+
+static void load_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_busy_wait(CONFIG_BENCHMARK_SYSWQ_LOAD_US);
+}
+
+static K_WORK_DEFINE(load_work, load_work_handler);
+
+static void load_timer_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	(void)k_work_submit(&load_work);
+}
+
+static K_TIMER_DEFINE(load_timer, load_timer_expiry, NULL);
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t percentile_us(const uint32_t *sorted, uint32_t n, uint32_t p)
+{
+	return k_cyc_to_us_floor32(sorted[((n - 1U) * p) / 100U]);
+}
+
+static void report(const char *name, enum bench_stat stat)
+{
+	uint32_t *s = samples[stat];
+	uint32_t n = sample_cnt[stat];
+
+	if (n == 0U) {
+		printk("%-8s n %5u\n", name, n);
+		return;
+	}
+
+	qsort(s, n, sizeof(s[0]), cmp_u32);
+
+	printk("%-8s n %5u p50 %6u p90 %6u p99 %6u max %6u us\n", name, n,
+	       percentile_us(s, n, 50U), percentile_us(s, n, 90U),
+	       percentile_us(s, n, 99U), percentile_us(s, n, 100U));
+}
+
+static const char *recv_context(void)
+{
+	if (IS_ENABLED(CONFIG_BT_RECV_BLOCKING)) {
+		return "blocking";
+	} else if (IS_ENABLED(CONFIG_BT_RECV_WORKQ_SYS)) {
+		return "workq_sys";
+	} else {
+		return "workq_bt";
+	}
+}
+
+static uint32_t recv_burst(void)
+{
+#if defined(CONFIG_BT_RECV_BURST_MAX)
+	return CONFIG_BT_RECV_BURST_MAX;
+#else
+	return 1U;
+#endif
+}
+
+int main(void)
+{
+	k_timeout_t timeout;
+	int err;
+
+	printk("recv %s burst %u driver %s rx prio %d\n", recv_context(), recv_burst(),
+	       IS_ENABLED(CONFIG_BENCHMARK_DRIVER_SPLIT_RX) ? "split" : "single",
+	       CONFIG_BENCHMARK_DRIVER_RX_PRIO);
+	printk("syswq load %u us pi hold %u us\n", CONFIG_BENCHMARK_SYSWQ_LOAD_US,
+	       CONFIG_BENCHMARK_PI_HOLD_US);
+
+	err = bench_driver_register();
+	if (err) {
+		printk("Driver registration failed (err %d)\n", err);
+		return 0;
+	}
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return 0;
+	}
+
+	(void)bt_hci_register_vnd_evt_cb(vnd_evt_cb);
+
+	if (CONFIG_BENCHMARK_SYSWQ_LOAD_US > 0) {
+		k_timer_start(&load_timer, K_USEC(CONFIG_BENCHMARK_SYSWQ_LOAD_PERIOD_US),
+			      K_USEC(CONFIG_BENCHMARK_SYSWQ_LOAD_PERIOD_US));
+	}
+
+	if (CONFIG_BENCHMARK_PI_HOLD_US > 0) {
+		k_thread_create(&pi_thread_data, pi_stack, K_THREAD_STACK_SIZEOF(pi_stack),
+				pi_thread, NULL, NULL, NULL,
+				CONFIG_BENCHMARK_PI_THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	if (CONFIG_BENCHMARK_CMD_INTERVAL_US > 0) {
+		k_thread_create(&cmd_thread_data, cmd_stack, K_THREAD_STACK_SIZEOF(cmd_stack),
+				cmd_thread, NULL, NULL, NULL, CMD_PRIO, 0, K_NO_WAIT);
+	}
+
+	bench_driver_start();
+
+	/* Leave room for the events to pile up under load */
+	timeout = K_USEC(4ULL * CONFIG_BENCHMARK_NUM_SAMPLES * CONFIG_BENCHMARK_EVENT_INTERVAL_US);
+	if (k_sem_take(&done_sem, timeout) != 0) {
+		printk("Timeout, partial results\n");
+	}
+
+	atomic_set(&done, 1);
+	bench_driver_stop();
+	k_timer_stop(&load_timer);
+
+	report("evt2drv", BENCH_STAT_EVT2DRV);
+	report("evt2cb", BENCH_STAT_EVT2CB);
+	report("cmd_rtt", BENCH_STAT_CMD_RTT);
+	printk("overruns %u\n", bench_driver_overruns());
+
+	printk("fin\n");
+
+	return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+/* Formatting microbenchmark.  Each case formats into a RAM sink many times
+ * and reports the average cost of a single cbprintf() call, so that
+ * conversion engines and options can be compared on a given target.
+ */
+
+#define N_RUNS 1000
+
+struct sink {
+	char buf[128];
+	size_t idx;
+};
+
+static struct sink sink;
+
+static int sink_out(int c, void *ctx)
+{
+	struct sink *s = ctx;
+
+	s->buf[s->idx++ % sizeof(s->buf)] = (char)c;
+
+	return c;
+}
+
+static const char addr[] = "D6:2E:7F:1A:09:C3 (random)";
+static volatile uint64_t time_val = 1234567890123ULL;
+static volatile uint32_t u32_val = 3000000000U;
+static volatile int int_val = -12345;
+
+#define BENCH(name, fmt, ...) do { \
+	timing_t start, end; \
+	uint64_t cycles; \
+	\
+	start = timing_counter_get(); \
+	for (int i = 0; i < N_RUNS; i++) { \
+		sink.idx = 0; \
+		(void)cbprintf(sink_out, &sink, fmt, __VA_ARGS__); \
+	} \
+	end = timing_counter_get(); \
+	cycles = timing_cycles_get(&start, &end) / N_RUNS; \
+	printk("%-12s %6u cycles (%u ns)\n", name, (uint32_t)cycles, \
+	       (uint32_t)timing_cycles_to_ns(cycles)); \
+} while (false)
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("cbprintf %s%s\n",
+	       IS_ENABLED(CONFIG_CBPRINTF_NANO) ? "nano" : "complete",
+	       IS_ENABLED(CONFIG_CBPRINTF_FAST_DECIMAL) ? " fast decimal" : "");
+
+	BENCH("int", "%d", int_val);
+	BENCH("u32", "%u", u32_val);
+	BENCH("u64", "%llu", time_val);
+	BENCH("hex", "%08x", u32_val);
+	BENCH("str", "%s", addr);
+	BENCH("padded", "%10u|%-6d", u32_val, int_val);
+	BENCH("record", "{'address': '%s', 'scenario': %d, 'time': %llu}\n",
+	      addr, int_val, time_val);
+
+	timing_stop();
+
+	printk("fin\n");
+
+	return 0;
+}
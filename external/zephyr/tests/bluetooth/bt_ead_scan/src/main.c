@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/ead.h>
+
+#define PAYLOAD_SIZE 8
+#define EAD_SIZE     BT_EAD_ENCRYPTED_PAYLOAD_SIZE(PAYLOAD_SIZE)
+
+/* Implemented in subsys/bluetooth/lib/ead.c with CONFIG_BT_TESTING */
+int bt_test_ead_encrypt(const uint8_t session_key[BT_EAD_KEY_SIZE],
+			const uint8_t iv[BT_EAD_IV_SIZE],
+			const uint8_t randomizer[BT_EAD_RANDOMIZER_SIZE], const uint8_t *payload,
+			size_t payload_size, uint8_t *encrypted_payload);
+
+static const bt_addr_le_t adv_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc6 },
+};
+static const bt_addr_le_t other_addr = {
+	.type = BT_ADDR_LE_PUBLIC,
+	.a.val = { 0x11, 0x12, 0x13, 0x14, 0x15, 0x16 },
+};
+static const uint8_t session_key[BT_EAD_KEY_SIZE] = {
+	0x57, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x20, 0x4b,
+	0x65, 0x79, 0x20, 0x42, 0x65, 0x61, 0x63, 0x6f,
+};
+static const uint8_t iv[BT_EAD_IV_SIZE] = { 0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7 };
+
+/* Complete name "EAD" and TX power 0 dBm */
+static const uint8_t payload[PAYLOAD_SIZE] = { 0x04, 0x09, 'E', 'A', 'D', 0x02, 0x0a, 0x00 };
+
+static K_SEM_DEFINE(recv_sem, 0, 8);
+static uint8_t recv_data[PAYLOAD_SIZE];
+static size_t recv_len;
+static int8_t recv_rssi;
+static bt_addr_le_t recv_addr;
+
+static void ead_recv(const bt_addr_le_t *addr, int8_t rssi, struct net_buf_simple *ad)
+{
+	bt_addr_le_copy(&recv_addr, addr);
+	recv_rssi = rssi;
+	recv_len = MIN(ad->len, sizeof(recv_data));
+	memcpy(recv_data, ad->data, recv_len);
+
+	k_sem_give(&recv_sem);
+}
+
+static struct bt_ead_scan_cb ead_cb = {
+	.recv = ead_recv,
+};
+
+/* Advertising data made of flags and one encrypted structure. */
+static void ad_build(struct net_buf_simple *ad, uint8_t randomizer_lsb, bool tamper)
+{
+	uint8_t randomizer[BT_EAD_RANDOMIZER_SIZE] = { randomizer_lsb, 0x11, 0x22, 0x33, 0x80 };
+	uint8_t *ead;
+	int err;
+
+	net_buf_simple_reset(ad);
+	net_buf_simple_add_u8(ad, 2);
+	net_buf_simple_add_u8(ad, BT_DATA_FLAGS);
+	net_buf_simple_add_u8(ad, BT_LE_AD_NO_BREDR);
+	net_buf_simple_add_u8(ad, EAD_SIZE + 1);
+	net_buf_simple_add_u8(ad, BT_DATA_ENCRYPTED_AD_DATA);
+	ead = net_buf_simple_add(ad, EAD_SIZE);
+
+	err = bt_test_ead_encrypt(session_key, iv, randomizer, payload, sizeof(payload), ead);
+	zassert_ok(err, "Encryption failed (err %d)", err);
+
+	if (tamper) {
+		ead[BT_EAD_RANDOMIZER_SIZE] ^= 0x01;
+	}
+}
+
+NET_BUF_SIMPLE_DEFINE_STATIC(adv_data, 3 + 2 + EAD_SIZE);
+
+static void *ead_scan_setup(void)
+{
+	zassert_ok(bt_ead_scan_cb_register(&ead_cb));
+
+	return NULL;
+}
+
+static void ead_scan_before(void *f)
+{
+	/* Adding the key again also forgets the payloads seen before */
+	zassert_ok(bt_ead_scan_key_add(&adv_addr, session_key, iv));
+	k_sem_reset(&recv_sem);
+}
+
+ZTEST_SUITE(bt_ead_scan, NULL, ead_scan_setup, ead_scan_before, NULL, NULL);
+
+ZTEST(bt_ead_scan, test_decrypt)
+{
+	uint16_t len;
+
+	ad_build(&adv_data, 0x01, false);
+	len = adv_data.len;
+
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_equal(adv_data.len, len, "Advertising data was modified");
+
+	zassert_ok(k_sem_take(&recv_sem, K_MSEC(100)), "Decrypted data not reported");
+	zassert_true(bt_addr_le_eq(&recv_addr, &adv_addr));
+	zassert_equal(recv_rssi, -42);
+	zassert_equal(recv_len, sizeof(payload));
+	zassert_mem_equal(recv_data, payload, sizeof(payload));
+}
+
+ZTEST(bt_ead_scan, test_duplicate_skipped)
+{
+	ad_build(&adv_data, 0x02, false);
+
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 0);
+	zassert_ok(k_sem_take(&recv_sem, K_MSEC(100)));
+
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 0);
+	zassert_equal(k_sem_take(&recv_sem, K_MSEC(10)), -EAGAIN, "Duplicate reported");
+
+	/* A new Randomizer is a new payload */
+	ad_build(&adv_data, 0x03, false);
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_ok(k_sem_take(&recv_sem, K_MSEC(100)));
+}
+
+ZTEST(bt_ead_scan, test_unknown_advertiser)
+{
+	ad_build(&adv_data, 0x04, false);
+
+	zassert_equal(bt_ead_scan_process(&other_addr, -42, &adv_data), 0);
+	zassert_equal(k_sem_take(&recv_sem, K_MSEC(10)), -EAGAIN);
+}
+
+ZTEST(bt_ead_scan, test_forged_payload)
+{
+	/* Same Randomizer and MIC as the genuine payload, different data */
+	ad_build(&adv_data, 0x05, true);
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_equal(k_sem_take(&recv_sem, K_MSEC(10)), -EAGAIN, "Forged payload reported");
+
+	/* The forged copy does not hide the genuine one */
+	ad_build(&adv_data, 0x05, false);
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_ok(k_sem_take(&recv_sem, K_MSEC(100)));
+	zassert_mem_equal(recv_data, payload, sizeof(payload));
+}
+
+ZTEST(bt_ead_scan, test_key_management)
+{
+	ad_build(&adv_data, 0x06, false);
+
+	zassert_ok(bt_ead_scan_key_remove(&adv_addr));
+	zassert_equal(bt_ead_scan_key_remove(&adv_addr), -ENOENT);
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 0);
+
+	zassert_ok(bt_ead_scan_key_add(&adv_addr, session_key, iv));
+	zassert_ok(bt_ead_scan_key_add(&other_addr, session_key, iv));
+	zassert_equal(bt_ead_scan_key_add(BT_ADDR_LE_ANY, session_key, iv), -ENOMEM);
+	zassert_ok(bt_ead_scan_key_remove(&other_addr));
+
+	zassert_equal(bt_ead_scan_process(&adv_addr, -42, &adv_data), 1);
+	zassert_ok(k_sem_take(&recv_sem, K_MSEC(100)));
+}
@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/ztest.h>
+
+#include "p256.h"
+
+#include "test_vectors.h"
+
+static uint8_t pub[64];
+static uint8_t key[32];
+
+ZTEST_SUITE(bt_p256, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(bt_p256, test_public_key)
+{
+	zassert_ok(bt_p256_public_key(debug_private_key, pub));
+	zassert_mem_equal(pub, debug_public_key, sizeof(pub));
+
+	zassert_ok(bt_p256_public_key(private_key_a, pub));
+	zassert_mem_equal(pub, public_key_a, sizeof(pub));
+
+	zassert_ok(bt_p256_public_key(private_key_b, pub));
+	zassert_mem_equal(pub, public_key_b, sizeof(pub));
+}
+
+ZTEST(bt_p256, test_public_key_invalid_private_key)
+{
+	(void)memset(key, 0, sizeof(key));
+	zassert_equal(bt_p256_public_key(key, pub), -EINVAL);
+
+	zassert_equal(bt_p256_public_key(order, pub), -EINVAL);
+
+	(void)memset(key, 0xff, sizeof(key));
+	zassert_equal(bt_p256_public_key(key, pub), -EINVAL);
+}
+
+ZTEST(bt_p256, test_public_key_edge_private_keys)
+{
+	uint8_t neg[64];
+
+	/* (n - 1) * G = -G */
+	(void)memcpy(key, order, sizeof(key));
+	key[31] -= 1U;
+	zassert_ok(bt_p256_public_key(key, neg));
+
+	(void)memset(key, 0, sizeof(key));
+	key[31] = 1U;
+	zassert_ok(bt_p256_public_key(key, pub));
+
+	zassert_mem_equal(neg, pub, 32);
+	zassert_true(memcmp(&neg[32], &pub[32], 32) != 0);
+	zassert_true(bt_p256_public_key_valid(neg));
+}
+
+ZTEST(bt_p256, test_public_key_valid)
+{
+	zassert_true(bt_p256_public_key_valid(debug_public_key));
+	zassert_true(bt_p256_public_key_valid(public_key_a));
+
+	(void)memcpy(pub, public_key_a, sizeof(pub));
+	pub[63] ^= 0x01;
+	zassert_false(bt_p256_public_key_valid(pub));
+
+	/* Coordinate equal to p */
+	(void)memset(pub, 0xff, 32);
+	(void)memset(&pub[4], 0, 16);
+	pub[7] = 0x01;
+	zassert_false(bt_p256_public_key_valid(pub));
+}
+
+ZTEST(bt_p256, test_dhkey)
+{
+	zassert_ok(bt_p256_dhkey(public_key_b, private_key_a, key));
+	zassert_mem_equal(key, dhkey_ab, sizeof(key));
+
+	zassert_ok(bt_p256_dhkey(public_key_a, private_key_b, key));
+	zassert_mem_equal(key, dhkey_ab, sizeof(key));
+
+	zassert_ok(bt_p256_dhkey(public_key_a, debug_private_key, key));
+	zassert_mem_equal(key, dhkey_debug_a, sizeof(key));
+}
+
+ZTEST(bt_p256, test_dhkey_in_place)
+{
+	/* The HCI emulation overlaps the public key and the DHKey */
+	(void)memcpy(pub, public_key_b, sizeof(pub));
+	zassert_ok(bt_p256_dhkey(pub, private_key_a, pub));
+	zassert_mem_equal(pub, dhkey_ab, sizeof(dhkey_ab));
+}
+
+ZTEST(bt_p256, test_dhkey_invalid)
+{
+	(void)memcpy(pub, public_key_a, sizeof(pub));
+	pub[0] ^= 0x80;
+	zassert_equal(bt_p256_dhkey(pub, private_key_b, key), -EINVAL);
+
+	zassert_equal(bt_p256_dhkey(public_key_a, order, key), -EINVAL);
+}
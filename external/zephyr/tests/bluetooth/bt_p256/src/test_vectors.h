@@ -0,0 +1,82 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+
+/* Core Specification Vol 3, Part H, 2.3.5.6.1 */
+static const uint8_t debug_private_key[] = {
+	0x3f, 0x49, 0xf6, 0xd4, 0xa3, 0xc5, 0x5f, 0x38,
+	0x74, 0xc9, 0xb3, 0xe3, 0xd2, 0x10, 0x3f, 0x50,
+	0x4a, 0xff, 0x60, 0x7b, 0xeb, 0x40, 0xb7, 0x99,
+	0x58, 0x99, 0xb8, 0xa6, 0xcd, 0x3c, 0x1a, 0xbd,
+};
+
+static const uint8_t debug_public_key[] = {
+	0x20, 0xb0, 0x03, 0xd2, 0xf2, 0x97, 0xbe, 0x2c,
+	0x5e, 0x2c, 0x83, 0xa7, 0xe9, 0xf9, 0xa5, 0xb9,
+	0xef, 0xf4, 0x91, 0x11, 0xac, 0xf4, 0xfd, 0xdb,
+	0xcc, 0x03, 0x01, 0x48, 0x0e, 0x35, 0x9d, 0xe6,
+	0xdc, 0x80, 0x9c, 0x49, 0x65, 0x2a, 0xeb, 0x6d,
+	0x63, 0x32, 0x9a, 0xbf, 0x5a, 0x52, 0x15, 0x5c,
+	0x76, 0x63, 0x45, 0xc2, 0x8f, 0xed, 0x30, 0x24,
+	0x74, 0x1c, 0x8e, 0xd0, 0x15, 0x89, 0xd2, 0x8b,
+};
+
+/* Random keys, the expected values computed with a reference implementation */
+static const uint8_t private_key_a[] = {
+	0xd2, 0x3f, 0x08, 0x24, 0x12, 0x8b, 0x2f, 0x33,
+	0x0c, 0x5c, 0x7f, 0xd0, 0xa6, 0xa3, 0xa4, 0x50,
+	0x65, 0x13, 0x27, 0x0e, 0x26, 0x9e, 0x0d, 0x37,
+	0xf2, 0xa7, 0x4d, 0xe4, 0x52, 0xe6, 0xb4, 0x39,
+};
+
+static const uint8_t public_key_a[] = {
+	0x14, 0xb8, 0xa2, 0xc9, 0x56, 0x26, 0xf1, 0x64,
+	0xe3, 0x87, 0x03, 0xbd, 0x97, 0x6b, 0x20, 0x0e,
+	0x06, 0x50, 0x50, 0x3e, 0x4b, 0x70, 0x1e, 0xcb,
+	0xf2, 0x9f, 0x96, 0xab, 0xf7, 0x86, 0xd3, 0x1f,
+	0x9b, 0x97, 0x8f, 0x67, 0xb1, 0xea, 0x48, 0x27,
+	0x36, 0xe6, 0x3b, 0x98, 0xc4, 0x45, 0x74, 0x5a,
+	0x52, 0x11, 0x35, 0xbf, 0x46, 0x8d, 0x6d, 0x0c,
+	0x16, 0x8e, 0xf6, 0x6a, 0x41, 0x63, 0xf4, 0x6f,
+};
+
+static const uint8_t private_key_b[] = {
+	0x36, 0xf6, 0x75, 0xcc, 0x81, 0xe7, 0x4e, 0xf5,
+	0xe8, 0xe2, 0x5d, 0x94, 0x0e, 0xd9, 0x04, 0x75,
+	0x95, 0x31, 0x98, 0x5d, 0x5d, 0x9d, 0xc9, 0xf8,
+	0x18, 0x18, 0xe8, 0x11, 0x89, 0x2f, 0x90, 0x2c,
+};
+
+static const uint8_t public_key_b[] = {
+	0x8d, 0xd0, 0xcb, 0x91, 0xf7, 0x83, 0x32, 0x8c,
+	0x76, 0xcb, 0xdb, 0xdc, 0x31, 0x06, 0xe4, 0x43,
+	0x5e, 0x34, 0xcd, 0x76, 0x35, 0xa7, 0x47, 0xf1,
+	0x35, 0xf4, 0x45, 0x7e, 0x8e, 0xcf, 0x1a, 0x6c,
+	0x9f, 0x41, 0x7c, 0x23, 0x84, 0x47, 0x85, 0xb2,
+	0xb1, 0xe7, 0x08, 0x53, 0xe1, 0xad, 0xf3, 0xf4,
+	0xae, 0x42, 0xc3, 0xe1, 0xdd, 0x2f, 0xdc, 0xbe,
+	0x0e, 0x23, 0x16, 0x8c, 0xfc, 0x35, 0x78, 0xb0,
+};
+
+static const uint8_t dhkey_ab[] = {
+	0x1f, 0x8c, 0xbb, 0xfb, 0x8b, 0x1c, 0x83, 0x97,
+	0x7e, 0xfe, 0x7e, 0x0f, 0x0c, 0xd3, 0x74, 0x6b,
+	0x50, 0x20, 0x09, 0x35, 0x42, 0x1a, 0x90, 0xce,
+	0xb5, 0xd5, 0x94, 0xc3, 0xbc, 0x32, 0x25, 0x60,
+};
+
+static const uint8_t dhkey_debug_a[] = {
+	0xbe, 0x8d, 0x45, 0xd4, 0x21, 0xb4, 0xf5, 0x5f,
+	0x20, 0xa0, 0xf7, 0x57, 0x5a, 0xf6, 0x8e, 0x21,
+	0x3e, 0x19, 0xbe, 0x39, 0x9c, 0x5f, 0xa7, 0xd7,
+	0x7a, 0x84, 0xca, 0x8e, 0xd5, 0x0e, 0x94, 0x84,
+};
+
+static const uint8_t order[] = {
+	0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84,
+	0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x51,
+};
@@ -0,0 +1,239 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+
+#include "host/settings.h"
+
+#define VAL_MAX CONFIG_BT_SETTINGS_WRITE_BEHIND_VAL_MAX
+#define DELAY_MS CONFIG_BT_SETTINGS_WRITE_BEHIND_DELAY_MS
+
+/* Writes received by the backend */
+struct write {
+	char name[BT_SETTINGS_KEY_MAX];
+	uint8_t val[VAL_MAX + 1];
+	size_t len;
+};
+
+static struct write writes[8];
+static size_t write_cnt;
+
+static const bt_addr_le_t peer_addr = {
+	.type = BT_ADDR_LE_RANDOM,
+	.a.val = { 0x01, 0x02, 0x03, 0x04, 0x05, 0xc6 },
+};
+
+static int ram_load(struct settings_store *cs, const struct settings_load_arg *arg)
+{
+	return 0;
+}
+
+static int ram_save(struct settings_store *cs, const char *name, const char *value,
+		    size_t val_len)
+{
+	struct write *w;
+
+	zassert_true(write_cnt < ARRAY_SIZE(writes), "Too many writes");
+	zassert_true(val_len <= sizeof(w->val), "Value too large");
+
+	w = &writes[write_cnt++];
+	strncpy(w->name, name, sizeof(w->name) - 1);
+	if (val_len) {
+		memcpy(w->val, value, val_len);
+	}
+	w->len = val_len;
+
+	return 0;
+}
+
+static const struct settings_store_itf ram_itf = {
+	.csi_load = ram_load,
+	.csi_save = ram_save,
+};
+
+static struct settings_store ram_store = {
+	.cs_itf = &ram_itf,
+};
+
+/* Backend of CONFIG_SETTINGS_CUSTOM */
+int settings_backend_init(void)
+{
+	settings_dst_register(&ram_store);
+	settings_src_register(&ram_store);
+
+	return 0;
+}
+
+static void assert_write(size_t i, const char *name, const void *val, size_t len)
+{
+	zassert_true(i < write_cnt, "Write %zu missing", i);
+	zassert_str_equal(writes[i].name, name);
+	zassert_equal(writes[i].len, len);
+	if (len) {
+		zassert_mem_equal(writes[i].val, val, len);
+	}
+}
+
+struct loaded {
+	const char *key;
+	uint8_t val[VAL_MAX];
+	ssize_t len;
+	size_t cnt;
+};
+
+static int load_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+		   void *param)
+{
+	struct loaded *l = param;
+
+	l->key = key;
+	l->len = read_cb(cb_arg, l->val, sizeof(l->val));
+	l->cnt++;
+
+	return 0;
+}
+
+static void *setup(void)
+{
+	zassert_ok(settings_subsys_init());
+
+	return NULL;
+}
+
+static void before(void *f)
+{
+	zassert_ok(bt_settings_flush());
+	memset(writes, 0, sizeof(writes));
+	write_cnt = 0;
+}
+
+ZTEST_SUITE(bt_settings_write_behind, NULL, setup, before, NULL, NULL);
+
+ZTEST(bt_settings_write_behind, test_store_deferred)
+{
+	const uint8_t val[] = { 0x01, 0x02 };
+
+	zassert_ok(bt_settings_store("name", 0, NULL, val, sizeof(val)));
+	zassert_equal(write_cnt, 0);
+
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/name", val, sizeof(val));
+
+	/* Nothing left */
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 1);
+}
+
+ZTEST(bt_settings_write_behind, test_coalesce)
+{
+	for (uint8_t i = 0; i < 5; i++) {
+		zassert_ok(bt_settings_store("name", 0, NULL, &i, sizeof(i)));
+	}
+
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/name", &(uint8_t){ 4 }, 1);
+}
+
+ZTEST(bt_settings_write_behind, test_delete)
+{
+	const uint8_t val[] = { 0x01 };
+
+	zassert_ok(bt_settings_store("ccc", 0, &peer_addr, val, sizeof(val)));
+	zassert_ok(bt_settings_delete("ccc", 0, &peer_addr));
+
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/ccc/c605040302011", NULL, 0);
+}
+
+ZTEST(bt_settings_write_behind, test_oldest_first)
+{
+	const uint8_t val[] = { 0xaa };
+
+	/* One more key than entries, the oldest is written to make room */
+	zassert_ok(bt_settings_store("a", 0, NULL, val, sizeof(val)));
+	zassert_ok(bt_settings_store("b", 0, NULL, val, sizeof(val)));
+	zassert_ok(bt_settings_store("a", 0, NULL, val, sizeof(val)));
+	zassert_equal(write_cnt, 0);
+
+	zassert_ok(bt_settings_store("c", 0, NULL, val, sizeof(val)));
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/a", val, sizeof(val));
+
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 3);
+	assert_write(1, "bt/b", val, sizeof(val));
+	assert_write(2, "bt/c", val, sizeof(val));
+}
+
+ZTEST(bt_settings_write_behind, test_large_value)
+{
+	const uint8_t small[] = { 0x01 };
+	uint8_t large[VAL_MAX + 1];
+
+	memset(large, 0x5a, sizeof(large));
+
+	/* Written now, in place of the pending value */
+	zassert_ok(bt_settings_store("name", 0, NULL, small, sizeof(small)));
+	zassert_ok(bt_settings_store("name", 0, NULL, large, sizeof(large)));
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/name", large, sizeof(large));
+
+	zassert_ok(bt_settings_flush());
+	zassert_equal(write_cnt, 1);
+}
+
+ZTEST(bt_settings_write_behind, test_load_pending)
+{
+	const uint8_t val[] = { 0x01, 0x02, 0x03 };
+	struct loaded l = {};
+
+	zassert_ok(bt_settings_store("ccc", 0, &peer_addr, val, sizeof(val)));
+	zassert_ok(bt_settings_store("name", 0, NULL, val, sizeof(val)));
+
+	bt_settings_load_pending("bt/ccc/c605040302011", load_cb, &l);
+	zassert_equal(l.cnt, 1);
+	zassert_is_null(l.key);
+	zassert_equal(l.len, sizeof(val));
+	zassert_mem_equal(l.val, val, sizeof(val));
+
+	/* Deletions are reported with no value */
+	zassert_ok(bt_settings_delete("ccc", 0, &peer_addr));
+
+	memset(&l, 0, sizeof(l));
+	bt_settings_load_pending("bt/ccc", load_cb, &l);
+	zassert_equal(l.cnt, 1);
+	zassert_str_equal(l.key, "c605040302011");
+	zassert_equal(l.len, 0);
+
+	zassert_equal(write_cnt, 0);
+}
+
+ZTEST(bt_settings_write_behind, test_delayed_flush)
+{
+	const uint8_t val[] = { 0x01 };
+
+	/* Let the flush scheduled by the previous tests expire */
+	k_sleep(K_MSEC(DELAY_MS + 10));
+
+	zassert_ok(bt_settings_store("name", 0, NULL, val, sizeof(val)));
+
+	k_sleep(K_MSEC(DELAY_MS / 2));
+	zassert_equal(write_cnt, 0);
+
+	/* Stores after the first one do not push the write back */
+	zassert_ok(bt_settings_store("name", 0, NULL, val, sizeof(val)));
+
+	k_sleep(K_MSEC(DELAY_MS / 2 + 10));
+	zassert_equal(write_cnt, 1);
+	assert_write(0, "bt/name", val, sizeof(val));
+}
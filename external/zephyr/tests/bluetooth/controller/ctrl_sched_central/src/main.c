@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/types.h>
+#include <zephyr/ztest.h>
+
+#include "ull_sched_internal.h"
+
+#define SLOT(_offset, _slot, _interval)   \
+	{                                  \
+		.offset_us = (_offset),    \
+		.slot_us = (_slot),        \
+		.interval_us = (_interval) \
+	}
+
+#define SLOT_ID(_offset, _slot, _interval, _id) \
+	{                                        \
+		.offset_us = (_offset),          \
+		.slot_us = (_slot),              \
+		.interval_us = (_interval),      \
+		.ticker_id = (_id)               \
+	}
+
+ZTEST(sched_central, test_no_central)
+{
+	uint32_t offset_us = 0U;
+	int err;
+
+	err = ull_sched_cen_packed_offset_calc(NULL, 0U, 10000U, 1000U,
+					       &offset_us);
+	zassert_equal(err, -ECHILD, "%d", err);
+}
+
+ZTEST(sched_central, test_non_harmonic)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT(0U, 2000U, 30000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       45000U, 1000U, &offset_us);
+	zassert_equal(err, -ENOTSUP, "%d", err);
+}
+
+ZTEST(sched_central, test_slot_exceeds_interval)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT(0U, 2000U, 10000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       10000U, 10000U, &offset_us);
+	zassert_equal(err, -ENOSPC, "%d", err);
+}
+
+ZTEST(sched_central, test_after_single)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT(1000U, 2000U, 10000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       10000U, 1500U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 3000U, "%u", offset_us);
+}
+
+ZTEST(sched_central, test_earliest_gap)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT(3000U, 2000U, 10000U),
+		SLOT(0U, 2000U, 10000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	/* Gap between the two events is too small, place after the last */
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       10000U, 1500U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 5000U, "%u", offset_us);
+
+	/* Fits in the gap between the two events */
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       10000U, 900U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 2000U, "%u", offset_us);
+}
+
+ZTEST(sched_central, test_wrap_around)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT(9000U, 2000U, 10000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	err = ull_sched_cen_packed_offset_calc(slots, ARRAY_SIZE(slots),
+					       10000U, 1000U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 1000U, "%u", offset_us);
+}
+
+ZTEST(sched_central, test_harmonic_intervals)
+{
+	const struct ull_sched_cen_slot slots_long[] = {
+		SLOT(0U, 2000U, 20000U),
+	};
+	const struct ull_sched_cen_slot slots_short[] = {
+		SLOT(0U, 3000U, 5000U),
+	};
+	uint32_t offset_us = 0U;
+	int err;
+
+	/* Active role interval a multiple of the new interval */
+	err = ull_sched_cen_packed_offset_calc(slots_long,
+					       ARRAY_SIZE(slots_long),
+					       10000U, 2000U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 2000U, "%u", offset_us);
+
+	/* New interval a multiple of the active role interval, the event
+	 * fits in the 2 ms left every 5 ms.
+	 */
+	err = ull_sched_cen_packed_offset_calc(slots_short,
+					       ARRAY_SIZE(slots_short),
+					       10000U, 2000U, &offset_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(offset_us, 3000U, "%u", offset_us);
+
+	/* Does not fit in the 2 ms left every 5 ms */
+	err = ull_sched_cen_packed_offset_calc(slots_short,
+					       ARRAY_SIZE(slots_short),
+					       10000U, 2500U, &offset_us);
+	zassert_equal(err, -ENOSPC, "%d", err);
+}
+
+ZTEST(sched_central, test_budget_no_link)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT_ID(0U, 2000U, 10000U, 3U),
+	};
+	uint32_t budget_us = 0U;
+	int err;
+
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 4U,
+					     &budget_us);
+	zassert_equal(err, -ENOENT, "%d", err);
+}
+
+ZTEST(sched_central, test_budget_single)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT_ID(1000U, 2000U, 10000U, 3U),
+	};
+	uint32_t budget_us = 0U;
+	int err;
+
+	/* The whole interval when alone */
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 3U,
+					     &budget_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(budget_us, 10000U, "%u", budget_us);
+}
+
+ZTEST(sched_central, test_budget_next_event)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT_ID(0U, 2000U, 10000U, 3U),
+		SLOT_ID(2000U, 2000U, 10000U, 4U),
+		SLOT_ID(6000U, 2000U, 20000U, 5U),
+	};
+	uint32_t budget_us = 0U;
+	int err;
+
+	/* Up to the start of the back-to-back event */
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 3U,
+					     &budget_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(budget_us, 2000U, "%u", budget_us);
+
+	/* Up to the event with the longer, harmonic interval */
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 4U,
+					     &budget_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(budget_us, 4000U, "%u", budget_us);
+
+	/* Up to the first event of the next interval, wrapping around */
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 5U,
+					     &budget_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(budget_us, 4000U, "%u", budget_us);
+}
+
+ZTEST(sched_central, test_budget_non_harmonic)
+{
+	const struct ull_sched_cen_slot slots[] = {
+		SLOT_ID(0U, 2000U, 10000U, 3U),
+		SLOT_ID(5000U, 2000U, 15000U, 4U),
+	};
+	uint32_t budget_us = 0U;
+	int err;
+
+	/* Only the own reservation is guaranteed */
+	err = ull_sched_cen_slot_budget_calc(slots, ARRAY_SIZE(slots), 3U,
+					     &budget_us);
+	zassert_equal(err, 0, "%d", err);
+	zassert_equal(budget_us, 2000U, "%u", budget_us);
+}
+
+ZTEST_SUITE(sched_central, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "mocks/aes.h"
+
+#include <zephyr/bluetooth/crypto.h>
+#include <zephyr/fff.h>
+#include <zephyr/kernel.h>
+
+#include <host/crypto.h>
+
+DEFINE_FFF_GLOBALS;
+
+static void fff_reset_rule_before(const struct ztest_unit_test *test, void *fixture)
+{
+	AES_FFF_FAKES_LIST(RESET_FAKE);
+}
+
+ZTEST_RULE(fff_reset_rule, fff_reset_rule_before, NULL);
+
+ZTEST_SUITE(bt_aes_ctx, NULL, NULL, NULL, NULL, NULL);
+
+/*
+ *  Test bt_aes_ctx_init() expands the key into the context
+ *
+ *  Constraints:
+ *   - tc_aes128_set_encrypt_key() succeeds and returns 'TC_CRYPTO_SUCCESS'.
+ *
+ *  Expected behaviour:
+ *   - bt_aes_ctx_init() returns 0 (success)
+ *   - tc_aes128_set_encrypt_key() is called once with the context schedule and the key
+ */
+ZTEST(bt_aes_ctx, test_bt_aes_ctx_init_succeeds)
+{
+	int err;
+	struct bt_aes_ctx ctx;
+	const uint8_t key[16] = {0};
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_SUCCESS;
+
+	err = bt_aes_ctx_init(&ctx, key);
+
+	zassert_ok(err, "Unexpected error code '%d' was returned", err);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 1);
+	zassert_equal_ptr(tc_aes128_set_encrypt_key_fake.arg0_val, (void *)ctx.sched);
+	zassert_equal_ptr(tc_aes128_set_encrypt_key_fake.arg1_val, key);
+}
+
+/*
+ *  Test bt_aes_ctx_init() fails when tc_aes128_set_encrypt_key() fails
+ *
+ *  Constraints:
+ *   - tc_aes128_set_encrypt_key() fails and returns 'TC_CRYPTO_FAIL'.
+ *
+ *  Expected behaviour:
+ *   - bt_aes_ctx_init() returns a negative error code (failure)
+ */
+ZTEST(bt_aes_ctx, test_bt_aes_ctx_init_fails)
+{
+	int err;
+	struct bt_aes_ctx ctx;
+	const uint8_t key[16] = {0};
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_FAIL;
+
+	err = bt_aes_ctx_init(&ctx, key);
+
+	zassert_true(err < 0, "Unexpected error code '%d' was returned", err);
+}
+
+/*
+ *  Test encrypting several blocks with one context
+ *
+ *  Constraints:
+ *   - tc_aes128_set_encrypt_key() succeeds and returns 'TC_CRYPTO_SUCCESS'.
+ *   - tc_aes_encrypt() succeeds and returns 'TC_CRYPTO_SUCCESS'.
+ *
+ *  Expected behaviour:
+ *   - The key is expanded once
+ *   - tc_aes_encrypt() is called once per block with the context schedule
+ */
+ZTEST(bt_aes_ctx, test_bt_aes_ctx_encrypt_be_many_blocks)
+{
+	int err;
+	struct bt_aes_ctx ctx;
+	const uint8_t key[16] = {0};
+	const uint8_t plaintext[16] = {0};
+	uint8_t enc_data[16] = {0};
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_SUCCESS;
+	tc_aes_encrypt_fake.return_val = TC_CRYPTO_SUCCESS;
+
+	err = bt_aes_ctx_init(&ctx, key);
+	zassert_ok(err, "Unexpected error code '%d' was returned", err);
+
+	for (int i = 0; i < 3; i++) {
+		err = bt_aes_ctx_encrypt_be(&ctx, plaintext, enc_data);
+		zassert_ok(err, "Unexpected error code '%d' was returned", err);
+	}
+
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 1);
+	zassert_equal(tc_aes_encrypt_fake.call_count, 3);
+	zassert_equal_ptr(tc_aes_encrypt_fake.arg0_val, enc_data);
+	zassert_equal_ptr(tc_aes_encrypt_fake.arg1_val, plaintext);
+	zassert_equal_ptr(tc_aes_encrypt_fake.arg2_val, (void *)ctx.sched);
+}
+
+/*
+ *  Test bt_aes_ctx_encrypt_be() fails when tc_aes_encrypt() fails
+ *
+ *  Constraints:
+ *   - tc_aes_encrypt() fails and returns 'TC_CRYPTO_FAIL'.
+ *
+ *  Expected behaviour:
+ *   - bt_aes_ctx_encrypt_be() returns a negative error code (failure)
+ */
+ZTEST(bt_aes_ctx, test_bt_aes_ctx_encrypt_be_fails)
+{
+	int err;
+	struct bt_aes_ctx ctx = {0};
+	const uint8_t plaintext[16] = {0};
+	uint8_t enc_data[16] = {0};
+
+	tc_aes_encrypt_fake.return_val = TC_CRYPTO_FAIL;
+
+	err = bt_aes_ctx_encrypt_be(&ctx, plaintext, enc_data);
+
+	zassert_true(err < 0, "Unexpected error code '%d' was returned", err);
+}
+
+/*
+ *  Test bt_aes_ctx_clear() erases the key schedule
+ *
+ *  Expected behaviour:
+ *   - The context is zeroed
+ */
+ZTEST(bt_aes_ctx, test_bt_aes_ctx_clear)
+{
+	struct bt_aes_ctx ctx;
+	const struct bt_aes_ctx zero = {0};
+
+	memset(&ctx, 0xa5, sizeof(ctx));
+
+	bt_aes_ctx_clear(&ctx);
+
+	zassert_mem_equal(&ctx, &zero, sizeof(ctx));
+}
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "mocks/aes.h"
+
+#include <zephyr/bluetooth/crypto.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <host/crypto.h>
+
+static const uint8_t key_a[16] = {0xa0};
+static const uint8_t key_b[16] = {0xb0};
+static const uint8_t key_c[16] = {0xc0};
+
+static void key_cache_before(void *f)
+{
+	bt_crypto_key_cache_clear();
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_SUCCESS;
+	tc_aes_encrypt_fake.return_val = TC_CRYPTO_SUCCESS;
+}
+
+ZTEST_SUITE(bt_crypto_key_cache, NULL, NULL, key_cache_before, NULL, NULL);
+
+static void encrypt_be(const uint8_t key[16])
+{
+	const uint8_t plaintext[16] = {0};
+	uint8_t enc_data[16];
+	int err;
+
+	err = bt_encrypt_be(key, plaintext, enc_data);
+	zassert_ok(err, "Unexpected error code '%d' was returned", err);
+}
+
+/*
+ *  Test reusing a key skips the key expansion
+ *
+ *  Expected behaviour:
+ *   - tc_aes128_set_encrypt_key() is called once
+ *   - tc_aes_encrypt() is called for every block
+ */
+ZTEST(bt_crypto_key_cache, test_same_key_expanded_once)
+{
+	encrypt_be(key_a);
+	encrypt_be(key_a);
+	encrypt_be(key_a);
+
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 1);
+	zassert_equal(tc_aes_encrypt_fake.call_count, 3);
+}
+
+/*
+ *  Test bt_encrypt_le() and bt_encrypt_be() share cache entries
+ *
+ *  Expected behaviour:
+ *   - A little-endian key hits the entry of the same big-endian key
+ */
+ZTEST(bt_crypto_key_cache, test_le_be_share_entry)
+{
+	const uint8_t plaintext[16] = {0};
+	uint8_t enc_data[16];
+	uint8_t key_le[16];
+	int err;
+
+	sys_memcpy_swap(key_le, key_a, sizeof(key_le));
+
+	encrypt_be(key_a);
+
+	err = bt_encrypt_le(key_le, plaintext, enc_data);
+	zassert_ok(err, "Unexpected error code '%d' was returned", err);
+
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 1);
+}
+
+/*
+ *  Test the least recently used key is evicted
+ *
+ *  Constraints:
+ *   - The cache holds two keys
+ *
+ *  Expected behaviour:
+ *   - Using a third key evicts the least recently used one only
+ */
+ZTEST(bt_crypto_key_cache, test_lru_eviction)
+{
+	encrypt_be(key_a);
+	encrypt_be(key_b);
+	encrypt_be(key_a);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 2);
+
+	/* Evicts key B */
+	encrypt_be(key_c);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 3);
+
+	encrypt_be(key_a);
+	encrypt_be(key_c);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 3);
+
+	encrypt_be(key_b);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 4);
+	zassert_mem_equal(tc_aes128_set_encrypt_key_fake.arg1_val, key_b, 16);
+}
+
+/*
+ *  Test a failed key expansion is not cached
+ *
+ *  Constraints:
+ *   - tc_aes128_set_encrypt_key() fails once and returns 'TC_CRYPTO_FAIL'.
+ *
+ *  Expected behaviour:
+ *   - bt_encrypt_be() fails, and the next call expands the key again
+ */
+ZTEST(bt_crypto_key_cache, test_failed_expansion_not_cached)
+{
+	const uint8_t plaintext[16] = {0};
+	uint8_t enc_data[16];
+	int err;
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_FAIL;
+
+	err = bt_encrypt_be(key_a, plaintext, enc_data);
+	zassert_true(err < 0, "Unexpected error code '%d' was returned", err);
+
+	tc_aes128_set_encrypt_key_fake.return_val = TC_CRYPTO_SUCCESS;
+
+	encrypt_be(key_a);
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 2);
+}
+
+/*
+ *  Test bt_crypto_key_cache_clear() drops all the cached keys
+ *
+ *  Expected behaviour:
+ *   - Keys are expanded again after the cache is cleared
+ */
+ZTEST(bt_crypto_key_cache, test_clear)
+{
+	encrypt_be(key_a);
+	encrypt_be(key_b);
+
+	bt_crypto_key_cache_clear();
+
+	encrypt_be(key_a);
+	encrypt_be(key_b);
+
+	zassert_equal(tc_aes128_set_encrypt_key_fake.call_count, 4);
+}
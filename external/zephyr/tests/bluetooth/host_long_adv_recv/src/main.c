@@ -243,7 +243,7 @@ struct bt_recv_job_data {
 	struct k_work work; /* Work item */
 	struct k_sem *sync; /* Semaphore to synchronize with */
 	struct net_buf *buf; /* Net buffer to be passed to bt_recv() */
-} job_data[CONFIG_BT_BUF_EVT_RX_COUNT];
+} job_data[MAX(CONFIG_BT_BUF_EVT_RX_COUNT, CONFIG_BT_BUF_EVT_DISCARDABLE_COUNT)];
 
 #define job(buf) (&job_data[net_buf_id(buf)])
 
@@ -310,7 +310,11 @@ static void send_adv_report(const struct test_adv_report *report)
 	struct net_buf *buf;
 	uint8_t *adv_data;
 
-	buf = bt_buf_get_rx(BT_BUF_EVT, K_FOREVER);
+	/* Reports are discardable, as for the Zephyr controller. Event buffers
+	 * still referenced by the host would exhaust the pool.
+	 */
+	buf = bt_buf_get_evt(BT_HCI_EVT_LE_META_EVENT, true, K_SECONDS(1));
+	zassert_not_null(buf, "No event buffer available");
 	adv_data = adv_report_evt(buf, report->length, report->evt_prop, &report->addr);
 	memcpy(adv_data, &report->data, report->length);
 
@@ -337,6 +341,9 @@ static void scan_timeout_cb(void)
 	zassert_unreachable("Timeout should not happen");
 }
 
+static struct bt_le_scan_cb scan_callbacks = { .recv = scan_recv_cb,
+					       .timeout = scan_timeout_cb };
+
 static void generate_sequence(uint8_t *dest, uint16_t len, uint8_t range_start, uint8_t range_end)
 {
 	uint16_t written = 0;
@@ -351,21 +358,24 @@ static void generate_sequence(uint8_t *dest, uint16_t len, uint8_t range_start,
 	}
 }
 
-ZTEST_SUITE(long_adv_rx_tests, NULL, NULL, NULL, NULL, NULL);
-
-ZTEST(long_adv_rx_tests, test_host_long_adv_recv)
+static void *long_adv_rx_setup(void)
 {
-	struct test_adv_report expected_reports[2];
-
 	/* Register the test HCI driver */
 	bt_hci_driver_register(&drv);
 
 	/* Go! Wait until Bluetooth initialization is done  */
 	zassert_true((bt_enable(NULL) == 0), "bt_enable failed");
 
-	static struct bt_le_scan_cb scan_callbacks = { .recv = scan_recv_cb,
-						       .timeout = scan_timeout_cb };
 	bt_le_scan_cb_register(&scan_callbacks);
+
+	return NULL;
+}
+
+ZTEST_SUITE(long_adv_rx_tests, NULL, long_adv_rx_setup, NULL, NULL, NULL);
+
+ZTEST(long_adv_rx_tests, test_host_long_adv_recv)
+{
+	struct test_adv_report expected_reports[2];
 	bt_addr_le_t addr_a;
 	bt_addr_le_t addr_b;
 	bt_addr_le_t addr_c;
@@ -488,3 +498,151 @@ ZTEST(long_adv_rx_tests, test_host_long_adv_recv)
 	send_adv_report(&report_b_2);
 	zassert_equal(1, get_expected_report_fake.call_count);
 }
+
+#if defined(CONFIG_BT_EXT_SCAN_FRAG_CHAIN)
+/* Number of event buffers the host references for a fragmented report, half
+ * of the discardable pool the reports are received in.
+ */
+#define EXT_SCAN_FRAGS_MAX (CONFIG_BT_BUF_EVT_DISCARDABLE_COUNT / 2)
+
+BUILD_ASSERT(EXT_SCAN_FRAGS_MAX >= 2, "Test needs fragments delivered as chain");
+BUILD_ASSERT((EXT_SCAN_FRAGS_MAX + 1) * 20 <= CONFIG_BT_EXT_SCAN_BUF_SIZE);
+
+/* Advertising data and fragment count expected by scan_recv_frags_cb() */
+static struct test_adv_report expected_frags_report;
+static uint8_t expected_frags;
+static uint8_t frags_call_count;
+
+static void scan_recv_frags_cb(const struct bt_le_scan_recv_info *info, struct net_buf *frags)
+{
+	uint16_t offset = 0U;
+	uint8_t count = 0U;
+
+	ARG_UNUSED(info);
+
+	frags_call_count++;
+
+	zassert_equal(net_buf_frags_len(frags), expected_frags_report.length,
+		      "Lengths should be equal");
+
+	for (struct net_buf *frag = frags; frag; frag = frag->frags) {
+		zassert_mem_equal(frag->data, &expected_frags_report.data[offset], frag->len,
+				  "Data should be equal");
+		offset += frag->len;
+		count++;
+	}
+
+	zassert_equal(count, expected_frags, "Unexpected number of fragments");
+}
+
+static struct bt_le_scan_cb scan_frags_callbacks = { .recv_frags = scan_recv_frags_cb };
+
+ZTEST(long_adv_rx_tests, test_host_long_adv_recv_frags)
+{
+	struct test_adv_report expected_reports[2];
+	bt_addr_le_t addr_a;
+	bt_addr_le_t addr_c;
+
+	RESET_FAKE(get_expected_report);
+	FFF_RESET_HISTORY();
+
+	bt_le_scan_cb_register(&scan_frags_callbacks);
+
+	bt_addr_le_create_static(&addr_a);
+	bt_addr_le_create_static(&addr_c);
+
+	struct test_adv_report report_a_1 = { .length = 30, .evt_prop = MORE_TO_COME };
+	struct test_adv_report report_a_2 = { .length = 30, .evt_prop = COMPLETE };
+	struct test_adv_report report_c = { .length = 30,
+					    .evt_prop = COMPLETE | BT_HCI_LE_ADV_EVT_TYPE_LEGACY };
+	struct test_adv_report report_a_combined = { .length = report_a_1.length +
+							       report_a_2.length };
+
+	bt_addr_le_copy(&report_a_1.addr, &addr_a);
+	bt_addr_le_copy(&report_a_2.addr, &addr_a);
+	bt_addr_le_copy(&report_c.addr, &addr_c);
+
+	generate_sequence(report_a_combined.data, report_a_combined.length, 'A', 'Z');
+	generate_sequence(report_c.data, report_c.length, '0', '9');
+
+	(void)memcpy(report_a_1.data, report_a_combined.data, report_a_1.length);
+	(void)memcpy(report_a_2.data, &report_a_combined.data[report_a_1.length],
+		     report_a_2.length);
+
+	/* Check that fragmented adv reports are delivered as a chain of the
+	 * reports, while listeners without recv_frags get the data reassembled.
+	 */
+	expected_reports[0] = report_a_combined;
+	SET_RETURN_SEQ(get_expected_report, expected_reports, 1);
+	expected_frags_report = report_a_combined;
+	expected_frags = 2U;
+	frags_call_count = 0U;
+	send_adv_report(&report_a_1);
+	send_adv_report(&report_a_2);
+	zassert_equal(1, frags_call_count);
+	zassert_equal(1, get_expected_report_fake.call_count);
+	RESET_FAKE(get_expected_report);
+	FFF_RESET_HISTORY();
+
+	/* Check that legacy adv reports are delivered as a single fragment */
+	expected_reports[0] = report_c;
+	SET_RETURN_SEQ(get_expected_report, expected_reports, 1);
+	expected_frags_report = report_c;
+	expected_frags = 1U;
+	frags_call_count = 0U;
+	send_adv_report(&report_c);
+	zassert_equal(1, frags_call_count);
+	zassert_equal(1, get_expected_report_fake.call_count);
+	RESET_FAKE(get_expected_report);
+	FFF_RESET_HISTORY();
+
+	/* Check that reports with more fragments than event buffers the host
+	 * references are reassembled by copying, for recv listeners only.
+	 */
+	struct test_adv_report report_e = { .evt_prop = MORE_TO_COME };
+	struct test_adv_report report_e_last = { .length = 20, .evt_prop = COMPLETE };
+	struct test_adv_report report_e_combined = {
+		.length = (EXT_SCAN_FRAGS_MAX + 1) * report_e_last.length
+	};
+
+	bt_addr_le_copy(&report_e.addr, &addr_a);
+	bt_addr_le_copy(&report_e_last.addr, &addr_a);
+	generate_sequence(report_e_combined.data, report_e_combined.length, 'a', 'z');
+
+	expected_reports[0] = report_e_combined;
+	SET_RETURN_SEQ(get_expected_report, expected_reports, 1);
+	frags_call_count = 0U;
+	for (int i = 0; i < EXT_SCAN_FRAGS_MAX; i++) {
+		report_e.length = report_e_last.length;
+		(void)memcpy(report_e.data, &report_e_combined.data[i * report_e.length],
+			     report_e.length);
+		send_adv_report(&report_e);
+	}
+	(void)memcpy(report_e_last.data,
+		     &report_e_combined.data[EXT_SCAN_FRAGS_MAX * report_e_last.length],
+		     report_e_last.length);
+	send_adv_report(&report_e_last);
+	zassert_equal(0, frags_call_count);
+	zassert_equal(1, get_expected_report_fake.call_count);
+	RESET_FAKE(get_expected_report);
+	FFF_RESET_HISTORY();
+
+	/* Check that the host releases the event buffers of the fragments once
+	 * delivered, by reassembling more reports than there are event buffers.
+	 */
+	for (int i = 0; i < CONFIG_BT_BUF_EVT_DISCARDABLE_COUNT; i++) {
+		expected_reports[0] = report_a_combined;
+		SET_RETURN_SEQ(get_expected_report, expected_reports, 1);
+		expected_frags_report = report_a_combined;
+		expected_frags = 2U;
+		frags_call_count = 0U;
+		send_adv_report(&report_a_1);
+		send_adv_report(&report_a_2);
+		zassert_equal(1, frags_call_count);
+		RESET_FAKE(get_expected_report);
+		FFF_RESET_HISTORY();
+	}
+
+	bt_le_scan_cb_unregister(&scan_frags_callbacks);
+}
+#endif /* CONFIG_BT_EXT_SCAN_FRAG_CHAIN */
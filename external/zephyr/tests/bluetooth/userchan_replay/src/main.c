@@ -0,0 +1,34 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/addr.h>
+#include <zephyr/ztest.h>
+
+/* init.btsnoop holds the responses of an LE only controller to the
+ * commands sent by bt_enable(), among them several LE Rand commands. The
+ * User Channel driver stops the replay if a response does not answer the
+ * command sent by the host, which fails this test.
+ */
+ZTEST(userchan_replay, test_enable)
+{
+	const bt_addr_le_t expected = {
+		.type = BT_ADDR_LE_PUBLIC,
+		.a.val = { 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 },
+	};
+	bt_addr_le_t addrs[CONFIG_BT_ID_MAX];
+	size_t count = ARRAY_SIZE(addrs);
+	int err;
+
+	err = bt_enable(NULL);
+	zassert_ok(err, "Bluetooth init failed (err %d)", err);
+
+	/* The identity is the public address read last from the trace */
+	bt_id_get(addrs, &count);
+	zassert_equal(count, 1U, "%zu identities", count);
+	zassert_true(bt_addr_le_eq(&addrs[0], &expected),
+		     "Identity not read from the trace");
+}
+
+ZTEST_SUITE(userchan_replay, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,285 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include "common.h"
+
+#define BENCH_CONN_PARAM BT_LE_CONN_PARAM(BENCH_CONN_INTERVAL, \
+					  BENCH_CONN_INTERVAL, 0, 400)
+
+struct bench_peer {
+	struct bt_conn *conn;
+	struct bt_gatt_subscribe_params sub;
+	struct bt_gatt_exchange_params mtu;
+	struct bt_gatt_read_params read;
+	uint32_t read_start_us;
+};
+
+static struct bench_peer peers[CONFIG_BT_MAX_CONN];
+static uint8_t peer_count;
+
+static K_SEM_DEFINE(sem_connected, 0, 1);
+static K_SEM_DEFINE(sem_gatt, 0, 1);
+
+static uint64_t rx_bytes;
+static uint32_t rx_count;
+static uint64_t latency_us_sum;
+static uint32_t latency_us_max;
+static uint32_t rtt_count;
+static uint64_t rtt_us_sum;
+static uint32_t rtt_us_max;
+
+static bool measuring;
+
+static bool ad_name_match(struct bt_data *data, void *user_data)
+{
+	bool *match = user_data;
+
+	if ((data->type == BT_DATA_NAME_COMPLETE) &&
+	    (data->data_len == (sizeof(CONFIG_BT_DEVICE_NAME) - 1)) &&
+	    !memcmp(data->data, CONFIG_BT_DEVICE_NAME, data->data_len)) {
+		*match = true;
+
+		return false;
+	}
+
+	return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+			 struct net_buf_simple *ad)
+{
+	struct bt_conn *conn;
+	bool match = false;
+	int err;
+
+	if (type != BT_GAP_ADV_TYPE_ADV_IND) {
+		return;
+	}
+
+	bt_data_parse(ad, ad_name_match, &match);
+	if (!match) {
+		return;
+	}
+
+	err = bt_le_scan_stop();
+	if (err) {
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BENCH_CONN_PARAM,
+				&conn);
+	if (err) {
+		printk("Create connection failed (err %d)\n", err);
+		(void)bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+		return;
+	}
+
+	/* Reference is kept by peers[] once connected */
+	bt_conn_unref(conn);
+}
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (bt_conn_get_info(conn, &info) || (info.role != BT_CONN_ROLE_CENTRAL)) {
+		return;
+	}
+
+	if (err) {
+		printk("Connection failed (err 0x%02x)\n", err);
+		(void)bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+		return;
+	}
+
+	peers[peer_count++].conn = bt_conn_ref(conn);
+	k_sem_give(&sem_connected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+};
+
+static uint8_t notified(struct bt_conn *conn,
+			struct bt_gatt_subscribe_params *params,
+			const void *data, uint16_t length)
+{
+	const struct bench_hdr *hdr = data;
+	uint32_t latency_us;
+
+	if (!data || !measuring || (length < sizeof(*hdr))) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	latency_us = bench_timestamp_us() - sys_le32_to_cpu(hdr->timestamp_us);
+
+	rx_bytes += length;
+	rx_count++;
+	latency_us_sum += latency_us;
+	if (latency_us > latency_us_max) {
+		latency_us_max = latency_us;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void subscribed(struct bt_conn *conn, uint8_t err,
+		       struct bt_gatt_subscribe_params *params)
+{
+	k_sem_give(&sem_gatt);
+}
+
+static void mtu_exchanged(struct bt_conn *conn, uint8_t err,
+			  struct bt_gatt_exchange_params *params)
+{
+	k_sem_give(&sem_gatt);
+}
+
+static uint8_t read_done(struct bt_conn *conn, uint8_t err,
+			 struct bt_gatt_read_params *params,
+			 const void *data, uint16_t length)
+{
+	struct bench_peer *peer = CONTAINER_OF(params, struct bench_peer, read);
+	uint32_t rtt_us;
+
+	/* Single attribute read completes with the first callback */
+	rtt_us = bench_timestamp_us() - peer->read_start_us;
+	rtt_count++;
+	rtt_us_sum += rtt_us;
+	if (rtt_us > rtt_us_max) {
+		rtt_us_max = rtt_us;
+	}
+
+	k_sem_give(&sem_gatt);
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int peer_setup(struct bench_peer *peer, uint16_t value_handle)
+{
+	int err;
+
+	peer->mtu.func = mtu_exchanged;
+	err = bt_gatt_exchange_mtu(peer->conn, &peer->mtu);
+	if (err) {
+		return err;
+	}
+	k_sem_take(&sem_gatt, K_FOREVER);
+
+	peer->sub.notify = notified;
+	peer->sub.subscribe = subscribed;
+	peer->sub.value = BT_GATT_CCC_NOTIFY;
+	peer->sub.value_handle = value_handle;
+	peer->sub.ccc_handle = value_handle + 1U;
+	err = bt_gatt_subscribe(peer->conn, &peer->sub);
+	if (err) {
+		return err;
+	}
+	k_sem_take(&sem_gatt, K_FOREVER);
+
+	peer->read.func = read_done;
+	peer->read.handle_count = 1U;
+	peer->read.single.handle = value_handle;
+	peer->read.single.offset = 0U;
+
+	return 0;
+}
+
+static void rtt_probe(void)
+{
+	for (uint8_t i = 0U; i < peer_count; i++) {
+		struct bench_peer *peer = &peers[i];
+
+		peer->read_start_us = bench_timestamp_us();
+		if (bt_gatt_read(peer->conn, &peer->read)) {
+			continue;
+		}
+
+		/* Bound the wait to a few connection intervals, a lost
+		 * response is accounted in the maximum of the next probe.
+		 */
+		(void)k_sem_take(&sem_gatt, K_MSEC(BENCH_RTT_PERIOD_MS));
+	}
+}
+
+int central_bench(uint8_t conn_count, uint32_t duration_ms,
+		  struct bench_result *result)
+{
+	uint16_t value_handle;
+	uint32_t start_us;
+	int64_t end;
+	int err;
+
+	if ((conn_count == 0U) || (conn_count > ARRAY_SIZE(peers))) {
+		return -EINVAL;
+	}
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return err;
+	}
+
+	/* Connections are established one at a time, the controller places
+	 * each new central anchor relative to the existing ones.
+	 */
+	while (peer_count < conn_count) {
+		err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+		if (err) {
+			printk("Scanning failed to start (err %d)\n", err);
+			return err;
+		}
+
+		k_sem_take(&sem_connected, K_FOREVER);
+	}
+
+	value_handle = bench_value_handle();
+	for (uint8_t i = 0U; i < peer_count; i++) {
+		err = peer_setup(&peers[i], value_handle);
+		if (err) {
+			printk("Peer %u setup failed (err %d)\n", i, err);
+			return err;
+		}
+	}
+
+	measuring = true;
+	start_us = bench_timestamp_us();
+	end = k_uptime_get() + duration_ms;
+	while (k_uptime_get() < end) {
+		rtt_probe();
+		k_sleep(K_MSEC(BENCH_RTT_PERIOD_MS));
+	}
+	measuring = false;
+
+	result->conn_count = peer_count;
+	result->duration_ms = (bench_timestamp_us() - start_us) / USEC_PER_MSEC;
+	result->rx_bytes = rx_bytes;
+	result->rx_count = rx_count;
+	result->latency_us_avg = rx_count ? (latency_us_sum / rx_count) : 0U;
+	result->latency_us_max = latency_us_max;
+	result->rtt_count = rtt_count;
+	result->rtt_us_avg = rtt_count ? (rtt_us_sum / rtt_count) : 0U;
+	result->rtt_us_max = rtt_us_max;
+
+	for (uint8_t i = 0U; i < peer_count; i++) {
+		(void)bt_conn_disconnect(peers[i].conn,
+					 BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		bt_conn_unref(peers[i].conn);
+		peers[i].conn = NULL;
+	}
+
+	return 0;
+}
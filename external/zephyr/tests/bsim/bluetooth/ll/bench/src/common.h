@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Connection interval used towards every peripheral, 50 ms */
+#define BENCH_CONN_INTERVAL   40U
+
+/* Notification payload, fills a single 251 octets Data Length PDU */
+#define BENCH_PAYLOAD_LEN     244U
+
+/* Notifications each peripheral keeps outstanding in its host */
+#define BENCH_NOTIFY_INFLIGHT 2U
+
+/* Interval between ATT round trip probes issued by the central */
+#define BENCH_RTT_PERIOD_MS   200U
+
+/* 128-bit UUIDs of the benchmark service and its characteristic */
+#define BENCH_SVC_UUID \
+	BT_UUID_128_ENCODE(0xb7a1c0de, 0x5a3c, 0x4f1e, 0x9d2a, 0x6b0e0f000001)
+#define BENCH_CHRC_UUID \
+	BT_UUID_128_ENCODE(0xb7a1c0de, 0x5a3c, 0x4f1e, 0x9d2a, 0x6b0e0f000002)
+
+/* Header of every notification payload, remainder is padding */
+struct bench_hdr {
+	uint32_t seq;
+	uint32_t timestamp_us;
+} __packed;
+
+struct bench_result {
+	uint8_t  conn_count;
+	uint32_t duration_ms;
+	uint64_t rx_bytes;
+	uint32_t rx_count;
+	uint32_t latency_us_avg;
+	uint32_t latency_us_max;
+	uint32_t rtt_count;
+	uint32_t rtt_us_avg;
+	uint32_t rtt_us_max;
+};
+
+/* Both roles run from the same image, hence the same GATT database and the
+ * same attribute handles; the central uses its local handles to address
+ * the peripherals' characteristic without a discovery procedure.
+ */
+uint16_t bench_value_handle(void);
+
+/* Simulated devices boot together off the same simulated clock, making the
+ * uptime usable as a common timebase for one-way latencies.
+ */
+static inline uint32_t bench_timestamp_us(void)
+{
+	return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+int central_bench(uint8_t conn_count, uint32_t duration_ms,
+		  struct bench_result *result);
+int peripheral_bench(void);
@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+
+#include "subsys/bluetooth/controller/ll_sw/nordic/lll/lll_prof_internal.h"
+
+#include "bs_types.h"
+#include "bs_tracing.h"
+#include "bs_cmd_line.h"
+#include "time_machine.h"
+#include "bstests.h"
+
+#include "common.h"
+
+#define FAIL(...)					\
+	do {						\
+		bst_result = Failed;			\
+		bs_trace_error_time_line(__VA_ARGS__);	\
+	} while (0)
+
+#define PASS(...)					\
+	do {						\
+		bst_result = Passed;			\
+		bs_trace_info_time(1, __VA_ARGS__);	\
+	} while (0)
+
+extern enum bst_result_t bst_result;
+
+static int peripherals = 1;
+static int duration_ms = 5000;
+
+/* Report format, one metric per line, parsed by tests_scripts/_bench.source:
+ *   BENCH,<connections>,<metric>,<value>
+ */
+static void report(uint8_t conns, const char *metric, uint32_t value)
+{
+	printk("BENCH,%u,%s,%u\n", conns, metric, value);
+}
+
+static void test_central_main(void)
+{
+	struct lll_prof_stats prof;
+	struct bench_result res;
+	uint32_t throughput;
+	int err;
+
+	err = central_bench(peripherals, duration_ms, &res);
+	if (err) {
+		FAIL("Central benchmark failed (err %d)\n", err);
+		return;
+	}
+
+	throughput = res.duration_ms ?
+		     ((res.rx_bytes * 8U * MSEC_PER_SEC) / res.duration_ms) : 0U;
+
+	report(res.conn_count, "throughput_bps", throughput);
+	report(res.conn_count, "notify_count", res.rx_count);
+	report(res.conn_count, "notify_latency_us_avg", res.latency_us_avg);
+	report(res.conn_count, "notify_latency_us_max", res.latency_us_max);
+	report(res.conn_count, "att_rtt_us_avg", res.rtt_us_avg);
+	report(res.conn_count, "att_rtt_us_max", res.rtt_us_max);
+
+	lll_prof_stats_get(&prof);
+	report(res.conn_count, "event_skips", prof.event_skips);
+	report(res.conn_count, "isr_latency_us_max", prof.latency_max);
+	report(res.conn_count, "isr_cputime_us_max", prof.cputime_max);
+	report(res.conn_count, "radio_us_max", prof.cputime_radio);
+	report(res.conn_count, "lll_us_max", prof.cputime_lll);
+	report(res.conn_count, "ull_high_us_max", prof.cputime_ull_high);
+	report(res.conn_count, "ticker_job_us_max", prof.cputime_ull_low);
+
+	if (!res.rx_count || !res.rtt_count) {
+		FAIL("Central benchmark collected no samples\n");
+	} else {
+		PASS("Central benchmark done\n");
+	}
+
+	/* Let the disconnections reach the peripherals */
+	k_sleep(K_SECONDS(1));
+
+	bs_trace_silent_exit(0);
+}
+
+static void test_peripheral_main(void)
+{
+	int err;
+
+	err = peripheral_bench();
+	if (err) {
+		FAIL("Peripheral benchmark failed (err %d)\n", err);
+	} else {
+		PASS("Peripheral benchmark done\n");
+	}
+}
+
+static void test_bench_args(int argc, char *argv[])
+{
+	bs_args_struct_t args_struct[] = {
+		{
+			.dest = &peripherals,
+			.type = 'i',
+			.name = "{1..CONFIG_BT_MAX_CONN}",
+			.option = "peripherals",
+			.descript = "Number of peripherals the central connects to"
+		},
+		{
+			.dest = &duration_ms,
+			.type = 'i',
+			.name = "{ms}",
+			.option = "duration",
+			.descript = "Measurement duration once all peers are subscribed"
+		},
+		ARG_TABLE_ENDMARKER
+	};
+
+	bs_args_parse_all_cmd_line(argc, argv, args_struct);
+
+	peripherals = CLAMP(peripherals, 1, CONFIG_BT_MAX_CONN);
+}
+
+static void test_bench_init(void)
+{
+	bst_ticker_set_next_tick_absolute(300e6);
+	bst_result = In_progress;
+}
+
+static void test_bench_tick(bs_time_t HW_device_time)
+{
+	bst_result = Failed;
+	bs_trace_error_line("Test benchmark finished.\n");
+}
+
+static const struct bst_test_instance test_def[] = {
+	{
+		.test_id = "central",
+		.test_descr = "Central connecting to N benchmark peripherals",
+		.test_args_f = test_bench_args,
+		.test_post_init_f = test_bench_init,
+		.test_tick_f = test_bench_tick,
+		.test_main_f = test_central_main
+	},
+	{
+		.test_id = "peripheral",
+		.test_descr = "Peripheral streaming notifications",
+		.test_args_f = test_bench_args,
+		.test_post_init_f = test_bench_init,
+		.test_tick_f = test_bench_tick,
+		.test_main_f = test_peripheral_main
+	},
+	BSTEST_END_MARKER
+};
+
+struct bst_test_list *test_bench_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_def);
+}
+
+bst_test_install_t test_installers[] = {
+	test_bench_install,
+	NULL
+};
+
+int main(void)
+{
+	bst_main();
+	return 0;
+}
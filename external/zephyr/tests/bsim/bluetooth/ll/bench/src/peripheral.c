@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/printk.h>
+
+#include "common.h"
+
+static struct bt_uuid_128 bench_svc_uuid = BT_UUID_INIT_128(BENCH_SVC_UUID);
+static struct bt_uuid_128 bench_chrc_uuid = BT_UUID_INIT_128(BENCH_CHRC_UUID);
+
+static K_SEM_DEFINE(sem_connected, 0, 1);
+static K_SEM_DEFINE(sem_subscribed, 0, 1);
+static K_SEM_DEFINE(sem_inflight, BENCH_NOTIFY_INFLIGHT, BENCH_NOTIFY_INFLIGHT);
+
+static struct bt_conn *default_conn;
+static uint8_t notify_buf[BENCH_PAYLOAD_LEN];
+
+static ssize_t read_value(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			  void *buf, uint16_t len, uint16_t offset)
+{
+	/* Short read, the central only measures the round trip */
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, notify_buf,
+				 sizeof(struct bench_hdr));
+}
+
+static void ccc_changed(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	if (value == BT_GATT_CCC_NOTIFY) {
+		k_sem_give(&sem_subscribed);
+	}
+}
+
+BT_GATT_SERVICE_DEFINE(bench_svc,
+	BT_GATT_PRIMARY_SERVICE(&bench_svc_uuid),
+	BT_GATT_CHARACTERISTIC(&bench_chrc_uuid.uuid,
+			       BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_READ, read_value, NULL, NULL),
+	BT_GATT_CCC(ccc_changed, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),
+);
+
+uint16_t bench_value_handle(void)
+{
+	return bt_gatt_attr_get_handle(&bench_svc.attrs[2]);
+}
+
+static const struct bt_data ad[] = {
+	BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	BT_DATA(BT_DATA_NAME_COMPLETE, CONFIG_BT_DEVICE_NAME,
+		sizeof(CONFIG_BT_DEVICE_NAME) - 1),
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	struct bt_conn_info info;
+
+	if (err || default_conn || bt_conn_get_info(conn, &info) ||
+	    (info.role != BT_CONN_ROLE_PERIPHERAL)) {
+		return;
+	}
+
+	default_conn = bt_conn_ref(conn);
+	k_sem_give(&sem_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	if (conn != default_conn) {
+		return;
+	}
+
+	bt_conn_unref(default_conn);
+	default_conn = NULL;
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void notify_sent(struct bt_conn *conn, void *user_data)
+{
+	k_sem_give(&sem_inflight);
+}
+
+int peripheral_bench(void)
+{
+	struct bench_hdr *hdr = (void *)notify_buf;
+	struct bt_gatt_notify_params params = {
+		.attr = &bench_svc.attrs[1],
+		.data = notify_buf,
+		.len = sizeof(notify_buf),
+		.func = notify_sent,
+	};
+	uint32_t seq;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err) {
+		printk("Bluetooth init failed (err %d)\n", err);
+		return err;
+	}
+
+	/* One shot, a peripheral serves exactly one central connection */
+	err = bt_le_adv_start(BT_LE_ADV_PARAM(BT_LE_ADV_OPT_CONNECTABLE |
+					      BT_LE_ADV_OPT_ONE_TIME,
+					      BT_GAP_ADV_FAST_INT_MIN_2,
+					      BT_GAP_ADV_FAST_INT_MAX_2, NULL),
+			      ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err) {
+		printk("Advertising failed to start (err %d)\n", err);
+		return err;
+	}
+
+	k_sem_take(&sem_connected, K_FOREVER);
+	k_sem_take(&sem_subscribed, K_FOREVER);
+
+	memset(notify_buf, 0xa5, sizeof(notify_buf));
+
+	/* Stream until the central disconnects, the central alone times the
+	 * measurement window, common to all peripherals, once the last one
+	 * has subscribed.
+	 */
+	seq = 0U;
+	while (default_conn) {
+		if (k_sem_take(&sem_inflight, K_MSEC(BENCH_RTT_PERIOD_MS))) {
+			continue;
+		}
+
+		hdr->seq = sys_cpu_to_le32(seq);
+		hdr->timestamp_us = sys_cpu_to_le32(bench_timestamp_us());
+
+		err = bt_gatt_notify_cb(default_conn, &params);
+		if (err) {
+			k_sem_give(&sem_inflight);
+			k_sleep(K_MSEC(1));
+			continue;
+		}
+
+		seq++;
+	}
+
+	printk("%s: sent %u notifications\n", __func__, seq);
+
+	return 0;
+}
@@ -0,0 +1,7 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmark a central with 16 peripheral connections
+peripherals=16
+
+source $(dirname "${BASH_SOURCE[0]}")/_bench.source
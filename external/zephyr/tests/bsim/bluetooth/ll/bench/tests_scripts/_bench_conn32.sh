@@ -0,0 +1,7 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: Apache-2.0
+
+# Benchmark a central with 32 peripheral connections
+peripherals=32
+
+source $(dirname "${BASH_SOURCE[0]}")/_bench.source
@@ -0,0 +1,185 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define BLK_NUM 16
+#define BLK_SIZE 16
+#define BLK_ALIGN 8
+
+/* Blocks moved between a magazine and the slab free list at a time */
+#define BATCH (CONFIG_MEM_SLAB_MAGAZINE_SIZE / 2)
+
+static struct k_mem_slab mslab;
+static char __aligned(BLK_ALIGN) mslab_buf[BLK_SIZE * BLK_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(tstack, 2, STACK_SIZE);
+static struct k_thread tdata[2];
+
+static void *blocks[BLK_NUM];
+static void *waited;
+static int alloc_result;
+
+static void run_on_cpu(int idx, int cpu, k_thread_entry_t entry,
+		       bool wait)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&tdata[idx], tstack[idx], STACK_SIZE, entry,
+			      NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			      K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(tid, cpu), "pinning to CPU %d failed",
+		   cpu);
+	k_thread_start(tid);
+
+	if (wait) {
+		zassert_ok(k_thread_join(tid, K_FOREVER));
+	}
+}
+
+static void alloc_all(void *p1, void *p2, void *p3)
+{
+	void *block;
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&mslab, &blocks[i], K_NO_WAIT),
+			   "block %d not allocated", i);
+	}
+
+	zassert_equal(k_mem_slab_alloc(&mslab, &block, K_NO_WAIT), -ENOMEM);
+}
+
+static void free_all(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(&mslab, blocks[i]);
+		blocks[i] = NULL;
+	}
+}
+
+static void free_one(void *p1, void *p2, void *p3)
+{
+	k_mem_slab_free(&mslab, blocks[0]);
+	blocks[0] = NULL;
+}
+
+static void alloc_wait(void *p1, void *p2, void *p3)
+{
+	alloc_result = k_mem_slab_alloc(&mslab, &waited, K_MSEC(1000));
+}
+
+static void refill_flush(void *p1, void *p2, void *p3)
+{
+	/* A miss refills the magazine with a batch from the free list */
+	zassert_ok(k_mem_slab_alloc(&mslab, &blocks[0], K_NO_WAIT));
+	zassert_equal(z_mem_slab_num_cached(&mslab), BATCH - 1U);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 1U);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM - 1U);
+
+	for (int i = 1; i < BLK_NUM; i++) {
+		zassert_ok(k_mem_slab_alloc(&mslab, &blocks[i], K_NO_WAIT));
+	}
+	zassert_equal(z_mem_slab_num_cached(&mslab), 0U);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), 0U);
+
+	/* Releases fill the magazine, then flush batches to the free list */
+	for (int i = 0; i < CONFIG_MEM_SLAB_MAGAZINE_SIZE; i++) {
+		k_mem_slab_free(&mslab, blocks[i]);
+		blocks[i] = NULL;
+	}
+	zassert_equal(z_mem_slab_num_cached(&mslab),
+		      CONFIG_MEM_SLAB_MAGAZINE_SIZE);
+
+	k_mem_slab_free(&mslab, blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE]);
+	blocks[CONFIG_MEM_SLAB_MAGAZINE_SIZE] = NULL;
+	zassert_equal(z_mem_slab_num_cached(&mslab),
+		      CONFIG_MEM_SLAB_MAGAZINE_SIZE - BATCH + 1U);
+	zassert_equal(k_mem_slab_num_used_get(&mslab),
+		      BLK_NUM - CONFIG_MEM_SLAB_MAGAZINE_SIZE - 1U);
+
+	for (int i = CONFIG_MEM_SLAB_MAGAZINE_SIZE + 1; i < BLK_NUM; i++) {
+		k_mem_slab_free(&mslab, blocks[i]);
+		blocks[i] = NULL;
+	}
+	zassert_true(z_mem_slab_num_cached(&mslab) <=
+		     CONFIG_MEM_SLAB_MAGAZINE_SIZE);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0U);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM);
+}
+
+/**
+ * @brief Verify magazine refill from and flush to the slab free list
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_magazine, test_mslab_magazine_refill_flush)
+{
+	run_on_cpu(0, 0, refill_flush, true);
+}
+
+/**
+ * @brief Verify blocks freed on one CPU can be allocated on another
+ *
+ * @details All blocks are allocated on CPU 0 and freed on CPU 1, where
+ * some of them stay cached in the magazine of CPU 1. Allocating all
+ * blocks again on CPU 0 has to take those from the magazine of CPU 1.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_magazine, test_mslab_magazine_cross_cpu)
+{
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	run_on_cpu(0, 0, alloc_all, true);
+	run_on_cpu(1, 1, free_all, true);
+	zassert_true(z_mem_slab_num_cached(&mslab) > 0U);
+
+	run_on_cpu(0, 0, alloc_all, true);
+	zassert_equal(z_mem_slab_num_cached(&mslab), 0U);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM);
+
+	run_on_cpu(1, 1, free_all, true);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM);
+}
+
+/**
+ * @brief Verify a block freed on one CPU wakes a waiter on another
+ *
+ * @details The released block goes to the magazine of the freeing CPU,
+ * which has to hand it back to the free list for the pending thread.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+ZTEST(mslab_magazine, test_mslab_magazine_cross_cpu_wait)
+{
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	run_on_cpu(0, 0, alloc_all, true);
+
+	alloc_result = -EAGAIN;
+	run_on_cpu(0, 0, alloc_wait, false);
+	k_msleep(100);
+
+	run_on_cpu(1, 1, free_one, true);
+	zassert_ok(k_thread_join(&tdata[0], K_FOREVER));
+	zassert_ok(alloc_result, "waiter not woken by free on other CPU");
+	blocks[0] = waited;
+
+	run_on_cpu(1, 1, free_all, true);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM);
+}
+
+static void mslab_magazine_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Start every test with empty magazines */
+	zassert_ok(k_mem_slab_init(&mslab, mslab_buf, BLK_SIZE, BLK_NUM));
+}
+
+ZTEST_SUITE(mslab_magazine, NULL, NULL, mslab_magazine_before, NULL, NULL);
@@ -120,6 +120,14 @@ static inline int preempt_counter(void)
 static K_THREAD_STACK_DEFINE(invalid_test_stack, STACK_SIZE);
 static struct k_work_q invalid_test_queue;
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* A preemptible work queue animated by two threads. */
+static K_THREAD_STACK_DEFINE(workers_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(workers_extra_stack, STACK_SIZE);
+static struct k_work_q workers_queue;
+static struct k_work_q_worker workers_extra;
+#endif
+
 static atomic_t system_ctr;
 static inline int system_counter(void)
 {
@@ -267,6 +275,17 @@ static void test_queue_start(void)
 			    COOPLO_PRIORITY, &cfg);
 	zassert_equal(cooplo_queue.flags,
 		      K_WORK_QUEUE_STARTED | K_WORK_QUEUE_NO_YIELD, NULL);
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	cfg.name = "wq.workers";
+	cfg.no_yield = false;
+	k_work_queue_start(&workers_queue, workers_stack, STACK_SIZE,
+			    PREEMPT_PRIORITY, &cfg);
+	k_work_queue_worker_add(&workers_queue, &workers_extra,
+				workers_extra_stack, STACK_SIZE,
+				PREEMPT_PRIORITY, -1);
+	zassert_equal(workers_queue.flags, K_WORK_QUEUE_STARTED);
+#endif
 }
 
 /* Check validation of submission without a destination queue. */
@@ -1442,6 +1461,71 @@ ZTEST(work_1cpu, test_1cpu_system_reschedule)
 		     "long %u > %u\n", elapsed_ms, max_ms);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* Single CPU check that independent items run on separate workers. */
+ZTEST(work_1cpu, test_1cpu_workers_concurrent)
+{
+	int rc;
+
+	/* Reset state and use the blocking handler */
+	reset_counters();
+	k_work_init(&common_work, rel_handler);
+	k_work_init(&common_work1, rel_handler);
+
+	rc = k_work_submit_to_queue(&workers_queue, &common_work);
+	zassert_equal(rc, 1);
+	rc = k_work_submit_to_queue(&workers_queue, &common_work1);
+	zassert_equal(rc, 1);
+
+	/* Let the workers run: each takes one item and blocks. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING);
+	zassert_equal(k_work_busy_get(&common_work1), K_WORK_RUNNING);
+
+	/* Release them one at a time. */
+	handler_release();
+	zassert_equal(k_sem_take(&sync_sem, K_FOREVER), 0);
+	handler_release();
+	zassert_equal(k_sem_take(&sync_sem, K_FOREVER), 0);
+
+	zassert_equal(k_work_busy_get(&common_work), 0);
+	zassert_equal(k_work_busy_get(&common_work1), 0);
+}
+
+/* Single CPU check that an item resubmitted while running is not picked
+ * up by an idle worker, and that flushing waits for both instances.
+ */
+ZTEST(work_1cpu, test_1cpu_workers_reentrant_flush)
+{
+	int rc;
+
+	/* Reset state and use the delaying handler */
+	reset_counters();
+	k_work_init(&common_work, delay_handler);
+
+	rc = k_work_submit_to_queue(&workers_queue, &common_work);
+	zassert_equal(rc, 1);
+
+	/* Release it so it's running. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work), K_WORK_RUNNING);
+
+	/* Resubmit: it must stay queued while the other worker idles. */
+	rc = k_work_submit_to_queue(&workers_queue, &common_work);
+	zassert_equal(rc, 2);
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&common_work),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Wait for both instances to complete. */
+	zassert_true(k_work_flush(&common_work, &work_sync));
+	zassert_equal(k_work_busy_get(&common_work), 0);
+
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 ZTEST(work, test_nop)
 {
 	ztest_test_skip();
@@ -45,9 +45,19 @@
  * will increase 16 bytes on 64 bit CPU.
  */
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-#define SOLO_FREE_HEADER_HEAP_SZ (80)
+#define SOLO_FREE_HEADER_STATS_SZ (80)
 #else
-#define SOLO_FREE_HEADER_HEAP_SZ (64)
+#define SOLO_FREE_HEADER_STATS_SZ (64)
+#endif
+
+/* The size class cache adds two counters and one 8 byte entry per class
+ * to struct z_heap.
+ */
+#ifdef CONFIG_SYS_HEAP_CACHE
+#define SOLO_FREE_HEADER_HEAP_SZ \
+	(SOLO_FREE_HEADER_STATS_SZ + 8 + 8 * CONFIG_SYS_HEAP_CACHE_CLASSES)
+#else
+#define SOLO_FREE_HEADER_HEAP_SZ SOLO_FREE_HEADER_STATS_SZ
 #endif
 
 #define SCRATCH_SZ (sizeof(heapmem) / 2)
@@ -387,6 +397,66 @@ ZTEST(lib_heap, test_realloc)
 		     "Realloc should have moved %p", p2);
 }
 
+/* Check that freed small chunks are reused from the size class cache
+ * and that the cache gives memory back when an allocation needs it.
+ */
+ZTEST(lib_heap, test_cache)
+{
+#ifdef CONFIG_SYS_HEAP_CACHE
+	struct sys_heap heap;
+	struct sys_memory_stats stats;
+	static void *blocks[SMALL_HEAP_SZ / 16];
+	size_t n, cache_hits;
+	void *p1, *p2;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* A freed block is handed out again for the same size */
+	p1 = sys_heap_alloc(&heap, 24);
+	zassert_not_null(p1);
+	sys_heap_free(&heap, p1);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	cache_hits = stats.cache_hits;
+
+	p2 = sys_heap_alloc(&heap, 24);
+	zassert_equal(p1, p2, "cached block not reused %p -> %p", p1, p2);
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.cache_hits, cache_hits + 1);
+	sys_heap_free(&heap, p2);
+
+	/* Exhaust the heap with small blocks, then free them all: the
+	 * first ones freed stay cached and fragment the low end of the
+	 * heap.  A block spanning almost all of the free memory can only
+	 * be allocated once the cache has been coalesced.
+	 */
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = sys_heap_alloc(&heap, 24);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > CONFIG_SYS_HEAP_CACHE_DEPTH);
+
+	for (size_t i = 0; i < n; i++) {
+		sys_heap_free(&heap, blocks[i]);
+	}
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.allocated_bytes, 0);
+
+	p1 = sys_heap_alloc(&heap, stats.free_bytes - 64);
+	zassert_not_null(p1, "cache was not coalesced");
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+	sys_heap_free(&heap, p1);
+	zassert_true(sys_heap_validate(&heap), "invalid heap");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_CACHE */
+}
+
 #ifdef CONFIG_SYS_HEAP_LISTENER
 static struct sys_heap listener_heap;
 static uintptr_t listener_heap_id;
@@ -71,6 +71,7 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, FIXED_BUFFER_SIZE, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_POOL_FIXED_DEFINE(batch_pool, 4, 16, 0, NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -848,5 +849,103 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 	net_buf_unref(buf);
 }
 
+ZTEST(net_buf_tests, test_net_buf_alloc_batch)
+{
+	struct net_buf *head, *buf, *other;
+	int count = 0;
+
+	/* More buffers than the pool holds must fail without taking any */
+	head = net_buf_alloc_batch(&batch_pool, 16, 5, K_NO_WAIT);
+	zassert_is_null(head, "Batch larger than pool allocated");
+
+	head = net_buf_alloc_batch(&batch_pool, 16, 3, K_NO_WAIT);
+	zassert_not_null(head, "Failed to allocate batch");
+
+	for (buf = head; buf; buf = buf->frags) {
+		zassert_equal(buf->ref, 1, "Invalid ref count");
+		zassert_equal(buf->len, 0, "Invalid buffer length");
+		zassert_equal(buf->size, 16, "Invalid buffer size");
+		count++;
+	}
+	zassert_equal(count, 3, "Invalid number of buffers in batch");
+
+	/* Only one buffer left: a batch of two must leave it in the pool */
+	zassert_is_null(net_buf_alloc_batch(&batch_pool, 16, 2, K_NO_WAIT),
+			"Batch allocated from exhausted pool");
+
+	other = net_buf_alloc_len(&batch_pool, 16, K_NO_WAIT);
+	zassert_not_null(other, "Failed batch did not release buffers");
+	net_buf_unref(other);
+
+	net_buf_unref_chain(head);
+
+	/* All buffers are back, including the ones freed as a batch */
+	head = net_buf_alloc_batch(&batch_pool, 16, 4, K_NO_WAIT);
+	zassert_not_null(head, "Buffers not returned by net_buf_unref_chain");
+	net_buf_unref_chain(head);
+}
+
+ZTEST(net_buf_tests, test_net_buf_unref_chain_ref)
+{
+	struct net_buf *head, *second;
+
+	destroy_called = 0;
+
+	head = net_buf_alloc_batch(&fixed_pool, FIXED_BUFFER_SIZE, 3, K_NO_WAIT);
+	zassert_not_null(head, "Failed to allocate batch");
+
+	/* A fragment still referenced elsewhere stops the release */
+	second = net_buf_ref(head->frags);
+
+	net_buf_unref_chain(head);
+	zassert_equal(destroy_called, 1, "Incorrect destroy callback count");
+	zassert_equal(second->ref, 1, "Invalid ref count");
+
+	net_buf_unref_chain(second);
+	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
+}
+
+ZTEST(net_buf_tests, test_net_buf_alloc_iovec)
+{
+	static const uint8_t hdr[] = { 0xaa, 0xbb, 0xcc };
+	const struct net_buf_iovec iov[] = {
+		{ .data = hdr, .len = sizeof(hdr) },
+		{ .data = example_data, .len = 20 },
+	};
+	uint8_t out[sizeof(hdr) + 20];
+	struct net_buf *head, *buf;
+	size_t off = 0;
+	int count = 0;
+
+	/* 23 bytes at 12 bytes per buffer after headroom: two fragments */
+	head = net_buf_alloc_iovec(&batch_pool, 4, iov, ARRAY_SIZE(iov),
+				   K_NO_WAIT);
+	zassert_not_null(head, "Failed to allocate chain");
+
+	for (buf = head; buf; buf = buf->frags) {
+		zassert_equal(net_buf_headroom(buf), 4, "Invalid headroom");
+		zassert_true(off + buf->len <= sizeof(out), "Chain too long");
+		memcpy(&out[off], buf->data, buf->len);
+		off += buf->len;
+		count++;
+	}
+
+	zassert_equal(count, 2, "Invalid number of fragments");
+	zassert_equal(head->len, 12, "First fragment not filled");
+	zassert_equal(off, sizeof(out), "Invalid chain length");
+	zassert_mem_equal(out, hdr, sizeof(hdr), "Invalid data");
+	zassert_mem_equal(&out[sizeof(hdr)], example_data, 20, "Invalid data");
+
+	net_buf_unref_chain(head);
+
+	head = net_buf_alloc_iovec(&var_pool, 8, iov, ARRAY_SIZE(iov),
+				   K_NO_WAIT);
+	zassert_not_null(head, "Failed to allocate chain");
+	zassert_is_null(head->frags, "Unexpected fragment from variable pool");
+	zassert_equal(head->len, sizeof(out), "Invalid buffer length");
+	zassert_equal(net_buf_headroom(head), 8, "Invalid headroom");
+
+	net_buf_unref_chain(head);
+}
 
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
@@ -933,3 +933,237 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 
 #endif
 }
+
+#ifdef CONFIG_NVS_ID_INDEX
+static uint32_t index_addr(uint16_t id, struct nvs_fs *fs)
+{
+	for (size_t i = 0; i < CONFIG_NVS_ID_INDEX_SIZE; i++) {
+		if ((fs->id_index_addr[i] != NVS_ID_INDEX_NO_ADDR) && (fs->id_index_id[i] == id)) {
+			return fs->id_index_addr[i];
+		}
+	}
+
+	return NVS_ID_INDEX_NO_ADDR;
+}
+
+static size_t num_index_entries_in_sector(uint32_t sector, struct nvs_fs *fs)
+{
+	size_t num = 0;
+
+	for (size_t i = 0; i < CONFIG_NVS_ID_INDEX_SIZE; i++) {
+		if ((fs->id_index_addr[i] != NVS_ID_INDEX_NO_ADDR) &&
+		    ((fs->id_index_addr[i] >> ADDR_SECT_SHIFT) == sector)) {
+			num++;
+		}
+	}
+
+	return num;
+}
+#endif
+
+/*
+ * Test that the NVS ID index holds the most recent ATE of every ID after
+ * writes, deletes, nvs_mount() and gc.
+ */
+ZTEST_F(nvs, test_nvs_id_index)
+{
+#ifdef CONFIG_NVS_ID_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data = 0;
+	uint32_t ate_addr[5];
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.id_index_cnt, 0, "uninitialized index");
+
+	for (id = 1; id < ARRAY_SIZE(ate_addr); id++) {
+		ate_addr[id] = fixture->fs.ate_wra;
+		err = nvs_write(&fixture->fs, id, &id, sizeof(id));
+		zassert_equal(err, sizeof(id), "nvs_write call failure: %d", err);
+	}
+
+	/* Deletes are indexed as the most recent ATE of their ID */
+	ate_addr[2] = fixture->fs.ate_wra;
+	err = nvs_delete(&fixture->fs, 2);
+	zassert_true(err == 0, "nvs_delete call failure: %d", err);
+
+	err = nvs_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read unexpected result: %d", err);
+
+	zassert_equal(fixture->fs.id_index_cnt, 4, "index not updated after write");
+	for (id = 1; id < ARRAY_SIZE(ate_addr); id++) {
+		zassert_equal(index_addr(id, &fixture->fs), ate_addr[id],
+			      "invalid index entry after write");
+	}
+
+	/* Test index initialization when the store is non-empty */
+
+	memset(fixture->fs.id_index_addr, 0xAA, sizeof(fixture->fs.id_index_addr));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.id_index_cnt, 4, "uninitialized index after restart");
+	for (id = 1; id < ARRAY_SIZE(ate_addr); id++) {
+		zassert_equal(index_addr(id, &fixture->fs), ate_addr[id],
+			      "invalid index entry after restart");
+	}
+
+	/* Fill the first sector with writes of ID 1, then the second one with
+	 * writes of ID 5 until sector 0 is gc-ed.
+	 */
+
+	data = ARRAY_SIZE(ate_addr);
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 0) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 5, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* The entries of IDs 3 and 4 were moved, the delete of ID 2 dropped */
+
+	zassert_equal(num_index_entries_in_sector(0, &fixture->fs), 0,
+		      "not invalidated index entries after gc");
+	zassert_equal(num_index_entries_in_sector(2, &fixture->fs), 3,
+		      "invalid index content after gc");
+	zassert_equal(fixture->fs.id_index_cnt, 4, "invalid index content after gc");
+	zassert_equal(index_addr(2, &fixture->fs), NVS_ID_INDEX_NO_ADDR,
+		      "deleted ID still indexed after gc");
+
+	for (id = 3; id < 5; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
+
+/*
+ * Test that the IDs that do not fit in the NVS ID index can still be read.
+ */
+ZTEST_F(nvs, test_nvs_id_index_overflow)
+{
+#ifdef CONFIG_NVS_ID_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < CONFIG_NVS_ID_INDEX_SIZE; id++) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	zassert_true(fixture->fs.id_index_overflow, "index overflow not detected");
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_true(fixture->fs.id_index_overflow, "index overflow not detected");
+
+	for (id = 0; id < CONFIG_NVS_ID_INDEX_SIZE; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	err = nvs_read(&fixture->fs, CONFIG_NVS_ID_INDEX_SIZE, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read unexpected result: %d", err);
+#endif
+}
+
+/*
+ * Test that nvs_gc_step() moves the entries of the sector to gc next, so
+ * that the sector switch does not have to.
+ */
+ZTEST_F(nvs, test_nvs_gc_step)
+{
+#ifdef CONFIG_NVS_GC_STEP
+	int err;
+	uint16_t id;
+	uint16_t data = 0;
+	uint32_t *flash_write_stat;
+	uint32_t write_calls;
+	const uint16_t max_id = 10;
+
+	fixture->fs.sector_count = 2;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	err = nvs_gc_step(&fixture->fs, K_FOREVER);
+	zassert_equal(err, -ENOTSUP, "nvs_gc_step unexpected result: %d", err);
+
+	err = nvs_clear(&fixture->fs);
+	zassert_true(err == 0, "nvs_clear call failure: %d", err);
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 1; id < max_id; id++) {
+		err = nvs_write(&fixture->fs, id, &id, sizeof(id));
+		zassert_equal(err, sizeof(id), "nvs_write call failure: %d", err);
+	}
+
+	/* The sector to gc next holds no data yet */
+	err = nvs_gc_step(&fixture->fs, K_FOREVER);
+	zassert_equal(err, 0, "nvs_gc_step call failure: %d", err);
+
+	/* Fill sector 0 with writes of ID max_id, sector 0 is then the next
+	 * one to gc.
+	 */
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 0) {
+		++data;
+		err = nvs_write(&fixture->fs, max_id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Each call moves at least one entry */
+	err = nvs_gc_step(&fixture->fs, K_NO_WAIT);
+	zassert_equal(err, -EAGAIN, "nvs_gc_step unexpected result: %d", err);
+
+	err = nvs_gc_step(&fixture->fs, K_FOREVER);
+	zassert_equal(err, 0, "nvs_gc_step call failure: %d", err);
+
+	for (id = 1; id < max_id; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	/* Fill sector 1, the write switching to sector 2 must not move any
+	 * entry: it writes the close ATE, the gc done ATE and its own entry.
+	 */
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+
+	do {
+		write_calls = *flash_write_stat;
+		++data;
+		err = nvs_write(&fixture->fs, max_id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	} while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) == 1);
+
+	write_calls = *flash_write_stat - write_calls;
+	zassert_true(write_calls < 2 * (max_id - 1), "entries moved by gc: %u writes",
+		     write_calls);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	for (id = 1; id < max_id; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+#endif
+}
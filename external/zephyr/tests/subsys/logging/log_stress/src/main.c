@@ -12,6 +12,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_internal.h>
 
 #define MODULE_NAME test
 
@@ -30,6 +31,20 @@ struct mock_log_backend {
 
 static struct mock_log_backend mock_backend;
 static uint32_t log_process_delay = 10;
+static uint32_t staging_dropped_start;
+
+static uint32_t staging_dropped(void)
+{
+	uint32_t dropped = 0;
+
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		for (uint32_t i = 0; i < z_log_stage_ring_count(); i++) {
+			dropped += z_log_stage_dropped_get(i);
+		}
+	}
+
+	return dropped;
+}
 
 static void handle_msg(uint32_t arg0)
 {
@@ -103,6 +118,13 @@ static void validate(int ctx_cnt)
 			"dropped:%u missing:%u",
 			mock_backend.dropped, mock_backend.missing);
 	zassert_equal(in_cnt, out_cnt);
+
+	if (IS_ENABLED(CONFIG_LOG_STAGING)) {
+		uint32_t dropped = staging_dropped() - staging_dropped_start;
+
+		zassert_equal(mock_backend.dropped, dropped, "dropped:%u staging:%u",
+			      mock_backend.dropped, dropped);
+	}
 }
 
 static bool context_handler(void *user_data, uint32_t cnt, bool last, int prio)
@@ -163,6 +185,7 @@ static void test_stress(uint32_t delay)
 	uint32_t ctx_cnt = 3;
 
 	memset(&mock_backend, 0, sizeof(mock_backend));
+	staging_dropped_start = staging_dropped();
 	log_process_delay = delay;
 	ztress_set_timeout(K_MSEC(get_test_timeout()));
 	ZTRESS_EXECUTE(
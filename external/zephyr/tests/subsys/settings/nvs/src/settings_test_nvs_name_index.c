@@ -0,0 +1,124 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/storage/flash_map.h>
+
+#include "settings_priv.h"
+#include "settings/settings_nvs.h"
+#include "settings_test.h"
+
+#define TEST_PARTITION_ID FIXED_PARTITION_ID(storage_partition)
+
+static struct settings_nvs cf;
+
+static int count_cb(const char *key, size_t len, settings_read_cb read_cb,
+		    void *cb_arg, void *param)
+{
+	(*(int *)param)++;
+
+	return 0;
+}
+
+static int load_count(const char *subtree)
+{
+	int cnt = 0;
+	struct settings_load_arg arg = {
+		.subtree = subtree,
+		.cb = count_cb,
+		.param = &cnt,
+	};
+
+	zassert_ok(cf.cf_store.cs_itf->csi_load(&cf.cf_store, &arg));
+
+	return cnt;
+}
+
+static void save(const char *name, const char *value)
+{
+	size_t len = value ? strlen(value) : 0;
+
+	zassert_ok(cf.cf_store.cs_itf->csi_save(&cf.cf_store, name, value, len));
+}
+
+static bool index_found(void)
+{
+	uint8_t buf;
+
+	return nvs_read(&cf.cf_nvs, NVS_NAME_INDEX_ID, &buf, sizeof(buf)) > 0;
+}
+
+ZTEST(settings_config, test_config_nvs_name_index)
+{
+	const struct flash_area *fa;
+	struct flash_sector sector;
+	uint32_t sector_cnt = 1;
+	uint16_t last_name_id;
+	int rc;
+
+	zassert_ok(flash_area_open(TEST_PARTITION_ID, &fa));
+	rc = flash_area_get_sectors(TEST_PARTITION_ID, &sector_cnt, &sector);
+	zassert_true(rc == 0 || rc == -ENOMEM, "Can't get sectors (err %d)", rc);
+	zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+
+	cf.flash_dev = fa->fa_dev;
+	cf.cf_nvs.offset = fa->fa_off;
+	cf.cf_nvs.sector_size = sector.fs_size;
+	cf.cf_nvs.sector_count = MIN(fa->fa_size / sector.fs_size, 8);
+	flash_area_close(fa);
+
+	/* Empty storage has a valid index */
+	zassert_ok(settings_nvs_backend_init(&cf));
+	zassert_ok(settings_nvs_dst(&cf));
+	zassert_true(cf.index_valid);
+
+	save("bt/a", "1");
+	save("bt/b", "2");
+	save("bt/c/d", "3");
+	save("btx/a", "4");
+	save("other/a", "5");
+
+	zassert_equal(load_count(NULL), 5);
+	zassert_true(index_found(), "Index not stored by load");
+
+	/* The index is found at the next init */
+	zassert_ok(settings_nvs_backend_init(&cf));
+	zassert_true(cf.index_valid);
+	zassert_true(cf.index_stored);
+
+	zassert_equal(load_count("bt"), 3);
+	zassert_equal(load_count("bt/c"), 1);
+	zassert_equal(load_count("btx"), 1);
+	zassert_equal(load_count("other"), 1);
+
+	/* Updating a value keeps the stored index */
+	last_name_id = cf.last_name_id;
+	save("bt/a", "6");
+	zassert_equal(cf.last_name_id, last_name_id);
+	zassert_true(index_found());
+
+	/* Deleting a name deletes the stored index */
+	save("bt/b", NULL);
+	zassert_false(index_found());
+	zassert_equal(load_count("bt"), 2);
+	zassert_true(index_found());
+
+	/* The ID of the deleted name is reused */
+	save("bt/e", "7");
+	zassert_equal(cf.last_name_id, last_name_id);
+	zassert_false(index_found());
+
+	/* Without a stored index the load reads all names and stores it */
+	zassert_ok(settings_nvs_backend_init(&cf));
+	zassert_false(cf.index_valid);
+	zassert_equal(load_count("other"), 1);
+	zassert_true(cf.index_valid);
+	zassert_true(index_found());
+
+	zassert_ok(settings_nvs_backend_init(&cf));
+	zassert_true(cf.index_valid);
+	zassert_equal(load_count("bt"), 3);
+	zassert_equal(load_count(NULL), 5);
+
+	config_wipe_srcs();
+}
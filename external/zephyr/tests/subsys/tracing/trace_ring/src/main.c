@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/tracing/trace_ring.h>
+
+#define EVT_SIZE 18
+#define PACKET_SIZE (4 * sizeof(uint32_t))
+
+static uint8_t out[PACKET_SIZE + CONFIG_TRACE_RING_EVENTS * EVT_SIZE + 1];
+static char metadata[4096];
+static size_t out_len;
+
+static int dump_cb(const void *data, size_t len, void *user_data)
+{
+	uint8_t *buf = user_data;
+	size_t size = (buf == out) ? sizeof(out) : sizeof(metadata) - 1;
+
+	zassert_true(out_len + len <= size, "Dump too long");
+	memcpy(&buf[out_len], data, len);
+	out_len += len;
+
+	return 0;
+}
+
+static void dump(void)
+{
+	out_len = 0;
+	zassert_ok(trace_ring_dump(0, dump_cb, out));
+}
+
+static const uint8_t *dump_event(size_t i)
+{
+	return &out[PACKET_SIZE + i * EVT_SIZE];
+}
+
+ZTEST(trace_ring, test_record_and_dump)
+{
+	uint32_t count, discarded;
+	uint32_t prev_ts = 0;
+
+	for (uint32_t i = 0; i < 5; i++) {
+		trace_ring_record(TRACE_RING_EVT_USER0 + i, i, 2 * i, 3 * i);
+	}
+
+	zassert_ok(trace_ring_stats_get(0, &count, &discarded));
+	zassert_equal(count, 5);
+	zassert_equal(discarded, 0);
+
+	dump();
+	zassert_equal(out_len, PACKET_SIZE + 5 * EVT_SIZE);
+	zassert_equal(sys_get_le32(&out[0]), 0xC1FC1FC1, "Invalid CTF magic");
+	zassert_equal(sys_get_le32(&out[8]), 0, "Invalid CPU");
+	zassert_equal(sys_get_le32(&out[12]), 0, "Invalid discarded count");
+
+	for (uint32_t i = 0; i < 5; i++) {
+		const uint8_t *evt = dump_event(i);
+		uint32_t ts = sys_get_le32(evt);
+
+		zassert_true(i == 0 || (int32_t)(ts - prev_ts) >= 0, "Timestamps not ordered");
+		zassert_equal(sys_get_le16(&evt[4]), TRACE_RING_EVT_USER0 + i);
+		zassert_equal(sys_get_le32(&evt[6]), i);
+		zassert_equal(sys_get_le32(&evt[10]), 2 * i);
+		zassert_equal(sys_get_le32(&evt[14]), 3 * i);
+		prev_ts = ts;
+	}
+}
+
+ZTEST(trace_ring, test_overwrite)
+{
+	const uint32_t total = CONFIG_TRACE_RING_EVENTS + 4;
+	uint32_t count, discarded;
+
+	for (uint32_t i = 0; i < total; i++) {
+		trace_ring_record(TRACE_RING_EVT_USER1, i, 0, 0);
+	}
+
+	zassert_ok(trace_ring_stats_get(0, &count, &discarded));
+	zassert_equal(count, CONFIG_TRACE_RING_EVENTS);
+	zassert_equal(discarded, 4);
+
+	/* Oldest events were overwritten, newest come last */
+	dump();
+	zassert_equal(sys_get_le32(&out[12]), 4, "Invalid discarded count");
+	zassert_equal(sys_get_le32(&dump_event(0)[6]), 4);
+	zassert_equal(sys_get_le32(&dump_event(CONFIG_TRACE_RING_EVENTS - 1)[6]), total - 1);
+}
+
+ZTEST(trace_ring, test_disable)
+{
+	uint32_t count, discarded;
+
+	trace_ring_enable(false);
+	trace_ring_record(TRACE_RING_EVT_USER2, 0, 0, 0);
+	trace_ring_enable(true);
+
+	zassert_ok(trace_ring_stats_get(0, &count, &discarded));
+	zassert_equal(count, 0);
+
+	zassert_equal(trace_ring_stats_get(CONFIG_MP_MAX_NUM_CPUS, &count, &discarded),
+		      -EINVAL);
+}
+
+ZTEST(trace_ring, test_metadata)
+{
+	out_len = 0;
+	zassert_ok(trace_ring_dump_metadata(dump_cb, metadata));
+	metadata[out_len] = '\0';
+
+	zassert_not_null(strstr(metadata, "/* CTF 1.8 */"));
+	zassert_not_null(strstr(metadata, "map = clock.cycles.value;"));
+	zassert_not_null(strstr(metadata, "name = \"bt_att_rx\";"));
+	zassert_not_null(strstr(metadata, "name = \"user7\";"));
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	trace_ring_clear();
+}
+
+ZTEST_SUITE(trace_ring, NULL, NULL, before, NULL, NULL);
@@ -486,6 +486,9 @@ ZTEST(prf, test_d_length)
 		PRF_CHECK("/34621422135410688/-34621422135410688/-2/4000000000/", rc);
 	} else if (IS_ENABLED(CONFIG_CBPRINTF_COMPLETE)) {
 		PRF_CHECK("/%lld/%lld/%lld/%llu/", rc);
+	} else if (IS_ENABLED(CONFIG_CBPRINTF_NANO)
+		   && IS_ENABLED(CONFIG_CBPRINTF_FAST_DECIMAL)) {
+		PRF_CHECK("/34621422135410688/-34621422135410688/-2/4000000000/", rc);
 	} else if (IS_ENABLED(CONFIG_CBPRINTF_NANO)) {
 		PRF_CHECK("/ERR/ERR/-2/4000000000/", rc);
 	} else {
@@ -532,6 +535,40 @@ ZTEST(prf, test_d_length)
 	zassert_equal(strncmp("/%Ld/", buf, rc), 0);
 }
 
+ZTEST(prf, test_d_fast_decimal)
+{
+	int rc;
+
+	if (!IS_ENABLED(CONFIG_CBPRINTF_FAST_DECIMAL)) {
+		TC_PRINT("skipping unsupported feature\n");
+		return;
+	}
+
+	/* Digit pair and 8-digit chunk boundaries */
+	TEST_PRF(&rc, "%u/%u/%u/%u/%u/%d", 0U, 9U, 10U, 99U, 100U, INT_MIN);
+	PRF_CHECK("0/9/10/99/100/-2147483648", rc);
+
+	TEST_PRF(&rc, "%s=%u%s", "max", UINT32_MAX, "!");
+	PRF_CHECK("max=4294967295!", rc);
+
+	if (!IS_ENABLED(CONFIG_CBPRINTF_FULL_INTEGRAL)
+	    && !IS_ENABLED(CONFIG_CBPRINTF_NANO)) {
+		TC_PRINT("no 64-bit conversions\n");
+		return;
+	}
+
+	TEST_PRF(&rc, "%llu/%llu/%llu", 4294967296ULL, 100000000000000000ULL,
+		 10000000099999999ULL);
+	PRF_CHECK("4294967296/100000000000000000/10000000099999999", rc);
+
+	TEST_PRF(&rc, "%llu/%lld/%lld", ULLONG_MAX, LLONG_MIN, LLONG_MAX);
+	PRF_CHECK("18446744073709551615/-9223372036854775808/9223372036854775807", rc);
+
+	/* Conversions with flags go through the generic path */
+	TEST_PRF(&rc, "/%22llu/%-3lld/", ULLONG_MAX, -1LL);
+	PRF_CHECK("/  18446744073709551615/-1 /", rc);
+}
+
 ZTEST(prf, test_d_flags)
 {
 	int sv = 123;